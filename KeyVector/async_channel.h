@@ -0,0 +1,839 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <ranges>
+#include <cassert>
+#include <utility>
+#include <optional>
+#include <iterator>
+#include <exception>
+#include <coroutine>
+#include <type_traits>
+#include "vector.h"
+#include "circular_vector.h"
+#include "parallel.h"
+
+
+//============================================================
+//	C++20 coroutine plumbing for streaming elements into Vector batches
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 08:00
+//
+//	\brief	Executor: where suspended coroutines are resumed
+//				RunLoop resumes them one after the other on the thread calling run()
+//				PoolExecutor hands every resumption to a parallel::ThreadPool
+//			Task<T>: lazily started coroutine; co_await it, or spawn() it detached
+//			Channel<T>: bounded queue of Vector<T> batches between producer & consumer
+//				coroutines, see below
+//			Generator<T> & batches( range, n ): a synchronous generator, and one that
+//				yields a range n elements at a time as Vector batches
+//=============================================================
+namespace coro
+{
+
+class Executor
+{
+public:
+	virtual ~Executor() noexcept = default;
+
+	// resumes h later, on one of the executor's threads
+	virtual void post( std::coroutine_handle<> h ) = 0;
+};
+
+class RunLoop final
+	: public Executor
+{
+	std::mutex m_mutex;
+	CircularVector<std::coroutine_handle<>> m_ready;
+public:
+	// thread safe; the coroutine runs on the next run()
+	void post( std::coroutine_handle<> h ) override
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_ready.pushBack( h );
+	}
+
+	// resumes posted coroutines on the calling thread until none are left; returns how many ran
+	std::size_t run()
+	{
+		std::size_t resumed = 0;
+		while ( true )
+		{
+			std::coroutine_handle<> h;
+			{
+				std::lock_guard<std::mutex> lock{m_mutex};
+				if ( m_ready.isEmpty() )
+				{
+					return resumed;
+				}
+				h = m_ready.front();
+				m_ready.popFront();
+			}
+			h.resume();
+			++resumed;
+		}
+	}
+};
+
+// the pool has to have a worker, or somebody has to run its queued tasks
+class PoolExecutor final
+	: public Executor
+{
+	parallel::ThreadPool& m_pool;
+public:
+	explicit PoolExecutor( parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+		:
+		m_pool{pool}
+	{
+
+	}
+
+	void post( std::coroutine_handle<> h ) override
+	{
+		m_pool.submit( [h]()
+			{
+				h.resume();
+			}
+		);
+	}
+};
+
+// co_await resumeOn( executor ) continues the coroutine on that executor
+inline auto resumeOn( Executor& executor ) noexcept
+{
+	struct Awaiter
+	{
+		Executor& executor;
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+		void await_suspend( std::coroutine_handle<> h )
+		{
+			executor.post( h );
+		}
+		void await_resume() const noexcept
+		{
+
+		}
+	};
+	return Awaiter{executor};
+}
+
+
+namespace detail
+{
+
+// resumes whoever awaited the finished task, by symmetric transfer
+struct FinalAwaiter
+{
+	bool await_ready() const noexcept
+	{
+		return false;
+	}
+	template<typename Promise>
+	std::coroutine_handle<> await_suspend( std::coroutine_handle<Promise> h ) noexcept
+	{
+		return h.promise().continuation ?
+			h.promise().continuation :
+			std::noop_coroutine();
+	}
+	void await_resume() const noexcept
+	{
+
+	}
+};
+
+struct PromiseBase
+{
+	std::coroutine_handle<> continuation;
+	std::exception_ptr error;
+
+	std::suspend_always initial_suspend() const noexcept
+	{
+		return {};
+	}
+	FinalAwaiter final_suspend() const noexcept
+	{
+		return {};
+	}
+	void unhandled_exception() noexcept
+	{
+		error = std::current_exception();
+	}
+	void rethrowIfFailed() const
+	{
+#ifdef KEYVECTOR_EXCEPTIONS
+		if ( error )
+		{
+			std::rethrow_exception( error );
+		}
+#endif
+	}
+};
+
+template<typename T>
+struct Promise
+	: PromiseBase
+{
+	std::optional<T> value;
+
+	void return_value( T v )
+	{
+		value.emplace( std::move( v ) );
+	}
+	T take()
+	{
+		rethrowIfFailed();
+		return std::move( *value );
+	}
+};
+
+template<>
+struct Promise<void>
+	: PromiseBase
+{
+	void return_void() const noexcept
+	{
+
+	}
+	void take() const
+	{
+		rethrowIfFailed();
+	}
+};
+
+}//detail
+
+
+//============================================================
+//	\class	Task<T>
+//	\brief	a coroutine that starts when it is first co_awaited and resumes its
+//				awaiter when done; co_await yields the co_returned value (or rethrows)
+//=============================================================
+template<typename T = void>
+class Task
+{
+public:
+	struct promise_type
+		: detail::Promise<T>
+	{
+		Task get_return_object() noexcept
+		{
+			return Task{std::coroutine_handle<promise_type>::from_promise( *this )};
+		}
+	};
+private:
+	std::coroutine_handle<promise_type> m_h;
+
+	explicit Task( std::coroutine_handle<promise_type> h ) noexcept
+		:
+		m_h{h}
+	{
+
+	}
+public:
+	Task( const Task& rhs ) = delete;
+	Task& operator=( const Task& rhs ) = delete;
+	Task( Task&& rhs ) noexcept
+		:
+		m_h{std::exchange( rhs.m_h, nullptr )}
+	{
+
+	}
+	Task& operator=( Task&& rhs ) noexcept
+	{
+		Task temp{std::move( rhs )};
+		std::swap( m_h, temp.m_h );
+		return *this;
+	}
+	~Task() noexcept
+	{
+		if ( m_h )
+		{
+			m_h.destroy();
+		}
+	}
+
+	bool await_ready() const noexcept
+	{
+		return m_h.done();
+	}
+	std::coroutine_handle<> await_suspend( std::coroutine_handle<> awaiting ) noexcept
+	{
+		m_h.promise().continuation = awaiting;
+		return m_h;
+	}
+	T await_resume()
+	{
+		return m_h.promise().take();
+	}
+
+	bool isDone() const noexcept
+	{
+		return m_h.done();
+	}
+};
+
+
+namespace detail
+{
+
+// owns itself, its frame goes when it finishes
+struct Detached
+{
+	struct promise_type
+	{
+		Detached get_return_object() const noexcept
+		{
+			return {};
+		}
+		std::suspend_never initial_suspend() const noexcept
+		{
+			return {};
+		}
+		std::suspend_never final_suspend() const noexcept
+		{
+			return {};
+		}
+		void return_void() const noexcept
+		{
+
+		}
+		void unhandled_exception() const noexcept
+		{
+			std::terminate();
+		}
+	};
+};
+
+inline Detached runDetached( Executor& executor,
+	Task<void> task )
+{
+	co_await resumeOn( executor );
+	co_await task;
+}
+
+}//detail
+
+// starts task on executor and forgets about it; an exception escaping it terminates
+inline void spawn( Executor& executor,
+	Task<void> task )
+{
+	detail::runDetached( executor, std::move( task ) );
+}
+
+
+//============================================================
+//	\class	Channel<T>
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 08:00
+//
+//	\brief	producers append elements to a batch of their own (no lock, no suspension)
+//				and only touch the channel when it is full at batchSize elements
+//			at most `capacity` full batches queue up; a producer sending into a full
+//				channel suspends (backpressure) until a consumer takes a batch
+//			co_await nextBatch() yields the next batch, or nullopt once the channel
+//				is closed & drained; a waiting consumer gets a batch handed over directly
+//			whoever frees a waiter posts its resumption to the channel's executor;
+//				the state is guarded by a mutex, held only to move a batch or a handle
+//			recycle() returns a consumed batch's buffer for producers to refill
+//=============================================================
+template<typename T>
+class Channel
+{
+	struct BlockedProducer
+	{
+		std::coroutine_handle<> h;
+		Vector<T>* batch;				// queued once there is room
+	};
+	struct WaitingConsumer
+	{
+		std::coroutine_handle<> h;
+		std::optional<Vector<T>>* slot;	// a batch is handed straight to it
+	};
+
+	Executor& m_executor;
+	std::size_t m_batchSize;
+	std::size_t m_capacity;
+	std::mutex m_mutex;
+	CircularVector<Vector<T>> m_queue;
+	CircularVector<BlockedProducer> m_blocked;
+	CircularVector<WaitingConsumer> m_waiting;
+	Vector<Vector<T>> m_spare;
+	bool m_closed;
+
+	// true if batch went to a consumer or the queue, false if the caller has to wait (then it is registered)
+	bool offer( Vector<T>& batch,
+		std::coroutine_handle<> h )
+	{
+		std::coroutine_handle<> wake;
+		bool accepted = true;
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			assert( !m_closed );
+			if ( !m_waiting.isEmpty() )
+			{
+				*m_waiting.front().slot = std::move( batch );
+				wake = m_waiting.front().h;
+				m_waiting.popFront();
+			}
+			else if ( m_queue.getSize() < m_capacity )
+			{
+				m_queue.pushBack( std::move( batch ) );
+			}
+			else
+			{
+				m_blocked.pushBack( BlockedProducer{h, &batch} );
+				accepted = false;
+			}
+		}
+		if ( wake )
+		{
+			m_executor.post( wake );
+		}
+		return accepted;
+	}
+
+	// true if slot got a batch (or nullopt for the end), false if the caller has to wait (then it is registered)
+	bool poll( std::optional<Vector<T>>& slot,
+		std::coroutine_handle<> h )
+	{
+		std::coroutine_handle<> wake;
+		bool ready = true;
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			if ( !m_queue.isEmpty() )
+			{
+				slot = std::move( m_queue.front() );
+				m_queue.popFront();
+				// producers only block on a full queue, so there is room for one of them now
+				if ( !m_blocked.isEmpty() )
+				{
+					m_queue.pushBack( std::move( *m_blocked.front().batch ) );
+					wake = m_blocked.front().h;
+					m_blocked.popFront();
+				}
+			}
+			else if ( m_closed )
+			{
+				slot.reset();
+			}
+			else
+			{
+				m_waiting.pushBack( WaitingConsumer{h, &slot} );
+				ready = false;
+			}
+		}
+		if ( wake )
+		{
+			m_executor.post( wake );
+		}
+		return ready;
+	}
+
+	Vector<T> acquireBatch()
+	{
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			if ( !m_spare.isEmpty() )
+			{
+				Vector<T> batch{std::move( m_spare.back() )};
+				m_spare.popBack();
+				return batch;
+			}
+		}
+		return Vector<T>{m_batchSize};
+	}
+public:
+	// co_await sendBatch( batch ): batch is moved into the channel, possibly after a wait for room
+	class SendAwaiter
+	{
+		Channel& m_channel;
+		Vector<T>& m_batch;
+	public:
+		SendAwaiter( Channel& channel,
+			Vector<T>& batch ) noexcept
+			:
+			m_channel{channel},
+			m_batch{batch}
+		{
+
+		}
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+		bool await_suspend( std::coroutine_handle<> h )
+		{
+			return !m_channel.offer( m_batch, h );
+		}
+		void await_resume() const noexcept
+		{
+
+		}
+	};
+
+	class BatchAwaiter
+	{
+		Channel& m_channel;
+		std::optional<Vector<T>> m_slot;
+	public:
+		explicit BatchAwaiter( Channel& channel ) noexcept
+			:
+			m_channel{channel},
+			m_slot{}
+		{
+
+		}
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+		bool await_suspend( std::coroutine_handle<> h )
+		{
+			return !m_channel.poll( m_slot, h );
+		}
+		std::optional<Vector<T>> await_resume() noexcept
+		{
+			return std::move( m_slot );
+		}
+	};
+
+	//============================================================
+	//	\class	Producer
+	//	\brief	one per producing coroutine; flush() sends a partial batch
+	//=============================================================
+	class Producer
+	{
+		Channel* m_channel;
+		Vector<T> m_batch;
+		bool m_sent;
+	public:
+		explicit Producer( Channel& channel )
+			:
+			m_channel{&channel},
+			m_batch{channel.acquireBatch()},
+			m_sent{false}
+		{
+
+		}
+
+		// co_await push( x ): suspends only if x completed a batch & the channel is full
+		auto push( T value )
+		{
+			struct Awaiter
+			{
+				Producer& producer;
+				T value;
+
+				bool await_ready()
+				{
+					producer.m_batch.pushBack( std::move( value ) );
+					producer.m_sent = producer.m_batch.getSize() >= producer.m_channel->m_batchSize;
+					return !producer.m_sent;
+				}
+				bool await_suspend( std::coroutine_handle<> h )
+				{
+					return !producer.m_channel->offer( producer.m_batch, h );
+				}
+				void await_resume()
+				{
+					producer.renewIfSent();
+				}
+			};
+			return Awaiter{*this, std::move( value )};
+		}
+
+		// sends whatever is batched so far
+		auto flush()
+		{
+			struct Awaiter
+			{
+				Producer& producer;
+
+				bool await_ready()
+				{
+					producer.m_sent = !producer.m_batch.isEmpty();
+					return !producer.m_sent;
+				}
+				bool await_suspend( std::coroutine_handle<> h )
+				{
+					return !producer.m_channel->offer( producer.m_batch, h );
+				}
+				void await_resume()
+				{
+					producer.renewIfSent();
+				}
+			};
+			return Awaiter{*this};
+		}
+	private:
+		void renewIfSent()
+		{
+			if ( m_sent )
+			{
+				m_batch = m_channel->acquireBatch();
+				m_sent = false;
+			}
+		}
+	};
+
+	// batchSize: elements per batch; capacity: full batches that may queue up (at least 1)
+	explicit Channel( Executor& executor,
+		std::size_t batchSize = 1024,
+		std::size_t capacity = 8 )
+		:
+		m_executor{executor},
+		m_batchSize{std::max<std::size_t>( batchSize, 1 )},
+		m_capacity{std::max<std::size_t>( capacity, 1 )},
+		m_queue{m_capacity},
+		m_blocked{},
+		m_waiting{},
+		m_spare{m_capacity},
+		m_closed{false}
+	{
+
+	}
+	Channel( const Channel& rhs ) = delete;
+	Channel& operator=( const Channel& rhs ) = delete;
+
+	Producer makeProducer()
+	{
+		return Producer{*this};
+	}
+
+	// for batches built elsewhere; any size goes
+	SendAwaiter sendBatch( Vector<T>& batch ) noexcept
+	{
+		return SendAwaiter{*this, batch};
+	}
+
+	BatchAwaiter nextBatch() noexcept
+	{
+		return BatchAwaiter{*this};
+	}
+
+	// no more sends; consumers drain what is queued & then get nullopt
+	void close()
+	{
+		CircularVector<WaitingConsumer> waiting;
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			m_closed = true;
+			std::swap( waiting, m_waiting );
+		}
+		for ( std::size_t i = 0; i < waiting.getSize(); ++i )
+		{
+			waiting[i].slot->reset();
+			m_executor.post( waiting[i].h );
+		}
+	}
+
+	// keeps a consumed batch's buffer for the next producer batch
+	void recycle( Vector<T>&& batch )
+	{
+		batch.clear();
+		std::lock_guard<std::mutex> lock{m_mutex};
+		if ( m_spare.getSize() < m_capacity && batch.getCapacity() >= m_batchSize )
+		{
+			m_spare.pushBack( std::move( batch ) );
+		}
+	}
+
+	std::size_t getBatchSize() const noexcept
+	{
+		return m_batchSize;
+	}
+	std::size_t getCapacity() const noexcept
+	{
+		return m_capacity;
+	}
+};
+
+
+//============================================================
+//	\class	Generator<T>
+//	\brief	synchronous generator: co_yield values, iterate them with range for;
+//				the body runs up to the next co_yield on every increment
+//=============================================================
+template<typename T>
+class Generator
+{
+public:
+	struct promise_type
+	{
+		std::remove_reference_t<T>* current = nullptr;
+		std::exception_ptr error;
+
+		Generator get_return_object() noexcept
+		{
+			return Generator{std::coroutine_handle<promise_type>::from_promise( *this )};
+		}
+		std::suspend_always initial_suspend() const noexcept
+		{
+			return {};
+		}
+		std::suspend_always final_suspend() const noexcept
+		{
+			return {};
+		}
+		// the yielded object lives in the suspended frame until the next resumption
+		std::suspend_always yield_value( std::remove_reference_t<T>& value ) noexcept
+		{
+			current = std::addressof( value );
+			return {};
+		}
+		std::suspend_always yield_value( std::remove_reference_t<T>&& value ) noexcept
+		{
+			current = std::addressof( value );
+			return {};
+		}
+		void return_void() const noexcept
+		{
+
+		}
+		void unhandled_exception() noexcept
+		{
+			error = std::current_exception();
+		}
+		template<typename U>
+		std::suspend_never await_transform( U&& ) = delete;
+	};
+private:
+	std::coroutine_handle<promise_type> m_h;
+
+	explicit Generator( std::coroutine_handle<promise_type> h ) noexcept
+		:
+		m_h{h}
+	{
+
+	}
+
+	void advance()
+	{
+		m_h.resume();
+#ifdef KEYVECTOR_EXCEPTIONS
+		if ( m_h.promise().error )
+		{
+			std::rethrow_exception( m_h.promise().error );
+		}
+#endif
+	}
+public:
+	class Iterator
+	{
+		Generator* m_gen;
+	public:
+		using value_type = std::remove_cvref_t<T>;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() noexcept
+			:
+			m_gen{nullptr}
+		{
+
+		}
+		explicit Iterator( Generator& gen ) noexcept
+			:
+			m_gen{&gen}
+		{
+
+		}
+
+		std::remove_reference_t<T>& operator*() const noexcept
+		{
+			return *m_gen->m_h.promise().current;
+		}
+		Iterator& operator++()
+		{
+			m_gen->advance();
+			return *this;
+		}
+		void operator++( int )
+		{
+			++*this;
+		}
+		bool operator==( std::default_sentinel_t ) const noexcept
+		{
+			return m_gen->m_h.done();
+		}
+	};
+
+	Generator( const Generator& rhs ) = delete;
+	Generator& operator=( const Generator& rhs ) = delete;
+	Generator( Generator&& rhs ) noexcept
+		:
+		m_h{std::exchange( rhs.m_h, nullptr )}
+	{
+
+	}
+	Generator& operator=( Generator&& rhs ) noexcept
+	{
+		Generator temp{std::move( rhs )};
+		std::swap( m_h, temp.m_h );
+		return *this;
+	}
+	~Generator() noexcept
+	{
+		if ( m_h )
+		{
+			m_h.destroy();
+		}
+	}
+
+	// once only
+	Iterator begin()
+	{
+		advance();
+		return Iterator{*this};
+	}
+	std::default_sentinel_t end() const noexcept
+	{
+		return {};
+	}
+};
+
+namespace detail
+{
+
+template<typename View>
+Generator<Vector<std::ranges::range_value_t<View>>> batchesOf( View view,
+	std::size_t batchSize )
+{
+	using T = std::ranges::range_value_t<View>;
+	Vector<T> batch{batchSize};
+	for ( auto&& x : view )
+	{
+		batch.pushBack( x );
+		if ( batch.getSize() == batchSize )
+		{
+			co_yield batch;
+			batch = Vector<T>{batchSize};
+		}
+	}
+	if ( !batch.isEmpty() )
+	{
+		co_yield batch;
+	}
+}
+
+}//detail
+
+// range in Vectors of batchSize elements (the last one may be shorter); an lvalue range is
+//	referenced, so it has to outlive the generator, an rvalue one is moved in
+template<std::ranges::viewable_range R>
+auto batches( R&& range,
+	std::size_t batchSize )
+{
+	return detail::batchesOf( std::views::all( std::forward<R>( range ) ), std::max<std::size_t>( batchSize, 1 ) );
+}
+
+}//coro
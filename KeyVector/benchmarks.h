@@ -0,0 +1,1680 @@
+#pragma once
+
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include <unordered_map>
+#include <span>
+#include <execution>
+#include <numeric>
+#include <sstream>
+#include <streambuf>
+#include <shared_mutex>
+#include <ranges>
+#include <latch>
+#ifdef _MSC_VER
+#	include <intrin.h>
+#endif
+#include "vector.h"
+#include "compressed_vector.h"
+#include "streaming.h"
+#include "numa.h"
+#include "buffer_cache.h"
+#include "slot_map.h"
+#include "parallel.h"
+#include "tracked_vector.h"
+#include "search_index.h"
+#include "string_vector.h"
+#include "rcu_vector.h"
+#include "incremental_vector.h"
+#include "sparse_vector.h"
+#include "md_vector.h"
+#include "hash_ops.h"
+#include "selection.h"
+#include "async_channel.h"
+
+
+//============================================================
+//	\class	Timer
+//	\brief	wall clock stopwatch for the micro benchmarks below
+//			build main.cpp with BENCHMARK defined (Release) to run them
+//=============================================================
+class Timer
+{
+	std::chrono::steady_clock::time_point m_start;
+public:
+	Timer()
+		:
+		m_start{std::chrono::steady_clock::now()}
+	{
+
+	}
+
+	double elapsedSec() const noexcept
+	{
+		return std::chrono::duration<double>( std::chrono::steady_clock::now() - m_start ).count();
+	}
+};
+
+// keeps the optimizer from discarding benchmark results
+template<typename T>
+inline void doNotOptimize( const T& value ) noexcept
+{
+#if defined __GNUC__ || defined __clang__
+	asm volatile( "" : : "r,m"( value ) : "memory" );
+#else
+	static thread_local volatile const void* sink;
+	sink = &value;
+	_ReadWriteBarrier();
+#endif
+}
+
+inline void benchCompressedVector( std::size_t n = 10'000'000 )
+{
+	std::cout << "=== PackedIntVector / DeltaVector (" << n << " sorted ids) ===\n";
+	std::mt19937_64 rng{42};
+	std::uniform_int_distribution<std::uint64_t> gap{0, 4095};
+	Vector<std::uint64_t> dense{n};
+	std::uint64_t id = 0;
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		id += gap( rng );
+		dense.pushBack( id );
+	}
+
+	Timer t0;
+	const auto packed = PackedIntVector<std::uint64_t>::fromVector( dense );
+	const double packSec = t0.elapsedSec();
+	Timer t1;
+	const auto delta = DeltaVector<std::uint64_t>::fromVector( dense );
+	const double deltaSec = t1.elapsedSec();
+
+	const double mb = n * sizeof( std::uint64_t ) / ( 1024.0 * 1024.0 );
+	std::cout << "dense bytes:  " << n * sizeof( std::uint64_t ) << '\n'
+		<< "packed bytes: " << packed.getSizeInBytes() << " (" << packed.getBitWidth() << " bits, ratio "
+		<< packed.compressionRatio() << ", encode " << mb / packSec << " MB/s)\n"
+		<< "delta bytes:  " << delta.getSizeInBytes() << " (ratio " << delta.compressionRatio()
+		<< ", encode " << mb / deltaSec << " MB/s)\n";
+
+	std::uint64_t buffer[1024];
+	std::uint64_t sum = 0;
+	Timer t2;
+	for ( std::size_t i = 0; i < n; i += 1024 )
+	{
+		const std::size_t cnt = std::min<std::size_t>( 1024, n - i );
+		packed.decode( i, cnt, buffer );
+		for ( std::size_t j = 0; j < cnt; ++j )
+		{
+			sum += buffer[j];
+		}
+	}
+	std::cout << "packed bulk decode:   " << mb / t2.elapsedSec() << " MB/s\n";
+
+	Timer t3;
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		sum += packed[i];
+	}
+	std::cout << "packed random access: " << mb / t3.elapsedSec() << " MB/s\n";
+
+	Timer t4;
+	delta.forEach( [&sum]( std::uint64_t v )
+		{
+			sum += v;
+		}
+	);
+	std::cout << "delta stream decode:  " << mb / t4.elapsedSec() << " MB/s\n";
+
+	Timer t5;
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		sum += dense[i];
+	}
+	std::cout << "dense scan:           " << mb / t5.elapsedSec() << " MB/s\n";
+
+	constexpr std::size_t nQueries = 1'000'000;
+	std::uniform_int_distribution<std::uint64_t> key{0, id};
+	Vector<std::uint64_t> queries{nQueries};
+	for ( std::size_t i = 0; i < nQueries; ++i )
+	{
+		queries.pushBack( key( rng ) );
+	}
+	Timer t6;
+	for ( std::size_t i = 0; i < nQueries; ++i )
+	{
+		sum += delta.lowerBound( queries[i] );
+	}
+	const double deltaLb = t6.elapsedSec();
+	Timer t7;
+	for ( std::size_t i = 0; i < nQueries; ++i )
+	{
+		sum += std::lower_bound( dense.begin(), dense.end(), queries[i] ) - dense.begin();
+	}
+	const double denseLb = t7.elapsedSec();
+	std::cout << "delta lowerBound: " << nQueries / deltaLb / 1e6 << " Mq/s, "
+		<< "std::lower_bound: " << nQueries / denseLb / 1e6 << " Mq/s\n";
+	doNotOptimize( sum );
+}
+
+// a cache sensitive "victim" thread does random reads over a hot working set
+//	while the main thread copies a huge buffer; reports copy bandwidth and
+//	how many victim lookups survive each copy flavour
+inline void benchStreamingCopy( std::size_t bytes = 512ull << 20,
+	std::size_t hotBytes = 8ull << 20 )
+{
+	std::cout << "=== streaming copy (" << ( bytes >> 20 ) << " MB copy vs " << ( hotBytes >> 20 ) << " MB hot set) ===\n";
+	const std::size_t n = bytes / sizeof( std::uint64_t );
+	Vector<std::uint64_t> src{n, 1};
+	Vector<std::uint64_t> dst{n, 0};
+
+	const std::size_t hotN = hotBytes / sizeof( std::uint32_t );
+	Vector<std::uint32_t> hot{hotN, 0};
+	std::mt19937 rng{7};
+	for ( std::size_t i = 0; i < hotN; ++i )
+	{
+		hot[i] = static_cast<std::uint32_t>( rng() % hotN );
+	}
+
+	auto run = [&]( const char* label, auto&& copyFn )
+	{
+		std::atomic<bool> stop{false};
+		std::atomic<std::uint64_t> lookups{0};
+		std::thread victim{[&]()
+			{
+				std::uint32_t idx = 0;
+				std::uint64_t local = 0;
+				while ( !stop.load( std::memory_order_relaxed ) )
+				{
+					for ( int k = 0; k < 1024; ++k )
+					{
+						idx = hot[idx];
+					}
+					local += 1024;
+				}
+				lookups = local + idx % 2;
+			}
+		};
+		Timer t;
+		for ( int rep = 0; rep < 4; ++rep )
+		{
+			copyFn();
+		}
+		const double sec = t.elapsedSec();
+		stop = true;
+		victim.join();
+		std::cout << label << ": copy " << 4.0 * bytes / sec / ( 1 << 30 ) << " GB/s, victim "
+			<< lookups / sec / 1e6 << " Mlookups/s\n";
+	};
+
+	run( "memcpy           ", [&]()
+		{
+			std::memcpy( dst.begin(), src.begin(), bytes );
+		}
+	);
+	run( "non-temporal copy", [&]()
+		{
+			streaming::copyNonTemporal( dst.begin(), src.begin(), bytes );
+		}
+	);
+	run( "Vector copy ctor ", [&]()
+		{
+			Vector<std::uint64_t> copy{src};
+			doNotOptimize( copy[n - 1] );
+		}
+	);
+}
+
+// node-partitioned parallelForEach over the same data under each placement
+//	run with KEYVECTOR_NUMA_EMULATE=<n> to exercise the partitioning on a single node box
+inline void benchNumaPlacement( std::size_t n = 64ull << 20 )
+{
+	const numa::Topology& topo = numa::Topology::instance();
+	std::cout << "=== NUMA placement (" << topo.getNodeCount() << " node(s)"
+		<< ( topo.isEmulated() ? ", emulated" : "" ) << ", " << ( n * sizeof( double ) >> 20 ) << " MB) ===\n";
+	const std::pair<numa::Placement, const char*> placements[] = {
+		{numa::Placement::Default, "first touch (1 thread)"},
+		{numa::Placement::Interleaved, "interleaved          "},
+		{numa::Placement::Partitioned, "partitioned          "}
+	};
+	for ( const auto& [placement, label] : placements )
+	{
+		Vector<double> v{n};
+		const bool placed = numa::place( v, placement );
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			v.pushBack( 1.0 );
+		}
+		Timer t;
+		for ( int rep = 0; rep < 5; ++rep )
+		{
+			numa::parallelForEach( v, []( double& x )
+				{
+					x = x * 1.000001 + 0.5;
+				}
+			);
+		}
+		const double sec = t.elapsedSec();
+		std::cout << label << ( placed ? "" : " (not placed)" ) << ": "
+			<< 5.0 * n * sizeof( double ) / sec / ( 1 << 30 ) << " GB/s\n";
+		doNotOptimize( v[n - 1] );
+	}
+}
+
+// request handler style churn: every thread keeps creating, filling and dropping
+//	small Vectors; a quarter of them are handed to the neighbour thread to free
+template<typename Alloc>
+double churnVectors( unsigned nThreads,
+	std::size_t iterations,
+	double* hitRate = nullptr )
+{
+	std::atomic<std::uint64_t> hits{0};
+	std::atomic<std::uint64_t> misses{0};
+	std::vector<std::thread> threads;
+	std::vector<std::atomic<Vector<int, Alloc>*>> mailboxes( nThreads );
+	for ( auto& m : mailboxes )
+	{
+		m = nullptr;
+	}
+	Timer t;
+	for ( unsigned tid = 0; tid < nThreads; ++tid )
+	{
+		threads.emplace_back( [&, tid]()
+			{
+				const std::size_t sizes[] = {64, 64, 128, 256, 1024};
+				int sink = 0;
+				for ( std::size_t i = 0; i < iterations; ++i )
+				{
+					auto* v = new Vector<int, Alloc>{sizes[i % 5]};
+					for ( int k = 0; k < 16; ++k )
+					{
+						v->pushBack( k );
+					}
+					sink += ( *v )[15];
+					if ( i % 4 == 0 )
+					{
+						delete mailboxes[( tid + 1 ) % nThreads].exchange( v );
+					}
+					else
+					{
+						delete v;
+					}
+				}
+				doNotOptimize( sink );
+				const BufferCacheStats stats = ThreadBufferCache::stats();
+				hits += stats.hits;
+				misses += stats.misses;
+			}
+		);
+	}
+	for ( auto& th : threads )
+	{
+		th.join();
+	}
+	const double sec = t.elapsedSec();
+	// leftovers are freed after their owners exited (retired caches)
+	for ( auto& m : mailboxes )
+	{
+		delete m.exchange( nullptr );
+	}
+	if ( hitRate )
+	{
+		*hitRate = static_cast<double>( hits ) / std::max<std::uint64_t>( hits + misses, 1 );
+	}
+	return nThreads * iterations / sec;
+}
+
+inline void benchBufferCache( std::size_t iterations = 2'000'000 )
+{
+	std::cout << "=== thread-local buffer cache vs global heap (Vector churn) ===\n";
+	for ( unsigned nThreads : {1u, 2u, 4u, 8u} )
+	{
+		const double heap = churnVectors<std::allocator<int>>( nThreads, iterations / nThreads );
+		double hitRate;
+		const double cached = churnVectors<CachingAllocator<int>>( nThreads, iterations / nThreads, &hitRate );
+		std::cout << nThreads << " thread(s): malloc " << heap / 1e6 << " Mvec/s, cached "
+			<< cached / 1e6 << " Mvec/s (x" << cached / heap << ", hit rate " << hitRate << ")\n";
+	}
+}
+
+// Vector's iterators are plain pointers, so these should match std::vector to the noise
+//	(the copies lower to memmove, find to the same vectorized loop)
+inline void benchContiguousAlgorithms( std::size_t n = 16ull << 20 )
+{
+	std::cout << "=== std algorithms over Vector vs std::vector (" << n << " ints) ===\n";
+	Vector<int> v{n, 1};
+	Vector<int> vOut{n, 0};
+	std::vector<int> sv( n, 1 );
+	std::vector<int> svOut( n, 0 );
+	v[n - 1] = 7;
+	sv[n - 1] = 7;
+	constexpr int reps = 20;
+
+	auto time = [&]( const char* label, auto&& fn )
+	{
+		Timer t;
+		for ( int rep = 0; rep < reps; ++rep )
+		{
+			fn();
+		}
+		std::cout << label << ": " << reps * n * sizeof( int ) / t.elapsedSec() / ( 1 << 30 ) << " GB/s\n";
+	};
+	time( "std::copy           Vector     ", [&]()
+		{
+			std::copy( v.cbegin(), v.cend(), vOut.begin() );
+		}
+	);
+	time( "std::copy           std::vector", [&]()
+		{
+			std::copy( sv.cbegin(), sv.cend(), svOut.begin() );
+		}
+	);
+	time( "std::ranges::copy   Vector     ", [&]()
+		{
+			std::ranges::copy( v, vOut.begin() );
+		}
+	);
+	time( "std::ranges::copy   std::vector", [&]()
+		{
+			std::ranges::copy( sv, svOut.begin() );
+		}
+	);
+	time( "std::ranges::find   Vector     ", [&]()
+		{
+			doNotOptimize( std::ranges::find( v, 7 ) );
+		}
+	);
+	time( "std::ranges::find   std::vector", [&]()
+		{
+			doNotOptimize( std::ranges::find( sv, 7 ) );
+		}
+	);
+	time( "std::span sum       Vector     ", [&]()
+		{
+			std::span<const int> span = v;
+			long long sum = 0;
+			for ( int x : span )
+			{
+				sum += x;
+			}
+			doNotOptimize( sum );
+		}
+	);
+}
+
+// stream buffer that counts & discards, so only the formatting is measured
+class NullStreamBuf final
+	: public std::streambuf
+{
+	std::size_t m_bytes = 0;
+protected:
+	int_type overflow( int_type c ) override
+	{
+		++m_bytes;
+		return traits_type::not_eof( c );
+	}
+	std::streamsize xsputn( const char*,
+		std::streamsize n ) override
+	{
+		m_bytes += static_cast<std::size_t>( n );
+		return n;
+	}
+public:
+	std::size_t getBytes() const noexcept
+	{
+		return m_bytes;
+	}
+};
+
+template<typename T>
+void benchTextFormattingOf( const char* typeName,
+	const Vector<T>& v )
+{
+	NullStreamBuf streamSink;
+	std::ostream out{&streamSink};
+	out.precision( 17 );
+	Timer t;
+	for ( const T& x : v )
+	{
+		out << x << ' ';
+	}
+	const double streamSec = t.elapsedSec();
+	const double mb = streamSink.getBytes() / double( 1 << 20 );
+
+	NullStreamBuf bulkSink;
+	std::ostream bulkOut{&bulkSink};
+	bulkOut.precision( 17 );
+	t = Timer{};
+	bulkOut << v;
+	const double bulkSec = t.elapsedSec();
+
+	std::string text;
+	{
+		std::ostringstream oss;
+		oss.precision( 17 );
+		oss << v;
+		text = oss.str();
+	}
+	t = Timer{};
+	{
+		std::istringstream iss{text};
+		Vector<T> back{v.getSize()};
+		T x;
+		while ( iss >> x )
+		{
+			back.pushBack( x );
+		}
+		doNotOptimize( back.getSize() );
+	}
+	const double istreamSec = t.elapsedSec();
+	t = Timer{};
+	Expected<Vector<T>> parsed = Vector<T>::fromChars( text );
+	const double fromCharsSec = t.elapsedSec();
+	doNotOptimize( parsed.hasValue() );
+
+	std::cout << typeName << " format: ostream << " << mb / streamSec << " MB/s, to_chars bulk "
+		<< mb / bulkSec << " MB/s (x" << streamSec / bulkSec << ")\n"
+		<< typeName << " parse:  istream >> " << mb / istreamSec << " MB/s, from_chars "
+		<< mb / fromCharsSec << " MB/s (x" << istreamSec / fromCharsSec << ")\n";
+}
+
+inline void benchTextFormatting( std::size_t n = 10'000'000 )
+{
+	std::cout << "=== text formatting & parsing (" << n << " elements) ===\n";
+	std::mt19937_64 rng{7};
+	Vector<std::int64_t> ints{n};
+	Vector<double> reals{n};
+	std::uniform_int_distribution<std::int64_t> intDist{-1'000'000'000, 1'000'000'000};
+	std::uniform_real_distribution<double> realDist{-1e6, 1e6};
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		ints.pushBack( intDist( rng ) );
+		reals.pushBack( realDist( rng ) );
+	}
+	benchTextFormattingOf( "int64 ", ints );
+	benchTextFormattingOf( "double", reals );
+}
+
+// entity table churn: insert n, random lookups, dense iteration, erase half, refill
+inline void benchSlotMap( std::size_t n = 1'000'000 )
+{
+	std::cout << "=== SlotMap vs std::unordered_map (" << n << " elements) ===\n";
+	struct Entity
+	{
+		float position[3];
+		float velocity[3];
+	};
+	std::mt19937_64 rng{11};
+	Vector<std::size_t> order{n};
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		order.pushBack( rng() % n );
+	}
+
+	auto report = [n]( const char* label, double slotSec, double mapSec )
+	{
+		std::cout << label << ": SlotMap " << n / slotSec / 1e6 << " Mops/s, unordered_map "
+			<< n / mapSec / 1e6 << " Mops/s (x" << mapSec / slotSec << ")\n";
+	};
+
+	SlotMap<Entity> slots;
+	Vector<SlotHandle> handles{n};
+	std::unordered_map<std::uint64_t, Entity> map;
+	Timer t;
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		handles.pushBack( slots.insert( Entity{{float( i )}, {1.0f}} ) );
+	}
+	const double slotInsert = t.elapsedSec();
+	t = Timer{};
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		map.emplace( i, Entity{{float( i )}, {1.0f}} );
+	}
+	report( "insert ", slotInsert, t.elapsedSec() );
+
+	t = Timer{};
+	float sum = 0;
+	for ( std::size_t i : order )
+	{
+		sum += slots[handles[i]].position[0];
+	}
+	const double slotLookup = t.elapsedSec();
+	doNotOptimize( sum );
+	t = Timer{};
+	sum = 0;
+	for ( std::size_t i : order )
+	{
+		sum += map.find( i )->second.position[0];
+	}
+	doNotOptimize( sum );
+	report( "lookup ", slotLookup, t.elapsedSec() );
+
+	t = Timer{};
+	for ( Entity& e : slots )
+	{
+		e.position[0] += e.velocity[0];
+	}
+	const double slotIterate = t.elapsedSec();
+	doNotOptimize( slots.values().data() );
+	t = Timer{};
+	for ( auto& kv : map )
+	{
+		kv.second.position[0] += kv.second.velocity[0];
+	}
+	doNotOptimize( map.size() );
+	report( "iterate", slotIterate, t.elapsedSec() );
+
+	t = Timer{};
+	for ( std::size_t i = 0; i < n; i += 2 )
+	{
+		slots.erase( handles[order[i]] );
+	}
+	for ( std::size_t i = 0; i < n; i += 2 )
+	{
+		slots.insert( Entity{} );
+	}
+	const double slotChurn = t.elapsedSec();
+	t = Timer{};
+	for ( std::size_t i = 0; i < n; i += 2 )
+	{
+		map.erase( order[i] );
+	}
+	for ( std::size_t i = 0; i < n; i += 2 )
+	{
+		map.emplace( n + i, Entity{} );
+	}
+	report( "churn  ", slotChurn, t.elapsedSec() );
+}
+
+// filter passes: rebuilding with pushBack (the only option before erase existed),
+//	std::remove_if on std::vector and Vector::eraseIf, across selectivities
+inline void benchErase( std::size_t n = 16ull << 20 )
+{
+	std::cout << "=== eraseIf / removeIndices (" << n << " ints) ===\n";
+	std::mt19937 rng{5};
+	std::vector<int> source( n );
+	for ( int& x : source )
+	{
+		x = static_cast<int>( rng() % 100 );
+	}
+	Vector<int> v{n};
+	for ( int percent : {10, 50, 90} )
+	{
+		auto pred = [percent]( int x )
+		{
+			return x < percent;
+		};
+
+		v.clear();
+		v.append( source.data(), source.data() + n );
+		Timer t;
+		Vector<int> rebuilt{n};
+		for ( int x : v )
+		{
+			if ( !pred( x ) )
+			{
+				rebuilt.pushBack( x );
+			}
+		}
+		const double rebuildSec = t.elapsedSec();
+
+		std::vector<int> sv = source;
+		t = Timer{};
+		sv.erase( std::remove_if( sv.begin(), sv.end(), pred ), sv.end() );
+		const double stdSec = t.elapsedSec();
+
+		t = Timer{};
+		v.eraseIf( pred );
+		const double eraseIfSec = t.elapsedSec();
+		doNotOptimize( v.getSize() + rebuilt.getSize() + sv.size() );
+
+		std::cout << percent << "% removed: rebuild " << n / rebuildSec / 1e6 << " M/s, std::remove_if "
+			<< n / stdSec / 1e6 << " M/s, eraseIf " << n / eraseIfSec / 1e6 << " M/s\n";
+	}
+
+	// 1% of the positions, batched vs one erase at a time (on a smaller vector - that one is quadratic)
+	const std::size_t small = n / 64;
+	Vector<std::size_t> positions{small / 100 + 1};
+	for ( std::size_t i = 0; i < small; i += 100 )
+	{
+		positions.pushBack( i );
+	}
+	v.clear();
+	v.append( source.data(), source.data() + small );
+	Timer t;
+	for ( std::size_t i = positions.getSize(); i > 0; --i )
+	{
+		v.erase( v.cbegin() + positions[i - 1] );
+	}
+	const double oneByOneSec = t.elapsedSec();
+	v.clear();
+	v.append( source.data(), source.data() + small );
+	t = Timer{};
+	v.removeIndices( positions.asSpan() );
+	const double batchedSec = t.elapsedSec();
+	std::cout << "removeIndices (" << positions.getSize() << " of " << small << "): one by one "
+		<< oneByOneSec * 1e3 << " ms, batched " << batchedSec * 1e3 << " ms\n";
+}
+
+// scaling of the pool algorithms over 1..hardware threads, next to std::execution::par
+inline void benchParallelAlgorithms( std::size_t n = 64ull << 20 )
+{
+	std::cout << "=== parallel algorithms (" << n << " floats) ===\n";
+	Vector<float> data{n, 1.0f};
+	std::vector<float> stdData( n, 1.0f );
+	constexpr int reps = 5;
+	auto gbps = [n]( double sec )
+	{
+		return reps * n * sizeof( float ) / sec / ( 1 << 30 );
+	};
+	auto square = []( float x )
+	{
+		return x * x;
+	};
+	auto isBig = []( float x )
+	{
+		return x > 0.5f;
+	};
+
+	const unsigned hw = std::max( 1u, std::thread::hardware_concurrency() );
+	for ( unsigned threads = 1; threads <= hw; threads *= 2 )
+	{
+		parallel::ThreadPool pool{threads - 1};
+		Timer t;
+		for ( int rep = 0; rep < reps; ++rep )
+		{
+			doNotOptimize( parallel::parallelReduce( data, 0.0f, std::plus<>{}, 0, pool ) );
+		}
+		const double reduceSec = t.elapsedSec();
+		t = Timer{};
+		for ( int rep = 0; rep < reps; ++rep )
+		{
+			parallel::parallelTransform( data, square, 0, pool );
+		}
+		const double transformSec = t.elapsedSec();
+		t = Timer{};
+		for ( int rep = 0; rep < reps; ++rep )
+		{
+			doNotOptimize( parallel::parallelCountIf( data, isBig, 0, pool ) );
+		}
+		const double countSec = t.elapsedSec();
+		t = Timer{};
+		for ( int rep = 0; rep < reps; ++rep )
+		{
+			parallel::parallelInclusiveScan( data, std::plus<>{}, 0, pool );
+			data[0] = 1.0f;	// keep the values bounded
+		}
+		const double scanSec = t.elapsedSec();
+		std::cout << threads << " thread(s): reduce " << gbps( reduceSec ) << " GB/s, transform " << gbps( transformSec )
+			<< " GB/s, countIf " << gbps( countSec ) << " GB/s, inclusive scan " << gbps( scanSec ) << " GB/s\n";
+	}
+
+	Timer t;
+	for ( int rep = 0; rep < reps; ++rep )
+	{
+		doNotOptimize( std::reduce( std::execution::par, stdData.begin(), stdData.end(), 0.0f ) );
+	}
+	const double reduceSec = t.elapsedSec();
+	t = Timer{};
+	for ( int rep = 0; rep < reps; ++rep )
+	{
+		std::transform( std::execution::par, stdData.begin(), stdData.end(), stdData.begin(), square );
+	}
+	const double transformSec = t.elapsedSec();
+	t = Timer{};
+	for ( int rep = 0; rep < reps; ++rep )
+	{
+		doNotOptimize( std::count_if( std::execution::par, stdData.begin(), stdData.end(), isBig ) );
+	}
+	const double countSec = t.elapsedSec();
+	t = Timer{};
+	for ( int rep = 0; rep < reps; ++rep )
+	{
+		std::inclusive_scan( std::execution::par, stdData.begin(), stdData.end(), stdData.begin() );
+		stdData[0] = 1.0f;
+	}
+	const double scanSec = t.elapsedSec();
+	std::cout << "std::execution::par: reduce " << gbps( reduceSec ) << " GB/s, transform " << gbps( transformSec )
+		<< " GB/s, countIf " << gbps( countSec ) << " GB/s, inclusive scan " << gbps( scanSec ) << " GB/s\n";
+}
+
+// replication of a batch touching 0.1% of a table: full resend vs dirty range delta
+inline void benchDeltaReplication( std::size_t n = 16ull << 20 )
+{
+	std::cout << "=== dirty range replication (" << n << " int64, 0.1% updated per batch) ===\n";
+	Vector<std::int64_t> seed{n, 0};
+	TrackedVector<std::int64_t> leader{seed};
+	Vector<std::int64_t> follower{seed};
+	std::mt19937_64 rng{3};
+	const std::size_t updates = n / 1000;
+	const std::size_t fullBytes = n * sizeof( std::int64_t );
+
+	for ( const char* pattern : {"scattered", "clustered"} )
+	{
+		Timer t;
+		const bool clustered = pattern[0] == 'c';
+		std::size_t runStart = 0;
+		for ( std::size_t u = 0; u < updates; ++u )
+		{
+			// clustered: runs of 16 neighbours, like row batches
+			if ( u % 16 == 0 )
+			{
+				runStart = rng() % ( n - 16 );
+			}
+			const std::size_t i = clustered ?
+				runStart + u % 16 :
+				rng() % n;
+			leader[i] += 1;
+		}
+		const double recordSec = t.elapsedSec();
+		const std::size_t ranges = leader.getDirtyRanges().getRangeCount();
+		t = Timer{};
+		Vector<std::byte> delta = leader.collectDelta();
+		const double collectSec = t.elapsedSec();
+		t = Timer{};
+		TrackedVector<std::int64_t>::applyDelta( follower, delta.asSpan() );
+		const double applySec = t.elapsedSec();
+		t = Timer{};
+		Vector<std::int64_t> fullCopy{leader.getVector()};
+		const double fullSec = t.elapsedSec();
+		doNotOptimize( fullCopy.data() );
+
+		std::cout << pattern << ": " << ranges << " ranges, delta " << delta.getSize() / 1024.0 << " KB vs full "
+			<< fullBytes / double( 1 << 20 ) << " MB (" << 100.0 * delta.getSize() / fullBytes << "%); record "
+			<< recordSec / updates * 1e9 << " ns/update, collect " << collectSec * 1e3 << " ms, apply "
+			<< applySec * 1e3 << " ms vs full copy " << fullSec * 1e3 << " ms\n";
+	}
+}
+
+// lookups into sorted uint64 keys of growing size: std::lower_bound vs the
+//	Eytzinger & static B-tree layouts, one query at a time and interleaved
+inline void benchSearchIndex( std::size_t queries = 1ull << 20 )
+{
+	std::cout << "=== search index lookups (" << queries << " random queries, ns/lookup) ===\n";
+	std::mt19937_64 rng{9};
+	Vector<std::uint64_t> q{queries};
+	Vector<std::size_t> out{queries, 0};
+	for ( std::size_t n : {1ull << 12, 1ull << 16, 1ull << 20, 1ull << 24, 1ull << 26} )
+	{
+		Vector<std::uint64_t> keys{n};
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			keys.pushBack( rng() );
+		}
+		std::sort( keys.begin(), keys.end() );
+		q.clear();
+		for ( std::size_t i = 0; i < queries; ++i )
+		{
+			q.pushBack( rng() );
+		}
+		const search::EytzingerIndex<std::uint64_t> eytzinger{keys};
+		const search::StaticBTreeIndex<std::uint64_t> btree{keys};
+
+		auto nsPerQuery = [queries]( const Timer& t )
+		{
+			return t.elapsedSec() * 1e9 / queries;
+		};
+		std::size_t checksum = 0;
+		Timer t;
+		for ( std::uint64_t x : q )
+		{
+			checksum += static_cast<std::size_t>( std::lower_bound( keys.begin(), keys.end(), x ) - keys.begin() );
+		}
+		const double stdNs = nsPerQuery( t );
+		t = Timer{};
+		for ( std::uint64_t x : q )
+		{
+			checksum += eytzinger.lowerBound( x );
+		}
+		const double eytzingerNs = nsPerQuery( t );
+		t = Timer{};
+		eytzinger.lowerBound( q.asSpan(), out.asSpan() );
+		const double eytzingerBatchNs = nsPerQuery( t );
+		t = Timer{};
+		for ( std::uint64_t x : q )
+		{
+			checksum += btree.lowerBound( x );
+		}
+		const double btreeNs = nsPerQuery( t );
+		t = Timer{};
+		btree.lowerBound( q.asSpan(), out.asSpan() );
+		const double btreeBatchNs = nsPerQuery( t );
+		doNotOptimize( checksum + out[0] );
+
+		std::cout << "n=" << n << ": std::lower_bound " << stdNs << ", eytzinger " << eytzingerNs << " (batched "
+			<< eytzingerBatchNs << "), b-tree " << btreeNs << " (batched " << btreeBatchNs << ")\n";
+	}
+}
+
+// n short strings (4..24 chars, ~2/3 repeats drawn from a small pool): build, memory &
+//	a full scan of Vector<std::string> vs the arena StringVector, with & without interning
+inline void benchStringVector( std::size_t n = 4'000'000 )
+{
+	std::cout << "=== StringVector vs Vector<std::string> (" << n << " strings) ===\n";
+	std::mt19937_64 rng{13};
+	std::string text;
+	Vector<std::size_t> lengths{n};
+	std::string pool[64];
+	for ( std::string& s : pool )
+	{
+		s.assign( 4 + rng() % 21, 'a' );
+		std::generate( s.begin(), s.end(), [&rng] { return static_cast<char>( 'a' + rng() % 26 ); } );
+	}
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		std::string s = pool[rng() % 64];
+		if ( rng() % 3 == 0 )
+		{
+			std::generate( s.begin(), s.end(), [&rng] { return static_cast<char>( 'a' + rng() % 26 ); } );
+		}
+		text += s;
+		lengths.pushBack( s.size() );
+	}
+	auto source = [&text, &lengths]( std::size_t i, std::size_t& at )
+	{
+		const std::string_view s{text.data() + at, lengths[i]};
+		at += lengths[i];
+		return s;
+	};
+	auto scan = []( const auto& strings )
+	{
+		std::size_t h = 0;
+		for ( std::string_view s : strings )
+		{
+			h += s.size() * 31 + static_cast<unsigned char>( s.back() );
+		}
+		return h;
+	};
+
+	Timer t;
+	Vector<std::string> strings;
+	for ( std::size_t i = 0, at = 0; i < n; ++i )
+	{
+		strings.pushBack( std::string{source( i, at )} );
+	}
+	const double stdBuild = t.elapsedSec();
+	std::size_t stdBytes = strings.getCapacity() * sizeof( std::string );
+	for ( const std::string& s : strings )
+	{
+		stdBytes += s.capacity() > std::string{}.capacity() ? s.capacity() + 1 : 0;	// heap beyond SSO
+	}
+	t = Timer{};
+	std::size_t checksum = scan( strings );
+	const double stdScan = t.elapsedSec();
+
+	auto run = [&]( const char* label, Interning interning )
+	{
+		Timer timer;
+		StringVector arena{interning};
+		for ( std::size_t i = 0, at = 0; i < n; ++i )
+		{
+			arena.pushBack( source( i, at ) );
+		}
+		const double build = timer.elapsedSec();
+		timer = Timer{};
+		checksum += scan( arena );
+		const double scanSec = timer.elapsedSec();
+		std::cout << label << ": build " << build * 1e3 << " ms (x" << stdBuild / build << "), scan " << scanSec * 1e3
+			<< " ms (x" << stdScan / scanSec << "), " << arena.getSizeInBytes() / 1048576.0 << " MiB ("
+			<< arena.getUniqueCount() << " distinct runs)\n";
+	};
+	std::cout << "Vector<std::string>: build " << stdBuild * 1e3 << " ms, scan " << stdScan * 1e3 << " ms, "
+		<< stdBytes / 1048576.0 << " MiB\n";
+	run( "StringVector          ", Interning::Off );
+	run( "StringVector interned ", Interning::On );
+	doNotOptimize( checksum );
+}
+
+// routing table lookups: 1..64 reader threads against one writer republishing the table
+//	every millisecond; lookups/s summed over all readers, RcuVector vs a shared_mutex
+inline void benchRcuVector( std::size_t tableSize = 4096,
+	double secondsPerRun = 0.1 )
+{
+	std::cout << "=== RcuVector vs shared_mutex reads (" << tableSize << " entries, writer every 1 ms) ===\n";
+	auto makeTable = [tableSize]( std::uint32_t salt )
+	{
+		Vector<std::uint32_t> v{tableSize};
+		for ( std::size_t i = 0; i < tableSize; ++i )
+		{
+			v.pushBack( static_cast<std::uint32_t>( i ) ^ salt );
+		}
+		return v;
+	};
+
+	// runs `lookup` on `threads` readers while `republish` runs every ms; returns {lookups/s, publishes}
+	auto measure = [secondsPerRun]( unsigned threads, auto&& lookup, auto&& republish )
+	{
+		std::atomic<bool> stop{false};
+		std::atomic<std::uint64_t> total{0};
+		std::vector<std::thread> readers;
+		for ( unsigned r = 0; r < threads; ++r )
+		{
+			readers.emplace_back( [&, r]
+				{
+					std::uint64_t ops = 0;
+					std::uint64_t sum = 0;
+					std::uint32_t key = r * 2654435761u;
+					while ( !stop.load( std::memory_order_relaxed ) )
+					{
+						for ( int i = 0; i < 64; ++i, ++ops )
+						{
+							key = key * 1664525u + 1013904223u;
+							sum += lookup( key );
+						}
+					}
+					doNotOptimize( sum );
+					total += ops;
+				} );
+		}
+		// a reader preferring lock can starve the writer, so it gets its own thread
+		std::uint32_t publishes = 0;
+		std::thread writer{[&]
+			{
+				while ( !stop.load( std::memory_order_relaxed ) )
+				{
+					republish( ++publishes );
+					std::this_thread::sleep_for( std::chrono::milliseconds{1} );
+				}
+			}};
+		Timer t;
+		std::this_thread::sleep_for( std::chrono::duration<double>{secondsPerRun} );
+		stop = true;
+		for ( std::thread& th : readers )
+		{
+			th.join();
+		}
+		const double sec = t.elapsedSec();
+		writer.join();
+		return std::pair{total / sec, publishes};
+	};
+
+	for ( unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u} )
+	{
+		RcuVector<std::uint32_t> rcuTable{makeTable( 0 )};
+		const auto [rcuOps, rcuPublishes] = measure( threads,
+			[&rcuTable]( std::uint32_t key )
+			{
+				const auto snapshot = rcuTable.read();
+				return snapshot[key % snapshot.getSize()];
+			},
+			[&]( std::uint32_t salt )
+			{
+				rcuTable.assign( makeTable( salt ) );
+			} );
+
+		Vector<std::uint32_t> lockedTable{makeTable( 0 )};
+		std::shared_mutex mutex;
+		const auto [lockOps, lockPublishes] = measure( threads,
+			[&lockedTable, &mutex]( std::uint32_t key )
+			{
+				std::shared_lock<std::shared_mutex> lock{mutex};
+				return lockedTable[key % lockedTable.getSize()];
+			},
+			[&]( std::uint32_t salt )
+			{
+				Vector<std::uint32_t> next = makeTable( salt );
+				std::unique_lock<std::shared_mutex> lock{mutex};
+				lockedTable.swap( next );
+			} );
+
+		std::cout << threads << " readers: RcuVector " << rcuOps / 1e6 << " Mlookups/s (" << rcuPublishes
+			<< " publishes), shared_mutex " << lockOps / 1e6 << " Mlookups/s (" << lockPublishes << " publishes), x"
+			<< rcuOps / lockOps << std::endl;
+	}
+}
+
+// per push latency of n pushBacks starting from 64 elements: Vector's doubling vs
+//	IncrementalVector's amortized migration; latencies are binned per ns up to 4 us
+//	and per power of 2 above that
+inline void benchIncrementalGrowth( std::size_t n = 1ull << 25 )
+{
+	std::cout << "=== push latency, doubling vs incremental growth (" << n << " uint64 pushes) ===\n";
+	constexpr std::size_t linearBins = 4096;
+	auto measure = [n]( auto& v )
+	{
+		Vector<std::uint64_t> bins{linearBins + 64, 0};
+		std::uint64_t worst = 0;
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			const auto start = std::chrono::steady_clock::now();
+			v.pushBack( i );
+			const std::uint64_t ns = static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count() );
+			++bins[ns < linearBins ? ns : linearBins + std::bit_width( ns )];
+			worst = std::max( worst, ns );
+		}
+		auto percentile = [&bins, n]( double p )
+		{
+			const std::uint64_t rank = static_cast<std::uint64_t>( p * n );
+			std::uint64_t seen = 0;
+			for ( std::size_t b = 0; b < bins.getSize(); ++b )
+			{
+				seen += bins[b];
+				if ( seen > rank )
+				{
+					return b < linearBins ?
+						std::uint64_t{b} :
+						std::uint64_t{1} << ( b - linearBins );
+				}
+			}
+			return std::uint64_t{0};
+		};
+		std::cout << "p50 " << percentile( 0.5 ) << " ns, p99 " << percentile( 0.99 ) << " ns, p999 "
+			<< percentile( 0.999 ) << " ns, max " << worst / 1e6 << " ms\n";
+	};
+	{
+		Vector<std::uint64_t> v;
+		std::cout << "Vector            : ";
+		measure( v );
+	}
+	{
+		IncrementalVector<std::uint64_t> v;
+		std::cout << "IncrementalVector : ";
+		measure( v );
+	}
+}
+
+// feature vectors of n floats at decreasing density: memory, conversion and dot products of the
+//	dense Vector vs SparseVector, plus the sparse . sparse intersection (SIMD vs scalar merge)
+inline void benchSparseVector( std::size_t n = 1ull << 24 )
+{
+	std::cout << "=== SparseVector vs dense Vector<float> (" << n << " elements) ===\n";
+	std::mt19937_64 rng{17};
+	Vector<float> weights{n, 0.0f};
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		weights[i] = static_cast<float>( rng() % 1000 ) * 1e-3f;
+	}
+	for ( double density : {0.1, 0.01, 0.001} )
+	{
+		Vector<float> features{n, 0.0f};
+		Vector<float> other{n, 0.0f};
+		const std::uint64_t threshold = static_cast<std::uint64_t>( density * 1e6 );
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			if ( rng() % 1000000 < threshold )
+			{
+				features[i] = 1.0f;
+			}
+			if ( rng() % 1000000 < threshold )
+			{
+				other[i] = 2.0f;
+			}
+		}
+
+		Timer t;
+		const auto sparse = SparseVector<float>::fromDense( features );
+		const double convertMs = t.elapsedSec() * 1e3;
+		const auto sparseOther = SparseVector<float>::fromDense( other );
+
+		float checksum = 0;
+		t = Timer{};
+		float denseDot = 0;
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			denseDot += features[i] * weights[i];
+		}
+		checksum += denseDot;
+		const double denseSec = t.elapsedSec();
+		t = Timer{};
+		checksum += sparse.dot( weights );
+		const double sparseSec = t.elapsedSec();
+
+		t = Timer{};
+		checksum += sparse.dot( sparseOther );
+		const double simdSec = t.elapsedSec();
+		t = Timer{};
+		float scalarDot = 0;
+		const auto values = sparse.values();
+		const auto otherValues = sparseOther.values();
+		sparse::intersectScalar( sparse.indices().data(), sparse.getNonZeroCount(), sparseOther.indices().data(), sparseOther.getNonZeroCount(),
+			[&]( std::size_t i, std::size_t j )
+			{
+				scalarDot += values[i] * otherValues[j];
+			} );
+		checksum += scalarDot;
+		const double scalarSec = t.elapsedSec();
+		doNotOptimize( checksum );
+
+		std::cout << "density " << density * 100 << "%: " << sparse.getNonZeroCount() << " nnz, " << n * sizeof( float ) / 1048576.0
+			<< " MiB dense vs " << sparse.getSizeInBytes() / 1048576.0 << " MiB sparse, fromDense " << convertMs
+			<< " ms, dot: dense " << denseSec * 1e3 << " ms, sparse.dense " << sparseSec * 1e3 << " ms (x" << denseSec / sparseSec
+			<< "), sparse.sparse " << simdSec * 1e3 << " ms (scalar merge " << scalarSec * 1e3 << " ms)\n";
+	}
+}
+
+// layout vs throughput on n x n doubles: column sums (walking across the contiguous
+//	dimension or along it), transposes (naive, cache oblivious, tiled storage) and a
+//	matrix multiply (naive i-j-k vs the blocked kernel)
+inline void benchMdVector( std::size_t n = 2048,
+	std::size_t matmulN = 512 )
+{
+	std::cout << "=== MdVector layouts (" << n << " x " << n << " doubles) ===\n";
+	auto gbPerSec = [n]( double sec, double passes )
+	{
+		return passes * n * n * sizeof( double ) / sec / 1e9;
+	};
+	MdVector<double, 2> rowMajor{{n, n}};
+	MdVector<double, 2, md::ColumnMajor<2>> columnMajor{{n, n}};
+	MdVector<double, 2, md::Tiled<32>> tiled{{n, n}};
+	for ( std::size_t r = 0; r < n; ++r )
+	{
+		for ( std::size_t c = 0; c < n; ++c )
+		{
+			rowMajor( r, c ) = columnMajor( r, c ) = tiled( r, c ) = static_cast<double>( r ^ c );
+		}
+	}
+
+	Vector<double> sums{n, 0.0};
+	auto columnSums = [&sums, n]( const auto& view )
+	{
+		for ( std::size_t c = 0; c < n; ++c )
+		{
+			double s = 0;
+			for ( std::size_t r = 0; r < n; ++r )
+			{
+				s += view( r, c );
+			}
+			sums[c] = s;
+		}
+	};
+	Timer t;
+	columnSums( rowMajor.view() );
+	const double stridedSec = t.elapsedSec();
+	t = Timer{};
+	columnSums( columnMajor.view() );
+	const double contiguousSec = t.elapsedSec();
+	doNotOptimize( sums[n / 2] );
+	std::cout << "column sums: row-major (strided) " << gbPerSec( stridedSec, 1 ) << " GB/s, column-major (contiguous) "
+		<< gbPerSec( contiguousSec, 1 ) << " GB/s\n";
+
+	MdVector<double, 2> rowMajorT{{n, n}};
+	t = Timer{};
+	{
+		const auto src = rowMajor.view();
+		const auto dst = rowMajorT.view();
+		for ( std::size_t r = 0; r < n; ++r )
+		{
+			for ( std::size_t c = 0; c < n; ++c )
+			{
+				dst( c, r ) = src( r, c );
+			}
+		}
+	}
+	const double naiveSec = t.elapsedSec();
+	t = Timer{};
+	md::transpose( rowMajor.view(), rowMajorT.view() );
+	const double obliviousSec = t.elapsedSec();
+	MdVector<double, 2, md::Tiled<32>> tiledT{{n, n}};
+	t = Timer{};
+	md::transpose( tiled.view(), tiledT.view() );
+	const double tiledSec = t.elapsedSec();
+	doNotOptimize( rowMajorT( 1, 2 ) + tiledT( 2, 1 ) );
+	std::cout << "transpose: naive " << gbPerSec( naiveSec, 2 ) << " GB/s, cache oblivious " << gbPerSec( obliviousSec, 2 )
+		<< " GB/s, tiled<32> storage " << gbPerSec( tiledSec, 2 ) << " GB/s\n";
+
+	const std::size_t m = matmulN;
+	MdVector<double, 2> a{{m, m}};
+	MdVector<double, 2> b{{m, m}};
+	for ( std::size_t i = 0; i < m; ++i )
+	{
+		for ( std::size_t j = 0; j < m; ++j )
+		{
+			a( i, j ) = static_cast<double>( ( i + j ) % 7 );
+			b( i, j ) = static_cast<double>( ( i * j ) % 5 );
+		}
+	}
+	auto gflops = [m]( double sec )
+	{
+		return 2.0 * m * m * m / sec / 1e9;
+	};
+	MdVector<double, 2> c{{m, m}};
+	t = Timer{};
+	{
+		const auto av = a.view();
+		const auto bv = b.view();
+		const auto cv = c.view();
+		for ( std::size_t i = 0; i < m; ++i )
+		{
+			for ( std::size_t j = 0; j < m; ++j )
+			{
+				double s = 0;
+				for ( std::size_t k = 0; k < m; ++k )
+				{
+					s += av( i, k ) * bv( k, j );
+				}
+				cv( i, j ) = s;
+			}
+		}
+	}
+	const double naiveMulSec = t.elapsedSec();
+	MdVector<double, 2> blocked{{m, m}};
+	t = Timer{};
+	md::multiply( a.view(), b.view(), blocked.view() );
+	const double blockedMulSec = t.elapsedSec();
+	doNotOptimize( c( 3, 4 ) + blocked( 4, 3 ) );
+	std::cout << "multiply " << m << "^3: naive i-j-k " << gflops( naiveMulSec ) << " GFLOP/s, blocked " << gflops( blockedMulSec )
+		<< " GFLOP/s (x" << naiveMulSec / blockedMulSec << ")\n";
+}
+
+// the lifecycle paths for a trivial int vs an int wrapper with user provided copy & destructor
+//	(same bytes, general tier): the trivial ones should match memcpy or cost nothing
+inline void benchLifecycleTiers( std::size_t n = 1ull << 24 )
+{
+	struct Wrapped
+	{
+		int value;
+
+		Wrapped( int v ) noexcept
+			:
+			value{v}
+		{
+
+		}
+		Wrapped( const Wrapped& rhs ) noexcept
+			:
+			value{rhs.value}
+		{
+
+		}
+		Wrapped& operator=( const Wrapped& rhs ) noexcept
+		{
+			value = rhs.value;
+			return *this;
+		}
+		~Wrapped() noexcept
+		{
+			doNotOptimize( value );
+		}
+	};
+	std::cout << "=== lifecycle tiers (" << n << " x 4 byte elements, ms) ===\n";
+
+	Vector<int> src{n};
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		src.pushBack( static_cast<int>( i ) );
+	}
+	// into a fresh buffer, page faults included like for the copies below
+	Timer t;
+	std::unique_ptr<int[]> dst{new int[n]};
+	std::memcpy( dst.get(), src.data(), n * sizeof( int ) );
+	const double memcpyMs = t.elapsedSec() * 1e3;
+	doNotOptimize( dst[n / 3] );
+
+	auto run = [n]( const char* label, auto& v )
+	{
+		using V = std::remove_reference_t<decltype( v )>;
+		Timer timer;
+		V copy{v};
+		const double copyMs = timer.elapsedSec() * 1e3;
+		V target{n + 1, v[0]};
+		timer = Timer{};
+		target = v;
+		const double assignMs = timer.elapsedSec() * 1e3;
+		timer = Timer{};
+		copy.clear();
+		const double clearMs = timer.elapsedSec() * 1e3;
+		timer = Timer{};
+		V grown{n};
+		grown.append( v.data(), v.data() + n );
+		grown.reserve( 2 * n );
+		const double growMs = timer.elapsedSec() * 1e3;
+		doNotOptimize( target[n / 2] );
+		std::cout << label << "copy ctor " << copyMs << ", copy assign " << assignMs << ", clear " << clearMs
+			<< ", append + regrow " << growMs << "\n";
+	};
+	std::cout << "memcpy reference " << memcpyMs << "\n";
+	run( "int (trivial)     : ", src );
+	Vector<Wrapped> wrapped{n};
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		wrapped.pushBack( Wrapped{static_cast<int>( i )} );
+	}
+	run( "Wrapped (general) : ", wrapped );
+}
+
+// hash based dedup / groupBy / intersection vs the sort based way, over 1..hardware threads
+inline void benchHashedOps( std::size_t n = 1ull << 23,
+	std::uint64_t distinct = 1ull << 20 )
+{
+	std::cout << "=== hashed dedup / groupBy / set ops (" << n << " keys, " << distinct << " distinct, ms) ===\n";
+	std::mt19937_64 rng{42};
+	Vector<std::uint64_t> keys{n};
+	Vector<std::uint64_t> other{n};
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		keys.pushBack( rng() % distinct * 0x9e3779b97f4a7c15ull );
+		other.pushBack( rng() % ( 2 * distinct ) * 0x9e3779b97f4a7c15ull );
+	}
+	auto group = []( std::uint64_t x )
+	{
+		return static_cast<std::uint32_t>( x >> 52 );
+	};
+
+	Timer t;
+	std::vector<std::uint64_t> sorted( keys.cbegin(), keys.cend() );
+	std::sort( sorted.begin(), sorted.end() );
+	sorted.erase( std::unique( sorted.begin(), sorted.end() ), sorted.end() );
+	const double sortUniqueMs = t.elapsedSec() * 1e3;
+	t = Timer{};
+	std::vector<std::uint64_t> byGroup( keys.cbegin(), keys.cend() );
+	std::stable_sort( byGroup.begin(), byGroup.end(), [&group]( std::uint64_t a, std::uint64_t b )
+		{
+			return group( a ) < group( b );
+		} );
+	const double stableSortMs = t.elapsedSec() * 1e3;
+	t = Timer{};
+	std::vector<std::uint64_t> sortedOther( other.cbegin(), other.cend() );
+	std::sort( sortedOther.begin(), sortedOther.end() );
+	sortedOther.erase( std::unique( sortedOther.begin(), sortedOther.end() ), sortedOther.end() );
+	std::vector<std::uint64_t> common;
+	std::set_intersection( sorted.begin(), sorted.end(), sortedOther.begin(), sortedOther.end(), std::back_inserter( common ) );
+	const double sortIntersectMs = sortUniqueMs + t.elapsedSec() * 1e3;
+	std::cout << "sort: sort+unique " << sortUniqueMs << ", stable_sort by group " << stableSortMs
+		<< ", sort+set_intersection " << sortIntersectMs << "\n";
+
+	const unsigned hw = std::max( 1u, std::thread::hardware_concurrency() );
+	for ( unsigned threads = 1; threads <= hw; threads *= 2 )
+	{
+		parallel::ThreadPool pool{threads - 1};
+		t = Timer{};
+		const std::size_t count = hashed::countDistinct( keys, pool );
+		const double countMs = t.elapsedSec() * 1e3;
+		t = Timer{};
+		const Vector<std::uint64_t> any = hashed::dedup( keys, hashed::Order::Any, pool );
+		const double anyMs = t.elapsedSec() * 1e3;
+		t = Timer{};
+		const Vector<std::uint64_t> firstSeen = hashed::dedup( keys, hashed::Order::FirstSeen, pool );
+		const double firstSeenMs = t.elapsedSec() * 1e3;
+		t = Timer{};
+		const auto groups = hashed::groupBy( keys, group, hashed::Order::Any, pool );
+		const double groupMs = t.elapsedSec() * 1e3;
+		t = Timer{};
+		const Vector<std::uint64_t> both = hashed::setIntersection( keys, other, hashed::Order::Any, pool );
+		const double intersectMs = t.elapsedSec() * 1e3;
+		if ( count != sorted.size() || any.getSize() != sorted.size() || firstSeen.getSize() != sorted.size()
+			|| groups[0].size() + groups[groups.getCount() - 1].size() == 0 || both.getSize() != common.size() )
+		{
+			std::cout << "mismatch!\n";
+		}
+		std::cout << threads << " thread(s): countDistinct " << countMs << " (x" << sortUniqueMs / countMs << "), dedup "
+			<< anyMs << " (x" << sortUniqueMs / anyMs << "), dedup first seen " << firstSeenMs << " (x" << sortUniqueMs / firstSeenMs
+			<< "), groupBy " << groupMs << " (x" << stableSortMs / groupMs << "), intersection " << intersectMs << " (x"
+			<< sortIntersectMs / intersectMs << ")\n";
+	}
+}
+
+
+// compress / selectIf over a selectivity sweep, then gather & scatter with random indices
+//	into sources from L1 to DRAM size; ms per pass over n 4 byte elements
+inline void benchSelection( std::size_t n = 1ull << 24 )
+{
+	std::cout << "=== selection kernels (" << n << " ints, ms) ===\n";
+	std::mt19937 rng{7};
+	Vector<int> column{n};
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		column.pushBack( static_cast<int>( rng() % 1000 ) );
+	}
+	Vector<int> out{n, 0};
+	Vector<std::uint8_t> mask{n, 0};
+	const std::span<const int> in = column.asSpan();
+
+	for ( int percent : {0, 1, 10, 25, 50, 75, 90, 99, 100} )
+	{
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			mask[i] = column[i] < percent * 10;
+		}
+		Timer t;
+		std::size_t k = 0;
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			if ( mask[i] )
+			{
+				out[k++] = column[i];
+			}
+		}
+		const double branchyMs = t.elapsedSec() * 1e3;
+		doNotOptimize( k );
+		t = Timer{};
+		doNotOptimize( selection::compressScalar( in, mask.asSpan(), out.asSpan() ) );
+		const double scalarMs = t.elapsedSec() * 1e3;
+		t = Timer{};
+		doNotOptimize( selection::compress( in, mask.asSpan(), out.asSpan() ) );
+		const double compressMs = t.elapsedSec() * 1e3;
+		const int threshold = percent * 10;
+		t = Timer{};
+		doNotOptimize( selection::selectIf( in, out.asSpan(), [threshold]( int x ) { return x < threshold; } ) );
+		const double selectMs = t.elapsedSec() * 1e3;
+		std::cout << percent << "% selected: branchy " << branchyMs << ", branchless " << scalarMs << ", compress "
+			<< compressMs << " (x" << branchyMs / compressMs << "), selectIf " << selectMs << "\n";
+	}
+
+	Vector<std::uint32_t> idx{n, 0};
+	for ( std::size_t sourceInts : {std::size_t{4} << 10, std::size_t{256} << 10, std::size_t{64} << 20} )
+	{
+		Vector<int> source{sourceInts, 1};
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			idx[i] = static_cast<std::uint32_t>( rng() % sourceInts );
+		}
+		const std::span<const std::uint32_t> indices = idx.asSpan();
+		Timer t;
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			out[i] = source[idx[i]];
+		}
+		const double plainMs = t.elapsedSec() * 1e3;
+		doNotOptimize( out[n / 2] );
+		t = Timer{};
+		selection::gatherScalar( std::span<const int>{source.asSpan()}, indices, out.asSpan() );
+		const double scalarMs = t.elapsedSec() * 1e3;
+		t = Timer{};
+		selection::gather( std::span<const int>{source.asSpan()}, indices, out.asSpan() );
+		const double gatherMs = t.elapsedSec() * 1e3;
+		t = Timer{};
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			source[idx[i]] = out[i];
+		}
+		const double plainScatterMs = t.elapsedSec() * 1e3;
+		t = Timer{};
+		selection::scatter( std::span<const int>{out.asSpan()}, indices, source.asSpan() );
+		const double scatterMs = t.elapsedSec() * 1e3;
+		doNotOptimize( source[sourceInts / 2] );
+		std::cout << ( sourceInts * sizeof( int ) >> 10 ) << " KiB source: gather plain " << plainMs << ", scalar "
+			<< scalarMs << ", vector " << gatherMs << " (x" << plainMs / gatherMs << "); scatter plain " << plainScatterMs
+			<< ", vector " << scatterMs << " (x" << plainScatterMs / scatterMs << ")\n";
+	}
+}
+
+
+// benchAsyncChannel's coroutines: producers push `count` values, stamped with the clock if timed
+inline coro::Task<> benchProduce( coro::Channel<std::uint64_t>& channel,
+	std::size_t count,
+	bool timed,
+	std::atomic<int>& producersLeft )
+{
+	auto producer = channel.makeProducer();
+	for ( std::size_t i = 0; i < count; ++i )
+	{
+		co_await producer.push( timed ?
+			static_cast<std::uint64_t>( std::chrono::steady_clock::now().time_since_epoch().count() ) :
+			i );
+	}
+	co_await producer.flush();
+	if ( --producersLeft == 0 )
+	{
+		channel.close();
+	}
+}
+
+// sums everything, or collects the age of every batch's newest element on arrival (ns) if timed
+inline coro::Task<> benchConsume( coro::Channel<std::uint64_t>& channel,
+	bool timed,
+	std::uint64_t& sum,
+	Vector<double>& latencies,
+	std::latch& done )
+{
+	while ( std::optional<Vector<std::uint64_t>> batch = co_await channel.nextBatch() )
+	{
+		if ( timed )
+		{
+			latencies.pushBack( static_cast<double>( std::chrono::steady_clock::now().time_since_epoch().count() - batch->cback() ) );
+		}
+		sum += std::accumulate( batch->cbegin(), batch->cend(), std::uint64_t{0} );
+		channel.recycle( std::move( *batch ) );
+	}
+	done.count_down();
+}
+
+// 4 producers into 1 consumer: Channel over a RunLoop and over a pool vs locked pushBack
+//	into one Vector the consumer reads once it is complete; throughput in M elements/s,
+//	latency from a batch's last push to its consumer
+inline void benchAsyncChannel( std::size_t n = 1ull << 24 )
+{
+	constexpr int producers = 4;
+	const std::size_t perProducer = n / producers;
+	std::cout << "=== async Channel (" << producers << " producers x " << perProducer << " elements, 1 consumer) ===\n";
+
+	{
+		Timer t;
+		Vector<std::uint64_t> shared{n};
+		std::mutex mutex;
+		std::vector<std::thread> threads;
+		for ( int p = 0; p < producers; ++p )
+		{
+			threads.emplace_back( [&, perProducer]
+				{
+					for ( std::size_t i = 0; i < perProducer; ++i )
+					{
+						std::lock_guard<std::mutex> lock{mutex};
+						shared.pushBack( i );
+					}
+				} );
+		}
+		for ( std::thread& th : threads )
+		{
+			th.join();
+		}
+		const double firstSeenMs = t.elapsedSec() * 1e3;
+		doNotOptimize( std::accumulate( shared.cbegin(), shared.cend(), std::uint64_t{0} ) );
+		std::cout << "locked pushBack, consume when complete: " << n / t.elapsedSec() / 1e6 << " M/s, first element seen after "
+			<< firstSeenMs << " ms\n";
+	}
+
+	parallel::ThreadPool pool{std::max( 2u, std::thread::hardware_concurrency() ) - 1};
+	coro::PoolExecutor poolExecutor{pool};
+	coro::RunLoop loop;
+	auto run = [&]( const char* label, coro::Executor& executor, std::size_t batchSize, bool timed )
+	{
+		coro::Channel<std::uint64_t> channel{executor, batchSize, 8};
+		std::atomic<int> producersLeft{producers};
+		std::uint64_t sum = 0;
+		Vector<double> latencies{n / batchSize + producers + 1};
+		std::latch done{1};
+		Timer t;
+		coro::spawn( executor, benchConsume( channel, timed, sum, latencies, done ) );
+		for ( int p = 0; p < producers; ++p )
+		{
+			coro::spawn( executor, benchProduce( channel, perProducer, timed, producersLeft ) );
+		}
+		if ( &executor == &loop )
+		{
+			loop.run();
+		}
+		done.wait();
+		const double sec = t.elapsedSec();
+		doNotOptimize( sum );
+		if ( !timed )
+		{
+			std::cout << label << " batch " << batchSize << ": " << n / sec / 1e6 << " M/s\n";
+			return;
+		}
+		std::sort( latencies.begin(), latencies.end() );
+		std::cout << label << " batch " << batchSize << ": latency p50 " << latencies[latencies.getSize() / 2] / 1e3
+			<< " us, p99 " << latencies[latencies.getSize() * 99 / 100] / 1e3 << " us\n";
+	};
+	for ( std::size_t batchSize : {64, 1024, 16384} )
+	{
+		run( "RunLoop     ", loop, batchSize, false );
+		run( "PoolExecutor", poolExecutor, batchSize, false );
+	}
+	for ( std::size_t batchSize : {64, 1024, 16384} )
+	{
+		run( "RunLoop     ", loop, batchSize, true );
+		run( "PoolExecutor", poolExecutor, batchSize, true );
+	}
+}
+
+
+// a reallocation storm: many Vectors grown from 1 element by pushBack, with & without tracing
+//	compiled in (build with KEYVECTOR_TRACING to see the hooks' cost & the recorded events)
+inline void benchTracing( std::size_t vectors = 1 << 12,
+	std::size_t elements = 1 << 14 )
+{
+#ifdef KEYVECTOR_TRACING
+	std::cout << "=== Vector tracing (compiled in) ===\n";
+	tracing::reset();
+#else
+	std::cout << "=== Vector tracing (compiled out, define KEYVECTOR_TRACING) ===\n";
+#endif
+	Timer t;
+	std::size_t reallocations = 0;
+	for ( std::size_t v = 0; v < vectors; ++v )
+	{
+		Vector<std::uint32_t> grown{1};
+		for ( std::size_t i = 0; i < elements; ++i )
+		{
+			reallocations += grown.getSize() == grown.getCapacity();
+			grown.pushBack( static_cast<std::uint32_t>( i ) );
+		}
+		doNotOptimize( grown.data() );
+	}
+	const double sec = t.elapsedSec();
+	std::cout << vectors << " x " << elements << " pushBacks: " << sec * 1e3 << " ms, "
+		<< sec * 1e9 / reallocations << " ns per reallocation (" << reallocations << ")\n";
+#ifdef KEYVECTOR_TRACING
+	Vector<tracing::Event> events{tracing::ringSize};
+	tracing::snapshot( events );
+	std::size_t storms = 0;
+	tracing::findStorms( events.data(), events.getSize(), 1'000'000, 8, [&storms]( const tracing::Storm& )
+		{
+			++storms;
+		} );
+	std::cout << tracing::getRecordedCount() << " events recorded, the last " << events.getSize()
+		<< " kept, " << storms << " storms of >= 8 within 1 ms\n";
+#endif
+}
+
+
+inline void runBenchmarks()
+{
+	benchCompressedVector();
+	benchStreamingCopy();
+	benchNumaPlacement();
+	benchBufferCache();
+	benchContiguousAlgorithms();
+	benchTextFormatting();
+	benchSlotMap();
+	benchErase();
+	benchParallelAlgorithms();
+	benchDeltaReplication();
+	benchSearchIndex();
+	benchStringVector();
+	benchRcuVector();
+	benchIncrementalGrowth();
+	benchSparseVector();
+	benchMdVector();
+	benchLifecycleTiers();
+	benchHashedOps();
+	benchSelection();
+	benchAsyncChannel();
+	benchTracing();
+}
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+
+// per size class retention budget of every thread's cache, in bytes
+#ifndef KEYVECTOR_BUFFER_CACHE_BUDGET
+#	define KEYVECTOR_BUFFER_CACHE_BUDGET ( 1ull << 20 )
+#endif
+
+
+struct BufferCacheStats
+{
+	std::uint64_t hits;			// allocations served from the free lists
+	std::uint64_t misses;		// allocations that went to the global heap
+	std::uint64_t frees;		// buffers returned by the owning thread
+	std::uint64_t remoteFrees;	// buffers returned by other threads (collected by the owner)
+	std::uint64_t evictions;	// returned buffers released to the heap because the class was full
+	std::uint64_t bypassed;		// requests too large to be cached
+};
+
+//============================================================
+//	\class	ThreadBufferCache
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 17:10
+//
+//	\brief	per thread free lists of buffers in power of 2 size classes (64B .. 1MB)
+//			every buffer carries a 16 byte header naming its owning cache & class
+//			frees on the owning thread push onto its local list (bounded by
+//				KEYVECTOR_BUFFER_CACHE_BUDGET per class, the rest goes back to the heap)
+//			frees on any other thread push onto the owner's lock-free remote list,
+//				which the owner drains on its next miss
+//			when a thread exits its cache is retired; buffers still alive elsewhere
+//				are released to the heap as they come back and the last one deletes the cache
+//=============================================================
+class ThreadBufferCache final
+{
+public:
+	static constexpr std::size_t minClassBytes = 64;
+	static constexpr std::size_t nClasses = 15;	// 64B << 14 = 1MB
+	static constexpr std::size_t maxClassBytes = minClassBytes << ( nClasses - 1 );
+private:
+	struct alignas( 16 ) Header
+	{
+		ThreadBufferCache* owner;	// nullptr: uncached (too large)
+		std::size_t sizeClass;
+	};
+	struct Node
+	{
+		Node* next;
+	};
+
+	static inline Node* const retiredMark = reinterpret_cast<Node*>( std::uintptr_t{1} );
+
+	Node* m_free[nClasses];
+	std::size_t m_count[nClasses];
+	std::size_t m_outstanding;			// buffers of this cache currently handed out (owner thread only)
+	BufferCacheStats m_stats;
+	std::atomic<Node*> m_remote;		// MPSC stack of buffers freed by other threads
+	std::atomic<std::int64_t> m_orphans;// outstanding buffers after retirement
+
+	ThreadBufferCache() noexcept
+		:
+		m_free{},
+		m_count{},
+		m_outstanding{0},
+		m_stats{},
+		m_remote{nullptr},
+		m_orphans{0}
+	{
+
+	}
+
+	static constexpr std::size_t classBytes( std::size_t c ) noexcept
+	{
+		return minClassBytes << c;
+	}
+
+	static constexpr std::size_t classOf( std::size_t bytes ) noexcept
+	{
+		std::size_t c = 0;
+		while ( classBytes( c ) < bytes )
+		{
+			++c;
+		}
+		return c;
+	}
+
+	static constexpr std::size_t retentionLimit( std::size_t c ) noexcept
+	{
+		const std::size_t n = KEYVECTOR_BUFFER_CACHE_BUDGET / classBytes( c );
+		return n < 2 ?
+			2 :
+			n;
+	}
+
+	static Header* headerOf( void* p ) noexcept
+	{
+		return static_cast<Header*>( p ) - 1;
+	}
+
+	static void* heapAllocate( ThreadBufferCache* owner,
+		std::size_t sizeClass,
+		std::size_t bytes )
+	{
+		Header* h = static_cast<Header*>( ::operator new( sizeof( Header ) + bytes ) );
+		h->owner = owner;
+		h->sizeClass = sizeClass;
+		return h + 1;
+	}
+
+	static void heapFree( void* p ) noexcept
+	{
+		::operator delete( headerOf( p ) );
+	}
+
+	// keep or evict a buffer that came back to its owner
+	void recycle( void* p,
+		std::size_t c ) noexcept
+	{
+		if ( m_count[c] < retentionLimit( c ) )
+		{
+			Node* n = static_cast<Node*>( p );
+			n->next = m_free[c];
+			m_free[c] = n;
+			++m_count[c];
+		}
+		else
+		{
+			++m_stats.evictions;
+			heapFree( p );
+		}
+	}
+
+	void drainRemote() noexcept
+	{
+		Node* n = m_remote.exchange( nullptr, std::memory_order_acquire );
+		while ( n )
+		{
+			Node* next = n->next;
+			--m_outstanding;
+			++m_stats.remoteFrees;
+			recycle( n, headerOf( n )->sizeClass );
+			n = next;
+		}
+	}
+
+	void* allocateImpl( std::size_t bytes )
+	{
+		const std::size_t c = classOf( bytes );
+		if ( !m_free[c] && m_remote.load( std::memory_order_relaxed ) )
+		{
+			drainRemote();
+		}
+		void* p;
+		if ( m_free[c] )
+		{
+			Node* n = m_free[c];
+			m_free[c] = n->next;
+			--m_count[c];
+			++m_stats.hits;
+			p = n;
+		}
+		else
+		{
+			++m_stats.misses;
+			p = heapAllocate( this, c, classBytes( c ) );
+		}
+		++m_outstanding;
+		return p;
+	}
+
+	void deallocateLocal( void* p ) noexcept
+	{
+		--m_outstanding;
+		++m_stats.frees;
+		recycle( p, headerOf( p )->sizeClass );
+	}
+
+	// called from a thread that doesn't own p
+	void deallocateRemote( void* p ) noexcept
+	{
+		Node* n = static_cast<Node*>( p );
+		Node* head = m_remote.load( std::memory_order_relaxed );
+		do
+		{
+			if ( head == retiredMark )
+			{
+				heapFree( p );
+				if ( m_orphans.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+				{
+					delete this;
+				}
+				return;
+			}
+			n->next = head;
+		} while ( !m_remote.compare_exchange_weak( head, n, std::memory_order_release, std::memory_order_relaxed ) );
+	}
+
+	// owning thread exits
+	void retire() noexcept
+	{
+		Node* n = m_remote.exchange( retiredMark, std::memory_order_acq_rel );
+		while ( n )
+		{
+			Node* next = n->next;
+			--m_outstanding;
+			heapFree( n );
+			n = next;
+		}
+		for ( std::size_t c = 0; c < nClasses; ++c )
+		{
+			while ( m_free[c] )
+			{
+				Node* next = m_free[c]->next;
+				heapFree( m_free[c] );
+				m_free[c] = next;
+			}
+		}
+		// once published, remote frees may delete the cache - don't touch members past this point
+		const std::int64_t outstanding = static_cast<std::int64_t>( m_outstanding );
+		if ( m_orphans.fetch_add( outstanding, std::memory_order_acq_rel ) + outstanding == 0 )
+		{
+			delete this;
+		}
+	}
+
+	// raw (trivially destructible) thread locals stay usable while other
+	//	thread_local/static destructors run after the cache has been retired
+	static inline thread_local ThreadBufferCache* t_cache = nullptr;
+	static inline thread_local bool t_retired = false;
+
+	struct ExitHook
+	{
+		~ExitHook()
+		{
+			t_cache->retire();
+			t_cache = nullptr;
+			t_retired = true;
+		}
+	};
+
+	// nullptr once the calling thread is shutting down
+	static ThreadBufferCache* local()
+	{
+		if ( !t_cache && !t_retired )
+		{
+			t_cache = new ThreadBufferCache;
+			thread_local ExitHook hook;
+		}
+		return t_cache;
+	}
+public:
+	ThreadBufferCache( const ThreadBufferCache& rhs ) = delete;
+	ThreadBufferCache& operator=( const ThreadBufferCache& rhs ) = delete;
+
+	// 16 byte aligned buffer of at least `bytes` bytes
+	static void* allocate( std::size_t bytes )
+	{
+		ThreadBufferCache* self = local();
+		if ( bytes > maxClassBytes || !self )
+		{
+			if ( self )
+			{
+				++self->m_stats.bypassed;
+			}
+			return heapAllocate( nullptr, nClasses, bytes );
+		}
+		return self->allocateImpl( bytes );
+	}
+
+	static void deallocate( void* p ) noexcept
+	{
+		if ( !p )
+		{
+			return;
+		}
+		ThreadBufferCache* owner = headerOf( p )->owner;
+		if ( !owner )
+		{
+			heapFree( p );
+			return;
+		}
+		if ( owner == local() )
+		{
+			owner->deallocateLocal( p );
+		}
+		else
+		{
+			owner->deallocateRemote( p );
+		}
+	}
+
+	// statistics of the calling thread's cache
+	static BufferCacheStats stats()
+	{
+		ThreadBufferCache* self = local();
+		return self ?
+			self->m_stats :
+			BufferCacheStats{};
+	}
+};
+
+
+//============================================================
+//	\class	CachingAllocator<T>
+//	\brief	stateless allocator over the calling thread's ThreadBufferCache
+//			usage: Vector<int, CachingAllocator<int>>
+//=============================================================
+template<typename T>
+class CachingAllocator
+{
+public:
+	using value_type = T;
+
+	CachingAllocator() noexcept = default;
+	template<typename U>
+	CachingAllocator( const CachingAllocator<U>& ) noexcept
+	{
+
+	}
+
+	T* allocate( std::size_t n )
+	{
+		if constexpr ( alignof( T ) > 16 )
+		{
+			return std::allocator<T>{}.allocate( n );
+		}
+		else
+		{
+			return static_cast<T*>( ThreadBufferCache::allocate( n * sizeof( T ) ) );
+		}
+	}
+
+	void deallocate( T* p,
+		std::size_t n ) noexcept
+	{
+		if constexpr ( alignof( T ) > 16 )
+		{
+			std::allocator<T>{}.deallocate( p, n );
+		}
+		else
+		{
+			ThreadBufferCache::deallocate( p );
+		}
+	}
+
+	template<typename U>
+	bool operator==( const CachingAllocator<U>& ) const noexcept
+	{
+		return true;
+	}
+};
@@ -0,0 +1,474 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+#include <span>
+#include <bit>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include "custom_exception.h"
+#include "relocation.h"
+
+
+//============================================================
+//	\class	CircularVector<T, Alloc>
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 15:20
+//
+//	\brief	ring buffer on a single contiguous power of 2 sized buffer
+//			logical index i lives at physical slot ( m_head + i ) & ( m_capacity - 1 )
+//			push/pop are O(1) at both ends; growth unwraps the (at most) two
+//				live segments into the front of a buffer twice as big
+//			linearize() makes the live elements contiguous in place of a copy
+//=============================================================
+template<class T, class Alloc = std::allocator<T>>
+class CircularVector
+{
+	using AllocTraits = std::allocator_traits<Alloc>;
+
+	Alloc m_alloc;
+	std::size_t m_head;
+	std::size_t m_size;
+	std::size_t m_capacity;
+	T* m_pData;
+public:
+	using value_type = typename AllocTraits::value_type;
+	using size_type = typename AllocTraits::size_type;
+	using difference_type = typename AllocTraits::difference_type;
+	using reference = T&;
+	using const_reference = const T&;
+	using allocator_type = Alloc;
+private:
+	std::size_t physical( std::size_t i ) const noexcept
+	{
+		return ( m_head + i ) & ( m_capacity - 1 );
+	}
+
+	// relocates the live elements to the front of pNew (newCapacity slots) & adopts it with m_head = 0
+	//	if an element's copy throws, the ring is untouched & the caller still owns pNew
+	void adoptUnwrapped( T* pNew,
+		std::size_t newCapacity )
+	{
+		const std::size_t first = std::min( m_size, m_capacity - m_head );
+		relocation::construct( pNew, m_pData + m_head, first );
+#ifdef KEYVECTOR_EXCEPTIONS
+		try
+		{
+			relocation::construct( pNew + first, m_pData, m_size - first );
+		}
+		catch ( ... )
+		{
+			relocation::destroy( pNew, first );
+			throw;
+		}
+#else
+		relocation::construct( pNew + first, m_pData, m_size - first );
+#endif
+		relocation::destroy( m_pData + m_head, first );
+		relocation::destroy( m_pData, m_size - first );
+		if ( m_pData )
+		{
+			AllocTraits::deallocate( m_alloc, m_pData, m_capacity );
+		}
+		m_pData = pNew;
+		m_capacity = newCapacity;
+		m_head = 0;
+	}
+
+	// reallocates into a buffer of `newCapacity` (a power of 2 >= m_size) with m_head = 0
+	void unwrapInto( std::size_t newCapacity )
+	{
+		T* pNew = AllocTraits::allocate( m_alloc, newCapacity );
+#ifdef KEYVECTOR_EXCEPTIONS
+		try
+		{
+			adoptUnwrapped( pNew, newCapacity );
+		}
+		catch ( ... )
+		{
+			AllocTraits::deallocate( m_alloc, pNew, newCapacity );
+			throw;
+		}
+#else
+		adoptUnwrapped( pNew, newCapacity );
+#endif
+	}
+
+	// growth of a full ring by an emplace: the new element is built in the new buffer before the
+	//	old ones move, so args may refer to them (cv.pushBack( cv.cfront() ))
+	//	it goes after the unwrapped elements, or in the last slot (the new head) for the front
+	//	a moved-from ring has no capacity (nor buffer) & grows to 1 slot
+	template<typename... TArgs>
+	T& growAndEmplace( bool atBack,
+		TArgs&&... args )
+	{
+		const std::size_t newCapacity = std::max<std::size_t>( m_capacity << 1ull, 1 );
+		const std::size_t slot = atBack ?
+			m_size :
+			newCapacity - 1;
+		T* pNew = AllocTraits::allocate( m_alloc, newCapacity );
+		T* p = nullptr;
+#ifdef KEYVECTOR_EXCEPTIONS
+		try
+		{
+#endif
+			p = ::new ( pNew + slot ) T(std::forward<TArgs>( args )...);
+			adoptUnwrapped( pNew, newCapacity );
+#ifdef KEYVECTOR_EXCEPTIONS
+		}
+		catch ( ... )
+		{
+			if ( p )
+			{
+				p->~T();
+			}
+			AllocTraits::deallocate( m_alloc, pNew, newCapacity );
+			throw;
+		}
+#endif
+		if ( !atBack )
+		{
+			m_head = slot;
+		}
+		++m_size;
+		return *p;
+	}
+public:
+	CircularVector()
+		:
+		CircularVector(64)
+	{
+
+	}
+
+	// capacity is rounded up to a power of 2
+	explicit CircularVector( std::size_t capacity )
+		:
+		m_alloc{},
+		m_head{0},
+		m_size{0},
+		m_capacity{std::bit_ceil( std::max<std::size_t>( capacity, 1 ) )},
+		m_pData{AllocTraits::allocate( m_alloc, m_capacity )}
+	{
+
+	}
+
+	~CircularVector() noexcept
+	{
+		clear();
+		if ( m_pData )
+		{
+			AllocTraits::deallocate( m_alloc, m_pData, m_capacity );
+		}
+	}
+
+	CircularVector( const CircularVector& rhs )
+		:
+		CircularVector(rhs.m_capacity)
+	{
+		for ( std::size_t i = 0; i < rhs.m_size; ++i )
+		{
+			pushBack( rhs[i] );
+		}
+	}
+
+	CircularVector& operator=( const CircularVector& rhs )
+	{
+		CircularVector temp{rhs};
+		temp.swap( *this );
+		return *this;
+	}
+
+	CircularVector( CircularVector&& rhs ) noexcept
+		:
+		m_alloc{},
+		m_head{0},
+		m_size{0},
+		m_capacity{0},
+		m_pData{nullptr}
+	{
+		rhs.swap( *this );
+	}
+
+	CircularVector& operator=( CircularVector&& rhs ) noexcept
+	{
+		CircularVector temp{std::move( rhs )};
+		temp.swap( *this );
+		return *this;
+	}
+
+	void swap( CircularVector& rhs ) noexcept
+	{
+		std::swap( m_head, rhs.m_head );
+		std::swap( m_size, rhs.m_size );
+		std::swap( m_capacity, rhs.m_capacity );
+		std::swap( m_pData, rhs.m_pData );
+	}
+
+	template<typename... TArgs>
+	T& emplaceBack( TArgs&&... args )
+	{
+		if ( m_size == m_capacity )
+		{
+			return growAndEmplace( true, std::forward<TArgs>( args )... );
+		}
+		T* p = ::new ( m_pData + physical( m_size ) ) T(std::forward<TArgs>( args )...);
+		++m_size;
+		return *p;
+	}
+	template<typename... TArgs>
+	T& emplaceFront( TArgs&&... args )
+	{
+		if ( m_size == m_capacity )
+		{
+			return growAndEmplace( false, std::forward<TArgs>( args )... );
+		}
+		const std::size_t slot = ( m_head - 1 ) & ( m_capacity - 1 );
+		T* p = ::new ( m_pData + slot ) T(std::forward<TArgs>( args )...);
+		m_head = slot;
+		++m_size;
+		return *p;
+	}
+
+	void pushBack( const T& val )
+	{
+		emplaceBack( val );
+	}
+	void pushBack( T&& val )
+	{
+		emplaceBack( std::move( val ) );
+	}
+	void pushFront( const T& val )
+	{
+		emplaceFront( val );
+	}
+	void pushFront( T&& val )
+	{
+		emplaceFront( std::move( val ) );
+	}
+
+	void popBack() noexcept
+	{
+		--m_size;
+		m_pData[physical( m_size )].~T();
+	}
+	void popFront() noexcept
+	{
+		m_pData[m_head].~T();
+		m_head = ( m_head + 1 ) & ( m_capacity - 1 );
+		--m_size;
+	}
+
+	void clear() noexcept
+	{
+		if constexpr ( !std::is_trivially_destructible_v<T> )
+		{
+			for ( std::size_t i = 0; i < m_size; ++i )
+			{
+				m_pData[physical( i )].~T();
+			}
+		}
+		m_head = 0;
+		m_size = 0;
+	}
+
+	// grows to at least newCapacity (rounded up to a power of 2), never shrinks
+	void reserve( std::size_t newCapacity )
+	{
+		if ( newCapacity > m_capacity )
+		{
+			unwrapInto( std::bit_ceil( newCapacity ) );
+		}
+	}
+
+	// makes the elements contiguous (front at the start of the buffer)
+	//	no-op if they don't wrap around; otherwise one reallocation of the same capacity
+	std::span<T> linearize()
+	{
+		if ( m_head + m_size > m_capacity )
+		{
+			unwrapInto( m_capacity );
+		}
+		return std::span<T>{m_pData + m_head, m_size};
+	}
+
+	// true if the elements currently occupy a single contiguous run
+	bool isLinear() const noexcept
+	{
+		return m_head + m_size <= m_capacity;
+	}
+
+	T& operator[]( std::size_t index ) noexcept
+	{
+		return m_pData[physical( index )];
+	}
+	const T& operator[]( std::size_t index ) const noexcept
+	{
+		return m_pData[physical( index )];
+	}
+	T& at( std::size_t index )
+	{
+		if ( index < m_size )
+		{
+			return m_pData[physical( index )];
+		}
+		throwException( "CircularVector index out of bounds." );
+	}
+
+	T& front() noexcept
+	{
+		return m_pData[m_head];
+	}
+	const T& cfront() const noexcept
+	{
+		return m_pData[m_head];
+	}
+	T& back() noexcept
+	{
+		return m_pData[physical( m_size - 1 )];
+	}
+	const T& cback() const noexcept
+	{
+		return m_pData[physical( m_size - 1 )];
+	}
+
+	bool isEmpty() const noexcept
+	{
+		return m_size == 0;
+	}
+	std::size_t getSize() const noexcept
+	{
+		return m_size;
+	}
+	std::size_t getCapacity() const noexcept
+	{
+		return m_capacity;
+	}
+};
+
+template <typename T, typename Alloc>
+void swap( CircularVector<T, Alloc>& lhs,
+	CircularVector<T, Alloc>& rhs ) noexcept
+{
+	lhs.swap( rhs );
+}
+
+
+//============================================================
+//	\class	SpscCircularVector<T, Alloc>
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 16:00
+//
+//	\brief	bounded lock-free single producer / single consumer ring
+//			fixed power of 2 capacity (no growth - a full ring rejects the push)
+//			head & tail are free running counters on their own cache lines;
+//				each side caches the other side's counter and only reloads it
+//				(acquire) when the cached value says full/empty
+//			exactly one thread may call the tryPush* functions and exactly one
+//				other thread the tryPop* functions
+//=============================================================
+template<class T, class Alloc = std::allocator<T>>
+class SpscCircularVector
+{
+	using AllocTraits = std::allocator_traits<Alloc>;
+	static constexpr std::size_t cacheLineSize = 64;
+
+	Alloc m_alloc;
+	const std::size_t m_capacity;
+	T* const m_pData;
+	// consumer side
+	alignas( cacheLineSize ) std::atomic<std::size_t> m_head;
+	std::size_t m_cachedTail;
+	// producer side
+	alignas( cacheLineSize ) std::atomic<std::size_t> m_tail;
+	std::size_t m_cachedHead;
+public:
+	// capacity is rounded up to a power of 2
+	explicit SpscCircularVector( std::size_t capacity )
+		:
+		m_alloc{},
+		m_capacity{std::bit_ceil( std::max<std::size_t>( capacity, 1 ) )},
+		m_pData{AllocTraits::allocate( m_alloc, m_capacity )},
+		m_head{0},
+		m_cachedTail{0},
+		m_tail{0},
+		m_cachedHead{0}
+	{
+
+	}
+
+	~SpscCircularVector() noexcept
+	{
+		const std::size_t tail = m_tail.load( std::memory_order_relaxed );
+		for ( std::size_t i = m_head.load( std::memory_order_relaxed ); i != tail; ++i )
+		{
+			m_pData[i & ( m_capacity - 1 )].~T();
+		}
+		AllocTraits::deallocate( m_alloc, m_pData, m_capacity );
+	}
+
+	SpscCircularVector( const SpscCircularVector& rhs ) = delete;
+	SpscCircularVector& operator=( const SpscCircularVector& rhs ) = delete;
+
+	// producer
+	template<typename... TArgs>
+	bool tryEmplaceBack( TArgs&&... args )
+	{
+		const std::size_t tail = m_tail.load( std::memory_order_relaxed );
+		if ( tail - m_cachedHead == m_capacity )
+		{
+			m_cachedHead = m_head.load( std::memory_order_acquire );
+			if ( tail - m_cachedHead == m_capacity )
+			{
+				return false;
+			}
+		}
+		::new ( m_pData + ( tail & ( m_capacity - 1 ) ) ) T(std::forward<TArgs>( args )...);
+		m_tail.store( tail + 1, std::memory_order_release );
+		return true;
+	}
+	bool tryPushBack( const T& val )
+	{
+		return tryEmplaceBack( val );
+	}
+	bool tryPushBack( T&& val )
+	{
+		return tryEmplaceBack( std::move( val ) );
+	}
+
+	// consumer
+	bool tryPopFront( T& out )
+	{
+		const std::size_t head = m_head.load( std::memory_order_relaxed );
+		if ( head == m_cachedTail )
+		{
+			m_cachedTail = m_tail.load( std::memory_order_acquire );
+			if ( head == m_cachedTail )
+			{
+				return false;
+			}
+		}
+		T& slot = m_pData[head & ( m_capacity - 1 )];
+		out = std::move( slot );
+		slot.~T();
+		m_head.store( head + 1, std::memory_order_release );
+		return true;
+	}
+
+	// approximate when called concurrently
+	std::size_t getSize() const noexcept
+	{
+		return m_tail.load( std::memory_order_acquire ) - m_head.load( std::memory_order_acquire );
+	}
+	bool isEmpty() const noexcept
+	{
+		return getSize() == 0;
+	}
+	std::size_t getCapacity() const noexcept
+	{
+		return m_capacity;
+	}
+};
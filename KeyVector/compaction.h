@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#if defined __AVX2__ || defined __AVX512F__
+#	include <immintrin.h>
+#endif
+
+
+//============================================================
+//	in place removal kernels behind Vector's erase family
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 22:00
+//
+//	\brief	all of them keep the survivors in order and return the new element count;
+//				the slots past it hold moved-from objects the caller destroys
+//			trivially copyable types (the ones that can be relocated bitwise) move with memmove
+//			removeIf on 4 & 8 byte arithmetic types evaluates the predicate for a block of
+//				lanes into a keep mask and compacts the block with one permute (AVX2, LUT
+//				driven) or compress (AVX-512F) and a full width store; the store never
+//				passes the block it came from, so it can't clobber unread elements
+//			everything else is a branchless scalar loop
+//=============================================================
+namespace compaction
+{
+
+// [first, last) into dst (dst <= first), overlapping
+template<typename T>
+void shiftDown( T* dst,
+	T* first,
+	T* last ) noexcept( std::is_nothrow_move_assignable_v<T> )
+{
+	if constexpr ( std::is_trivially_copyable_v<T> )
+	{
+		if ( first != last )
+		{
+			std::memmove( static_cast<void*>( dst ), first, static_cast<std::size_t>( last - first ) * sizeof( T ) );
+		}
+	}
+	else
+	{
+		for ( ; first != last; ++first, ++dst )
+		{
+			*dst = std::move( *first );
+		}
+	}
+}
+
+namespace detail
+{
+
+template<typename T>
+inline constexpr bool isSimdCompactable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+	&& ( sizeof( T ) == 4 || sizeof( T ) == 8 );
+
+#if defined __AVX2__ && !defined __AVX512F__
+// lane permutations that move the kept 32 bit lanes (set bits of the mask) to the front
+inline constexpr auto permute8x32 = []()
+{
+	std::array<std::array<std::uint32_t, 8>, 256> lut{};
+	for ( std::uint32_t mask = 0; mask < 256; ++mask )
+	{
+		std::uint32_t k = 0;
+		for ( std::uint32_t lane = 0; lane < 8; ++lane )
+		{
+			if ( mask & ( 1u << lane ) )
+			{
+				lut[mask][k++] = lane;
+			}
+		}
+	}
+	return lut;
+}();
+// same for 64 bit lanes, expressed as pairs of 32 bit lanes
+inline constexpr auto permute4x64 = []()
+{
+	std::array<std::array<std::uint32_t, 8>, 16> lut{};
+	for ( std::uint32_t mask = 0; mask < 16; ++mask )
+	{
+		std::uint32_t k = 0;
+		for ( std::uint32_t lane = 0; lane < 4; ++lane )
+		{
+			if ( mask & ( 1u << lane ) )
+			{
+				lut[mask][k++] = 2 * lane;
+				lut[mask][k++] = 2 * lane + 1;
+			}
+		}
+	}
+	return lut;
+}();
+#endif
+
+#if defined __AVX2__ || defined __AVX512F__
+template<typename T, typename Pred>
+std::size_t removeIfSimd( T* data,
+	std::size_t n,
+	Pred& pred )
+{
+#	if defined __AVX512F__
+	constexpr std::size_t lanes = 64 / sizeof( T );
+#	else
+	constexpr std::size_t lanes = 32 / sizeof( T );
+#	endif
+	std::size_t k = 0;
+	std::size_t i = 0;
+	for ( ; i + lanes <= n; i += lanes )
+	{
+		unsigned keep = 0;
+		for ( std::size_t lane = 0; lane < lanes; ++lane )
+		{
+			keep |= static_cast<unsigned>( !pred( data[i + lane] ) ) << lane;
+		}
+		if ( keep == ( 1u << lanes ) - 1 && k == i )
+		{
+			k += lanes;	// nothing removed so far, nothing to move
+			continue;
+		}
+#	if defined __AVX512F__
+		const __m512i block = _mm512_loadu_si512( data + i );
+		const __m512i packed = sizeof( T ) == 4 ?
+			_mm512_maskz_compress_epi32( static_cast<__mmask16>( keep ), block ) :
+			_mm512_maskz_compress_epi64( static_cast<__mmask8>( keep ), block );
+		_mm512_storeu_si512( data + k, packed );
+#	else
+		const __m256i block = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( data + i ) );
+		const std::uint32_t* perm = sizeof( T ) == 4 ?
+			permute8x32[keep].data() :
+			permute4x64[keep].data();
+		const __m256i packed = _mm256_permutevar8x32_epi32( block, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( perm ) ) );
+		_mm256_storeu_si256( reinterpret_cast<__m256i*>( data + k ), packed );
+#	endif
+		k += static_cast<std::size_t>( std::popcount( keep ) );
+	}
+	for ( ; i < n; ++i )
+	{
+		const T x = data[i];
+		data[k] = x;
+		k += !pred( x );
+	}
+	return k;
+}
+#endif
+
+}//detail
+
+// stable: removes the elements pred accepts
+template<typename T, typename Pred>
+std::size_t removeIf( T* data,
+	std::size_t n,
+	Pred&& pred )
+{
+#if defined __AVX2__ || defined __AVX512F__
+	if constexpr ( detail::isSimdCompactable<T> )
+	{
+		return detail::removeIfSimd( data, n, pred );
+	}
+	else
+#endif
+	if constexpr ( std::is_trivially_copyable_v<T> && sizeof( T ) <= 16 )
+	{
+		// unconditional copy, advance only on keep - no unpredictable branch
+		std::size_t k = 0;
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			const T x = data[i];
+			data[k] = x;
+			k += !pred( x );
+		}
+		return k;
+	}
+	else
+	{
+		std::size_t k = 0;
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			if ( !pred( data[i] ) )
+			{
+				if ( k != i )
+				{
+					data[k] = std::move( data[i] );
+				}
+				++k;
+			}
+		}
+		return k;
+	}
+}
+
+// removes the elements at the (strictly ascending, in range) positions idx[0, m)
+//	every surviving run moves once
+template<typename T>
+std::size_t removeIndices( T* data,
+	std::size_t n,
+	const std::size_t* idx,
+	std::size_t m ) noexcept( std::is_nothrow_move_assignable_v<T> )
+{
+	if ( m == 0 )
+	{
+		return n;
+	}
+	std::size_t out = idx[0];
+	for ( std::size_t j = 0; j < m; ++j )
+	{
+		assert( idx[j] < n && ( j == 0 || idx[j - 1] < idx[j] ) );
+		const std::size_t runBegin = idx[j] + 1;
+		const std::size_t runEnd = j + 1 < m ?
+			idx[j + 1] :
+			n;
+		shiftDown( data + out, data + runBegin, data + runEnd );
+		out += runEnd - runBegin;
+	}
+	return out;
+}
+
+}//compaction
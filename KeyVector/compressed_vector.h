@@ -0,0 +1,508 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+#if defined __AVX2__
+#	include <immintrin.h>
+#endif
+#include "vector.h"
+
+
+//============================================================
+//	bit packing primitives shared by PackedIntVector & DeltaVector
+//	bit streams are little-endian sequences of 64bit words
+//	the owner keeps one spare (zero) word past the last used bit so that
+//		the unpackers may issue unaligned 8 byte loads at any in-range bit position
+//=============================================================
+namespace bitpack
+{
+
+inline constexpr std::uint64_t lowMask( unsigned width ) noexcept
+{
+	return width >= 64 ?
+		~0ull :
+		( 1ull << width ) - 1;
+}
+
+// number of bits required to represent `value`
+inline unsigned requiredBits( std::uint64_t value ) noexcept
+{
+	unsigned bits = 0;
+	while ( value )
+	{
+		++bits;
+		value >>= 1;
+	}
+	return bits;
+}
+
+// number of words needed to hold `bits` plus the trailing spare word
+inline constexpr std::size_t wordsFor( std::uint64_t bits ) noexcept
+{
+	return static_cast<std::size_t>( ( bits + 63 ) >> 6 ) + 1;
+}
+
+inline std::uint64_t read( const std::uint64_t* words,
+	std::uint64_t bitPos,
+	unsigned width ) noexcept
+{
+	const std::size_t w = static_cast<std::size_t>( bitPos >> 6 );
+	const unsigned s = static_cast<unsigned>( bitPos & 63 );
+	std::uint64_t value = words[w] >> s;
+	if ( s + width > 64 )
+	{
+		value |= words[w + 1] << ( 64 - s );
+	}
+	return value & lowMask( width );
+}
+
+inline void write( std::uint64_t* words,
+	std::uint64_t bitPos,
+	unsigned width,
+	std::uint64_t value ) noexcept
+{
+	const std::uint64_t mask = lowMask( width );
+	const std::size_t w = static_cast<std::size_t>( bitPos >> 6 );
+	const unsigned s = static_cast<unsigned>( bitPos & 63 );
+	value &= mask;
+	words[w] = ( words[w] & ~( mask << s ) ) | ( value << s );
+	if ( s + width > 64 )
+	{
+		const unsigned spill = s + width - 64;
+		words[w + 1] = ( words[w + 1] & ~lowMask( spill ) ) | ( value >> ( 64 - s ) );
+	}
+}
+
+// decode `count` consecutive `width`-bit fields starting at `bitPos` into `out`
+//	AVX2: 4 fields per iteration via byte-granular gathers + variable shifts
+//		(any field of <= 57 bits fits in a single unaligned 8 byte load)
+template<typename T>
+void unpack( const std::uint64_t* words,
+	std::uint64_t bitPos,
+	unsigned width,
+	std::size_t count,
+	T* out ) noexcept
+{
+	if ( width == 0 )
+	{
+		std::fill( out, out + count, T{0} );
+		return;
+	}
+
+	std::size_t i = 0;
+#if defined __AVX2__
+	if ( width <= 57 )
+	{
+		const long long* base = reinterpret_cast<const long long*>( words );
+		const __m256i mask = _mm256_set1_epi64x( static_cast<long long>( lowMask( width ) ) );
+		const __m256i seven = _mm256_set1_epi64x( 7 );
+		const __m256i step = _mm256_set1_epi64x( 4ll * width );
+		__m256i pos = _mm256_add_epi64( _mm256_set1_epi64x( static_cast<long long>( bitPos ) ),
+			_mm256_setr_epi64x( 0, width, 2ll * width, 3ll * width ) );
+		for ( ; i + 4 <= count; i += 4 )
+		{
+			const __m256i bytes = _mm256_srli_epi64( pos, 3 );
+			const __m256i shifts = _mm256_and_si256( pos, seven );
+			__m256i v = _mm256_i64gather_epi64( base, bytes, 1 );
+			v = _mm256_and_si256( _mm256_srlv_epi64( v, shifts ), mask );
+			if constexpr ( sizeof( T ) == 8 )
+			{
+				_mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), v );
+			}
+			else if constexpr ( sizeof( T ) == 4 )
+			{
+				const __m256i packed = _mm256_permutevar8x32_epi32( v,
+					_mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( out + i ),
+					_mm256_castsi256_si128( packed ) );
+			}
+			else
+			{
+				alignas( 32 ) std::uint64_t lanes[4];
+				_mm256_store_si256( reinterpret_cast<__m256i*>( lanes ), v );
+				for ( int k = 0; k < 4; ++k )
+				{
+					out[i + k] = static_cast<T>( lanes[k] );
+				}
+			}
+			pos = _mm256_add_epi64( pos, step );
+		}
+	}
+#endif
+	for ( ; i < count; ++i )
+	{
+		out[i] = static_cast<T>( read( words, bitPos + i * width, width ) );
+	}
+}
+
+}//bitpack
+
+
+//============================================================
+//	\class	PackedIntVector<T>
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 12:10
+//
+//	\brief	fixed-width bit packed vector of unsigned integers
+//			every element occupies exactly getBitWidth() bits, random access is O(1)
+//			values that don't fit the width are rejected
+//=============================================================
+template<typename T = std::uint64_t>
+class PackedIntVector
+{
+	static_assert( std::is_integral_v<T> && std::is_unsigned_v<T>,
+		"PackedIntVector requires an unsigned integral type." );
+
+	std::size_t m_size;
+	unsigned m_bitWidth;
+	Vector<std::uint64_t> m_words;
+
+	void growTo( std::size_t nElements )
+	{
+		const std::size_t needed = bitpack::wordsFor( static_cast<std::uint64_t>( nElements ) * m_bitWidth );
+		while ( m_words.getSize() < needed )
+		{
+			m_words.pushBack( 0 );
+		}
+	}
+public:
+	explicit PackedIntVector( unsigned bitWidth )
+		:
+		m_size{0},
+		m_bitWidth{bitWidth},
+		m_words{}
+	{
+		if ( bitWidth > sizeof( T ) * 8 )
+		{
+			throwException( "Bit width exceeds the element type." );
+		}
+		m_words.pushBack( 0 );
+	}
+
+	// smallest width that fits the largest element
+	static PackedIntVector fromVector( const Vector<T>& v )
+	{
+		T maxVal{0};
+		for ( std::size_t i = 0; i < v.getSize(); ++i )
+		{
+			maxVal = std::max( maxVal, v[i] );
+		}
+		PackedIntVector packed{bitpack::requiredBits( maxVal )};
+		packed.growTo( v.getSize() );
+		for ( std::size_t i = 0; i < v.getSize(); ++i )
+		{
+			bitpack::write( &packed.m_words[0], static_cast<std::uint64_t>( i ) * packed.m_bitWidth, packed.m_bitWidth, v[i] );
+		}
+		packed.m_size = v.getSize();
+		return packed;
+	}
+
+	Vector<T> toVector() const
+	{
+		Vector<T> v{std::max<std::size_t>( m_size, 1 )};
+		T buffer[256];
+		for ( std::size_t i = 0; i < m_size; i += 256 )
+		{
+			const std::size_t n = std::min<std::size_t>( 256, m_size - i );
+			decode( i, n, buffer );
+			for ( std::size_t j = 0; j < n; ++j )
+			{
+				v.pushBack( buffer[j] );
+			}
+		}
+		return v;
+	}
+
+	void pushBack( T value )
+	{
+		if ( bitpack::requiredBits( value ) > m_bitWidth )
+		{
+			throwException( "Value does not fit in the packed bit width." );
+		}
+		growTo( m_size + 1 );
+		bitpack::write( &m_words[0], static_cast<std::uint64_t>( m_size ) * m_bitWidth, m_bitWidth, value );
+		++m_size;
+	}
+
+	void set( std::size_t index,
+		T value )
+	{
+		if ( bitpack::requiredBits( value ) > m_bitWidth )
+		{
+			throwException( "Value does not fit in the packed bit width." );
+		}
+		bitpack::write( &m_words[0], static_cast<std::uint64_t>( index ) * m_bitWidth, m_bitWidth, value );
+	}
+
+	T operator[]( std::size_t index ) const noexcept
+	{
+		return static_cast<T>( bitpack::read( &m_words[0], static_cast<std::uint64_t>( index ) * m_bitWidth, m_bitWidth ) );
+	}
+
+	// bulk decode [first, first + count) into `out`
+	void decode( std::size_t first,
+		std::size_t count,
+		T* out ) const noexcept
+	{
+		bitpack::unpack( &m_words[0], static_cast<std::uint64_t>( first ) * m_bitWidth, m_bitWidth, count, out );
+	}
+
+	std::size_t getSize() const noexcept
+	{
+		return m_size;
+	}
+	unsigned getBitWidth() const noexcept
+	{
+		return m_bitWidth;
+	}
+	std::size_t getSizeInBytes() const noexcept
+	{
+		return m_words.getSize() * sizeof( std::uint64_t );
+	}
+	// uncompressed bytes / compressed bytes
+	double compressionRatio() const noexcept
+	{
+		return static_cast<double>( m_size * sizeof( T ) ) / getSizeInBytes();
+	}
+};
+
+
+//============================================================
+//	\class	DeltaVector<T>
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 12:40
+//
+//	\brief	append-only compressed vector for non-decreasing integer sequences
+//			(sorted ids, timestamps)
+//			elements are grouped in blocks of blockSize; each sealed block stores
+//				its deltas bit-packed at the block's own width
+//			a skip header per block (first & last value, bit offset, width)
+//				allows lowerBound() to touch a single block
+//			the last, partially filled block is kept uncompressed
+//=============================================================
+template<typename T = std::uint64_t>
+class DeltaVector
+{
+	static_assert( std::is_integral_v<T>,
+		"DeltaVector requires an integral type." );
+public:
+	static constexpr std::size_t blockSize = 128;
+private:
+	struct BlockHeader
+	{
+		T first;
+		T last;
+		std::uint64_t bitOffset;
+		unsigned bitWidth;
+	};
+
+	std::size_t m_size;
+	std::uint64_t m_bitLength;
+	Vector<BlockHeader> m_headers;
+	Vector<std::uint64_t> m_words;
+	std::size_t m_tailSize;
+	T m_tail[blockSize];
+
+	void sealTail()
+	{
+		std::uint64_t maxDelta = 0;
+		for ( std::size_t i = 1; i < m_tailSize; ++i )
+		{
+			maxDelta = std::max( maxDelta, static_cast<std::uint64_t>( m_tail[i] - m_tail[i - 1] ) );
+		}
+		const unsigned width = bitpack::requiredBits( maxDelta );
+		m_headers.pushBack( BlockHeader{m_tail[0], m_tail[m_tailSize - 1], m_bitLength, width} );
+
+		const std::size_t needed = bitpack::wordsFor( m_bitLength + ( m_tailSize - 1 ) * width );
+		while ( m_words.getSize() < needed )
+		{
+			m_words.pushBack( 0 );
+		}
+		for ( std::size_t i = 1; i < m_tailSize; ++i )
+		{
+			bitpack::write( &m_words[0], m_bitLength, width, static_cast<std::uint64_t>( m_tail[i] - m_tail[i - 1] ) );
+			m_bitLength += width;
+		}
+		m_tailSize = 0;
+	}
+public:
+	DeltaVector()
+		:
+		m_size{0},
+		m_bitLength{0},
+		m_headers{},
+		m_words{},
+		m_tailSize{0}
+	{
+		m_words.pushBack( 0 );
+	}
+
+	static DeltaVector fromVector( const Vector<T>& v )
+	{
+		DeltaVector dv;
+		for ( std::size_t i = 0; i < v.getSize(); ++i )
+		{
+			dv.pushBack( v[i] );
+		}
+		return dv;
+	}
+
+	Vector<T> toVector() const
+	{
+		Vector<T> v{std::max<std::size_t>( m_size, 1 )};
+		forEach( [&v]( T value )
+			{
+				v.pushBack( value );
+			}
+		);
+		return v;
+	}
+
+	void pushBack( T value )
+	{
+		if ( m_size > 0 && value < back() )
+		{
+			throwException( "DeltaVector requires non-decreasing values." );
+		}
+		m_tail[m_tailSize++] = value;
+		++m_size;
+		if ( m_tailSize == blockSize )
+		{
+			sealTail();
+		}
+	}
+
+	T back() const noexcept
+	{
+		return m_tailSize > 0 ?
+			m_tail[m_tailSize - 1] :
+			m_headers[m_headers.getSize() - 1].last;
+	}
+
+	std::size_t getBlockCount() const noexcept
+	{
+		return m_headers.getSize() + ( m_tailSize > 0 ? 1 : 0 );
+	}
+
+	// decodes block `b` into `out` (room for blockSize elements), returns its element count
+	std::size_t decodeBlock( std::size_t b,
+		T* out ) const noexcept
+	{
+		if ( b == m_headers.getSize() )
+		{
+			std::copy( m_tail, m_tail + m_tailSize, out );
+			return m_tailSize;
+		}
+		const BlockHeader& h = m_headers[b];
+		out[0] = h.first;
+		bitpack::unpack( &m_words[0], h.bitOffset, h.bitWidth, blockSize - 1, out + 1 );
+		for ( std::size_t i = 1; i < blockSize; ++i )
+		{
+			out[i] += out[i - 1];
+		}
+		return blockSize;
+	}
+
+	// O(blockSize) random access
+	T operator[]( std::size_t index ) const noexcept
+	{
+		T buffer[blockSize];
+		decodeBlock( index / blockSize, buffer );
+		return buffer[index % blockSize];
+	}
+
+	// index of the first element >= value, getSize() if there is none
+	std::size_t lowerBound( T value ) const noexcept
+	{
+		const std::size_t nSealed = m_headers.getSize();
+		const BlockHeader* headers = nSealed > 0 ? &m_headers[0] : nullptr;
+		const BlockHeader* h = std::lower_bound( headers,
+			headers + nSealed,
+			value,
+			[]( const BlockHeader& header, T v )
+			{
+				return header.last < v;
+			}
+		);
+		const std::size_t b = static_cast<std::size_t>( h - headers );
+		T buffer[blockSize];
+		const std::size_t n = decodeBlock( b, buffer );
+		return b * blockSize + static_cast<std::size_t>( std::lower_bound( buffer, buffer + n, value ) - buffer );
+	}
+
+	template<typename F>
+	void forEach( F&& f ) const
+	{
+		T buffer[blockSize];
+		for ( std::size_t b = 0; b < getBlockCount(); ++b )
+		{
+			const std::size_t n = decodeBlock( b, buffer );
+			for ( std::size_t i = 0; i < n; ++i )
+			{
+				f( buffer[i] );
+			}
+		}
+	}
+
+	//============================================================
+	//	\class	Reader
+	//	\brief	streaming decoder, materializes one block at a time
+	//=============================================================
+	class Reader final
+	{
+		const DeltaVector* m_dv;
+		std::size_t m_block;
+		std::size_t m_pos;
+		std::size_t m_count;
+		T m_buffer[blockSize];
+	public:
+		explicit Reader( const DeltaVector& dv )
+			:
+			m_dv{&dv},
+			m_block{0},
+			m_pos{0},
+			m_count{0}
+		{
+
+		}
+
+		bool next( T& out ) noexcept
+		{
+			if ( m_pos == m_count )
+			{
+				if ( m_block >= m_dv->getBlockCount() )
+				{
+					return false;
+				}
+				m_count = m_dv->decodeBlock( m_block++, m_buffer );
+				m_pos = 0;
+			}
+			out = m_buffer[m_pos++];
+			return true;
+		}
+	};
+
+	Reader reader() const noexcept
+	{
+		return Reader{*this};
+	}
+
+	std::size_t getSize() const noexcept
+	{
+		return m_size;
+	}
+	std::size_t getSizeInBytes() const noexcept
+	{
+		return m_words.getSize() * sizeof( std::uint64_t )
+			+ m_headers.getSize() * sizeof( BlockHeader )
+			+ m_tailSize * sizeof( T );
+	}
+	double compressionRatio() const noexcept
+	{
+		return static_cast<double>( m_size * sizeof( T ) ) / getSizeInBytes();
+	}
+};
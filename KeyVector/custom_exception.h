@@ -1,5 +1,9 @@
+#pragma once
+
 #include <sstream>
 #include <string>
+#include <cstdio>
+#include <cstdlib>
 /////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////
 #if defined(_UNICODE) || defined(UNICODE)
@@ -21,24 +25,39 @@
 /////////////////////////////////////////////////////////////////////////////////////////
 #if defined(_UNICODE) || defined(UNICODE)	// it's defined
 
+// throwing must not allocate - only the literals' addresses are kept,
+//	the message is formatted when (if) someone asks for it
 class Exception
 {
-	std::wstring m_msg;
+	const wchar_t* m_arg;
+	const wchar_t* m_file;
+	const wchar_t* m_function;
+	int m_line;
 public:
-	Exception(const std::wstring &arg, const std::wstring &file,
-		const std::wstring &function, int line)
+	Exception(const wchar_t* arg, const wchar_t* file,
+		const wchar_t* function, int line) noexcept
+		:
+		m_arg{arg},
+		m_file{file},
+		m_function{function},
+		m_line{line}
+	{
+
+	}
+
+	const std::wstring what() const
 	{
 		std::wostringstream woss;
-		woss << arg << ' '
-			<< file << ", "
-			<< function << "@line:#"
-			<< line << ": ";
-		m_msg = woss.str();
+		woss << m_arg << ' '
+			<< m_file << ", "
+			<< m_function << "@line:#"
+			<< m_line << ": ";
+		return woss.str();
 	}
 
-	const std::wstring what() const noexcept
+	const wchar_t* message() const noexcept
 	{
-		return m_msg;
+		return m_arg;
 	}
 };
 
@@ -72,26 +91,50 @@ public:
 
 #define throwException(arg) throw Exception(arg, __FILE__, __function__, __LINE__);
 */
+// throwing must not allocate - only the literals' addresses are kept,
+//	the message is formatted when (if) someone asks for it
 class Exception
 {
-	std::string m_msg;
+	const char* m_arg;
+	const char* m_file;
+	const char* m_function;
+	int m_line;
 public:
-	Exception(const std::string &arg, const std::string &file,
-		const std::string &function, int line)
+	Exception(const char* arg, const char* file,
+		const char* function, int line) noexcept
+		:
+		m_arg{arg},
+		m_file{file},
+		m_function{function},
+		m_line{line}
+	{
+
+	}
+
+	const std::string what() const
 	{
 		std::ostringstream oss;
-		oss << arg << ' '
-			<< file << " !"
-			<< function << " @line:#"
-			<< line << ": ";
-		m_msg = oss.str();
+		oss << m_arg << ' '
+			<< m_file << " !"
+			<< m_function << " @line:#"
+			<< m_line << ": ";
+		return oss.str();
 	}
 
-	const std::string what() const noexcept
+	const char* message() const noexcept
 	{
-		return m_msg;
+		return m_arg;
 	}
 };
 
 #define throwException(msg) throw Exception(msg, __FILE__, __function__, __LINE__);
-#endif
\ No newline at end of file
+#endif
+/////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////
+// builds without exception support (-fno-exceptions, /EHs-c-) report & abort instead
+#if defined __cpp_exceptions || defined _CPPUNWIND
+#	define KEYVECTOR_EXCEPTIONS
+#else
+#	undef throwException
+#	define throwException(msg) ( std::fputs( msg "\n", stderr ), std::abort() );
+#endif
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <cassert>
+#include <utility>
+#include <variant>
+#include "custom_exception.h"
+
+
+enum class VectorError
+{
+	OutOfRange,
+	BadAlloc,
+	LengthError,
+	ParseError
+};
+
+inline constexpr const char* toString( VectorError e ) noexcept
+{
+	switch ( e )
+	{
+	case VectorError::OutOfRange:
+		return "Array out of bounds exception.";
+	case VectorError::BadAlloc:
+		return "Vector allocation failed.";
+	case VectorError::LengthError:
+		return "Vector length exceeds max size.";
+	case VectorError::ParseError:
+		return "Vector text is malformed or out of range.";
+	}
+	return "Unknown Vector error.";
+}
+
+
+//============================================================
+//	\class	Expected<T, E>
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 18:30
+//
+//	\brief	value-or-error result (C++23 std::expected lookalike) for the
+//				non-throwing Vector operations; never allocates
+//			Expected<T&> refers to an element, Expected<void> only carries the error
+//			accessing the value of an error result is a precondition violation
+//=============================================================
+template<typename T, typename E = VectorError>
+class Expected
+{
+	std::variant<T, E> m_v;
+public:
+	Expected( const T& value )
+		:
+		m_v{std::in_place_index<0>, value}
+	{
+
+	}
+	Expected( T&& value )
+		:
+		m_v{std::in_place_index<0>, std::move( value )}
+	{
+
+	}
+	static Expected failure( E error ) noexcept
+	{
+		return Expected{std::in_place_index<1>, error};
+	}
+
+	bool hasValue() const noexcept
+	{
+		return m_v.index() == 0;
+	}
+	explicit operator bool() const noexcept
+	{
+		return hasValue();
+	}
+	T& value() noexcept
+	{
+		assert( hasValue() );
+		return *std::get_if<0>( &m_v );
+	}
+	const T& value() const noexcept
+	{
+		assert( hasValue() );
+		return *std::get_if<0>( &m_v );
+	}
+	T& operator*() noexcept
+	{
+		return value();
+	}
+	T* operator->() noexcept
+	{
+		return &value();
+	}
+	T valueOr( T fallback ) const
+	{
+		return hasValue() ?
+			value() :
+			fallback;
+	}
+	E error() const noexcept
+	{
+		assert( !hasValue() );
+		return *std::get_if<1>( &m_v );
+	}
+private:
+	Expected( std::in_place_index_t<1>,
+		E error ) noexcept
+		:
+		m_v{std::in_place_index<1>, error}
+	{
+
+	}
+};
+
+template<typename T, typename E>
+class Expected<T&, E>
+{
+	T* m_p;
+	E m_error;
+public:
+	Expected( T& value ) noexcept
+		:
+		m_p{&value},
+		m_error{}
+	{
+
+	}
+	static Expected failure( E error ) noexcept
+	{
+		Expected r{error};
+		return r;
+	}
+
+	bool hasValue() const noexcept
+	{
+		return m_p != nullptr;
+	}
+	explicit operator bool() const noexcept
+	{
+		return hasValue();
+	}
+	T& value() const noexcept
+	{
+		assert( hasValue() );
+		return *m_p;
+	}
+	T& operator*() const noexcept
+	{
+		return value();
+	}
+	T* operator->() const noexcept
+	{
+		return m_p;
+	}
+	E error() const noexcept
+	{
+		assert( !hasValue() );
+		return m_error;
+	}
+private:
+	explicit Expected( E error ) noexcept
+		:
+		m_p{nullptr},
+		m_error{error}
+	{
+
+	}
+};
+
+template<typename E>
+class Expected<void, E>
+{
+	bool m_ok;
+	E m_error;
+
+	explicit Expected( E error ) noexcept
+		:
+		m_ok{false},
+		m_error{error}
+	{
+
+	}
+public:
+	Expected() noexcept
+		:
+		m_ok{true},
+		m_error{}
+	{
+
+	}
+	static Expected failure( E error ) noexcept
+	{
+		return Expected{error};
+	}
+
+	bool hasValue() const noexcept
+	{
+		return m_ok;
+	}
+	explicit operator bool() const noexcept
+	{
+		return m_ok;
+	}
+	E error() const noexcept
+	{
+		assert( !m_ok );
+		return m_error;
+	}
+};
+
+
+//============================================================
+//	error policies - Vector's 3rd template parameter
+//	decide what the checked operations (at) return and do on failure:
+//		ThrowOnError	- R, throws Exception (default when exceptions are enabled)
+//		AbortOnError	- R, prints the message and aborts (default otherwise)
+//		ReturnError		- Expected<R>, never unwinds
+//	the try* operations always return Expected regardless of the policy
+//=============================================================
+struct AbortOnError
+{
+	template<typename R>
+	using Result = R;
+
+	template<typename R>
+	static R success( R r ) noexcept
+	{
+		return static_cast<R>( r );
+	}
+
+	template<typename R>
+	[[noreturn]] static R failure( VectorError e ) noexcept
+	{
+		std::fputs( toString( e ), stderr );
+		std::fputc( '\n', stderr );
+		std::abort();
+	}
+};
+
+#ifdef KEYVECTOR_EXCEPTIONS
+struct ThrowOnError
+{
+	template<typename R>
+	using Result = R;
+
+	template<typename R>
+	static R success( R r ) noexcept
+	{
+		return static_cast<R>( r );
+	}
+
+	template<typename R>
+	[[noreturn]] static R failure( VectorError e )
+	{
+		switch ( e )
+		{
+		case VectorError::OutOfRange:
+			throwException( "Array out of bounds exception." );
+		case VectorError::BadAlloc:
+			throwException( "Vector allocation failed." );
+		case VectorError::LengthError:
+			throwException( "Vector length exceeds max size." );
+		case VectorError::ParseError:
+			throwException( "Vector text is malformed or out of range." );
+		}
+		std::abort();
+	}
+};
+using DefaultErrorPolicy = ThrowOnError;
+#else
+using DefaultErrorPolicy = AbortOnError;
+#endif
+
+struct ReturnError
+{
+	template<typename R>
+	using Result = Expected<R>;
+
+	template<typename R>
+	static Expected<R> success( R r ) noexcept
+	{
+		return Expected<R>{static_cast<R>( r )};
+	}
+
+	template<typename R>
+	static Expected<R> failure( VectorError e ) noexcept
+	{
+		return Expected<R>::failure( e );
+	}
+};
@@ -0,0 +1,737 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <memory>
+#include <limits>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include "vector.h"
+#include "parallel.h"
+
+
+//============================================================
+//	hash based dedup, grouping & set operations over Vector
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 06:00
+//
+//	\brief	everything is built on Index: it numbers the distinct keys of a span
+//				0, 1, .. with open addressing tables (linear probing, load <= 1/2)
+//				presized from the input length, so no pass ever sorts
+//			large inputs are radix partitioned by the top bits of the hash first:
+//				a histogram & a stable scatter of the positions per chunk, then every
+//				partition builds its own table on its own thread; there are enough
+//				partitions for each table to stay cache resident, also single threaded
+//			Order::FirstSeen numbers (and so outputs) the keys in the order they first
+//				occur in the input, Order::Any in whatever order is cheapest
+//			Hash only has to be a std::hash like functor; its result is remixed, so
+//				identity hashes of integers are fine
+//=============================================================
+namespace hashed
+{
+
+enum class Order
+{
+	Any,
+	FirstSeen
+};
+
+namespace detail
+{
+
+inline constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+// partitioning below this pays for neither the scatter nor the fork
+inline constexpr std::size_t partitionThreshold = 1ull << 16;
+// per partition table budget, about the L2 size
+inline constexpr std::size_t tableBytesPerPartition = 1ull << 20;
+inline constexpr std::size_t maxPartitions = 1024;
+
+// murmur3 finalizer
+inline std::uint64_t mix( std::uint64_t h ) noexcept
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ull;
+	h ^= h >> 33;
+	return h;
+}
+
+template<typename Hash, typename T>
+std::uint64_t hashOf( const T& key ) noexcept
+{
+	return mix( static_cast<std::uint64_t>( Hash{}( key ) ) );
+}
+
+// key -> dense id (in insertion order) table, slots probed from the low hash bits
+template<typename T, typename Hash, typename Eq>
+class FlatTable
+{
+	struct Slot
+	{
+		T key;
+		std::uint32_t id;	// id + 1, 0 = free
+	};
+
+	Vector<Slot> m_slots;
+	std::size_t m_mask;
+	std::uint32_t m_count;
+
+	static constexpr std::size_t minCapacity = 16;
+	// presizing stops here, beyond the table grows as it fills instead
+	static constexpr std::size_t maxPresize = 1ull << 22;
+
+	void grow()
+	{
+		Vector<Slot> old{std::move( m_slots )};
+		const std::size_t capacity = old.getSize() * 2;
+		m_slots = Vector<Slot>{capacity, Slot{T{}, 0}};
+		m_mask = capacity - 1;
+		for ( const Slot& slot : old )
+		{
+			if ( slot.id != 0 )
+			{
+				std::size_t s = hashOf<Hash>( slot.key ) & m_mask;
+				while ( m_slots[s].id != 0 )
+				{
+					s = ( s + 1 ) & m_mask;
+				}
+				m_slots[s] = slot;
+			}
+		}
+	}
+public:
+	explicit FlatTable( std::size_t expected = 0 )
+		:
+		m_slots{std::bit_ceil( std::clamp( expected * 2, minCapacity, maxPresize ) ), Slot{T{}, 0}},
+		m_mask{m_slots.getSize() - 1},
+		m_count{0}
+	{
+
+	}
+
+	// id of key, a new one if key was not there yet (then inserted = true)
+	std::uint32_t insert( const T& key,
+		std::uint64_t h,
+		bool& inserted )
+	{
+		if ( ( m_count + 1ull ) * 2 > m_mask + 1 )
+		{
+			grow();
+		}
+		for ( std::size_t s = h & m_mask; ; s = ( s + 1 ) & m_mask )
+		{
+			Slot& slot = m_slots[s];
+			if ( slot.id == 0 )
+			{
+				slot.key = key;
+				slot.id = ++m_count;
+				inserted = true;
+				return m_count - 1;
+			}
+			if ( Eq{}( slot.key, key ) )
+			{
+				inserted = false;
+				return slot.id - 1;
+			}
+		}
+	}
+
+	std::uint32_t find( const T& key,
+		std::uint64_t h ) const noexcept
+	{
+		for ( std::size_t s = h & m_mask; ; s = ( s + 1 ) & m_mask )
+		{
+			const Slot& slot = m_slots[s];
+			if ( slot.id == 0 )
+			{
+				return npos;
+			}
+			if ( Eq{}( slot.key, key ) )
+			{
+				return slot.id - 1;
+			}
+		}
+	}
+
+	std::uint32_t getCount() const noexcept
+	{
+		return m_count;
+	}
+
+	static constexpr std::size_t slotSize = sizeof( Slot );
+};
+
+// out[k] = make( i ) for the ascending i in [0, n) with keep( i ); chunked over `data`
+template<typename U, typename T, typename Keep, typename Make>
+Vector<U> compact( const T* data,
+	std::size_t n,
+	Keep keep,
+	Make make,
+	parallel::ThreadPool& pool )
+{
+	const parallel::Chunking<T> chunks{data, n, 0, pool.getThreadCount() + 1};
+	const std::size_t nChunks = chunks.getCount();
+	Vector<std::size_t> offsets{nChunks + 1, 0};
+	pool.forkJoin( nChunks, [&]( std::size_t c )
+		{
+			std::size_t count = 0;
+			for ( std::size_t i = chunks.begin( c ), e = chunks.end( c ); i < e; ++i )
+			{
+				count += keep( i ) ? 1 : 0;
+			}
+			offsets[c + 1] = count;
+		}
+	);
+	for ( std::size_t c = 0; c < nChunks; ++c )
+	{
+		offsets[c + 1] += offsets[c];
+	}
+	const std::size_t total = offsets[nChunks];
+	if ( total == 0 )
+	{
+		return Vector<U>{1};
+	}
+	Vector<U> out{total, U{}};
+	pool.forkJoin( nChunks, [&]( std::size_t c )
+		{
+			std::size_t k = offsets[c];
+			for ( std::size_t i = chunks.begin( c ), e = chunks.end( c ); i < e; ++i )
+			{
+				if ( keep( i ) )
+				{
+					out[k++] = make( i );
+				}
+			}
+		}
+	);
+	return out;
+}
+
+// out[k] = s[positions[k]]
+template<typename T>
+Vector<T> gather( std::span<const T> s,
+	std::span<const std::uint32_t> positions,
+	parallel::ThreadPool& pool )
+{
+	if ( positions.empty() )
+	{
+		return Vector<T>{1};
+	}
+	Vector<T> out{positions.size(), s[positions[0]]};
+	parallel::parallelTransform( positions, out.asSpan(), [s]( std::uint32_t pos ) -> const T&
+		{
+			return s[pos];
+		}, 0, pool );
+	return out;
+}
+
+}//detail
+
+
+//============================================================
+//	\class	Index<T, Hash, Eq>
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 06:00
+//
+//	\brief	the distinct keys of a span, numbered 0 .. getDistinctCount() - 1
+//			keeps a copy of every distinct key, so find() works after the span is gone
+//			getFirsts()[id] is the position where key `id` first occurs; with
+//				Order::FirstSeen the ids follow those positions, so they ascend
+//			pass `ids` to also get the id of every input element
+//=============================================================
+template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<>>
+class Index
+{
+	using Table = detail::FlatTable<T, Hash, Eq>;
+
+	std::unique_ptr<Table[]> m_tables;
+	std::size_t m_nTables;
+	unsigned m_shift;					// partition = hash >> m_shift
+	Vector<std::uint32_t> m_bases;		// first id of every partition
+	Vector<std::uint32_t> m_rank;		// FirstSeen id of a partition ordered id, empty if they coincide
+	Vector<std::uint32_t> m_firsts;
+
+	std::size_t partitionOf( std::uint64_t h ) const noexcept
+	{
+		return m_nTables == 1 ?
+			0 :
+			static_cast<std::size_t>( h >> m_shift );
+	}
+
+	static std::size_t partitionsFor( std::size_t n,
+		std::size_t nThreads ) noexcept
+	{
+		if ( n < detail::partitionThreshold )
+		{
+			return 1;
+		}
+		const std::size_t forCache = n * 2 * Table::slotSize / detail::tableBytesPerPartition;
+		const std::size_t forThreads = nThreads > 1 ?
+			4 * nThreads :
+			1;
+		return std::min( std::bit_ceil( std::max<std::size_t>( { forCache, forThreads, 1 } ) ), detail::maxPartitions );
+	}
+
+	void buildSequential( std::span<const T> keys,
+		Vector<std::uint32_t>* ids )
+	{
+		Table& table = m_tables[0];
+		for ( std::size_t i = 0; i < keys.size(); ++i )
+		{
+			bool inserted;
+			const std::uint32_t id = table.insert( keys[i], detail::hashOf<Hash>( keys[i] ), inserted );
+			if ( inserted )
+			{
+				m_firsts.pushBack( static_cast<std::uint32_t>( i ) );
+			}
+			if ( ids )
+			{
+				( *ids )[i] = id;
+			}
+		}
+		m_bases.pushBack( 0 );
+	}
+
+	void buildPartitioned( std::span<const T> keys,
+		Order order,
+		Vector<std::uint32_t>* ids,
+		parallel::ThreadPool& pool )
+	{
+		const std::size_t n = keys.size();
+		const std::size_t nParts = m_nTables;
+		const parallel::Chunking<T> chunks{keys.data(), n, n / ( 4 * ( pool.getThreadCount() + 1 ) ), pool.getThreadCount() + 1};
+		const std::size_t nChunks = chunks.getCount();
+
+		// 1. per chunk histograms, laid out [chunk][partition]
+		Vector<std::size_t> cursors{nChunks * nParts, 0};
+		pool.forkJoin( nChunks, [&]( std::size_t c )
+			{
+				std::size_t* hist = cursors.data() + c * nParts;
+				for ( std::size_t i = chunks.begin( c ), e = chunks.end( c ); i < e; ++i )
+				{
+					++hist[partitionOf( detail::hashOf<Hash>( keys[i] ) )];
+				}
+			}
+		);
+		// 2. partition p, chunk c starts after all of partition < p and of partition p in chunks < c,
+		//	so every partition lists its positions in ascending order; the keys are copied along,
+		//	so step 3 reads both sequentially instead of gathering from `keys`
+		Vector<std::size_t> partBegin{nParts + 1, 0};
+		std::size_t running = 0;
+		for ( std::size_t p = 0; p < nParts; ++p )
+		{
+			partBegin[p] = running;
+			for ( std::size_t c = 0; c < nChunks; ++c )
+			{
+				const std::size_t count = cursors[c * nParts + p];
+				cursors[c * nParts + p] = running;
+				running += count;
+			}
+		}
+		partBegin[nParts] = n;
+		Vector<std::uint32_t> positions{n, 0};
+		Vector<T> scattered{n, keys[0]};
+		pool.forkJoin( nChunks, [&]( std::size_t c )
+			{
+				std::size_t* cursor = cursors.data() + c * nParts;
+				for ( std::size_t i = chunks.begin( c ), e = chunks.end( c ); i < e; ++i )
+				{
+					const std::size_t k = cursor[partitionOf( detail::hashOf<Hash>( keys[i] ) )]++;
+					positions[k] = static_cast<std::uint32_t>( i );
+					scattered[k] = keys[i];
+				}
+			}
+		);
+		// 3. a table per partition; ids are partition local for now
+		Vector<Vector<std::uint32_t>> firsts{nParts, Vector<std::uint32_t>{1}};
+		pool.forkJoin( nParts, [&]( std::size_t p )
+			{
+				Table& table = m_tables[p];
+				table = Table{( partBegin[p + 1] - partBegin[p] ) / 4};
+				for ( std::size_t k = partBegin[p]; k < partBegin[p + 1]; ++k )
+				{
+					const std::uint32_t pos = positions[k];
+					bool inserted;
+					const std::uint32_t id = table.insert( scattered[k], detail::hashOf<Hash>( scattered[k] ), inserted );
+					if ( inserted )
+					{
+						firsts[p].pushBack( pos );
+					}
+					if ( ids )
+					{
+						( *ids )[pos] = id;
+					}
+				}
+			}
+		);
+		std::uint32_t total = 0;
+		for ( std::size_t p = 0; p < nParts; ++p )
+		{
+			m_bases.pushBack( total );
+			total += m_tables[p].getCount();
+		}
+		m_firsts = Vector<std::uint32_t>{std::max<std::uint32_t>( total, 1 ), 0};
+		pool.forkJoin( nParts, [&]( std::size_t p )
+			{
+				std::copy( firsts[p].cbegin(), firsts[p].cend(), m_firsts.begin() + m_bases[p] );
+			}
+		);
+		if ( total == 0 )
+		{
+			m_firsts.clear();
+		}
+
+		// 4. FirstSeen: the first occurrences in input order are the new numbering
+		if ( order == Order::FirstSeen && total > 0 )
+		{
+			Vector<std::uint8_t> isFirst{n, 0};
+			parallel::parallelForEach( m_firsts.asSpan(), [&isFirst]( std::uint32_t pos )
+				{
+					isFirst[pos] = 1;
+				}, 0, pool );
+			Vector<std::uint32_t> ordered = detail::compact<std::uint32_t>( isFirst.data(), n,
+				[&isFirst]( std::size_t i )
+				{
+					return isFirst[i] != 0;
+				},
+				[]( std::size_t i )
+				{
+					return static_cast<std::uint32_t>( i );
+				}, pool );
+			m_rank = Vector<std::uint32_t>{total, 0};
+			parallel::parallelForEach( ordered.asSpan(), [&, base = ordered.data()]( std::uint32_t& pos )
+				{
+					const std::uint64_t h = detail::hashOf<Hash>( keys[pos] );
+					const std::size_t p = partitionOf( h );
+					m_rank[m_bases[p] + m_tables[p].find( keys[pos], h )] = static_cast<std::uint32_t>( &pos - base );
+				}, 0, pool );
+			m_firsts = std::move( ordered );
+		}
+		// 5. final ids
+		if ( ids )
+		{
+			pool.forkJoin( nParts, [&]( std::size_t p )
+				{
+					for ( std::size_t k = partBegin[p]; k < partBegin[p + 1]; ++k )
+					{
+						std::uint32_t& id = ( *ids )[positions[k]];
+						id += m_bases[p];
+						if ( !m_rank.isEmpty() )
+						{
+							id = m_rank[id];
+						}
+					}
+				}
+			);
+		}
+	}
+public:
+	// ids, if given, is (re)sized to keys.size()
+	explicit Index( std::span<const T> keys,
+		Order order = Order::Any,
+		Vector<std::uint32_t>* ids = nullptr,
+		parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+		:
+		m_tables{},
+		m_nTables{partitionsFor( keys.size(), pool.getThreadCount() + 1 )},
+		m_shift{64u - static_cast<unsigned>( std::countr_zero( m_nTables ) )},
+		m_bases{std::max<std::size_t>( m_nTables, 1 )},
+		m_rank{1},
+		m_firsts{m_nTables == 1 ? std::max<std::size_t>( keys.size(), 1 ) : 1}
+	{
+		assert( keys.size() < detail::npos );
+		if ( ids )
+		{
+			*ids = Vector<std::uint32_t>{std::max<std::size_t>( keys.size(), 1 ), 0};
+			if ( keys.empty() )
+			{
+				ids->clear();
+			}
+		}
+		if ( m_nTables == 1 )
+		{
+			m_tables = std::make_unique<Table[]>( 1 );
+			m_tables[0] = Table{keys.size()};
+			buildSequential( keys, ids );
+		}
+		else
+		{
+			m_tables = std::make_unique<Table[]>( m_nTables );
+			buildPartitioned( keys, order, ids, pool );
+		}
+	}
+	template<typename Alloc, typename ErrorPolicy>
+	explicit Index( const Vector<T, Alloc, ErrorPolicy>& keys,
+		Order order = Order::Any,
+		Vector<std::uint32_t>* ids = nullptr,
+		parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+		:
+		Index(keys.asSpan(), order, ids, pool)
+	{
+
+	}
+
+	// id of key, npos if it did not occur
+	std::uint32_t find( const T& key ) const noexcept
+	{
+		const std::uint64_t h = detail::hashOf<Hash>( key );
+		const std::size_t p = partitionOf( h );
+		const std::uint32_t local = m_tables[p].find( key, h );
+		if ( local == detail::npos )
+		{
+			return detail::npos;
+		}
+		return m_rank.isEmpty() ?
+			m_bases[p] + local :
+			m_rank[m_bases[p] + local];
+	}
+
+	bool contains( const T& key ) const noexcept
+	{
+		return find( key ) != detail::npos;
+	}
+
+	std::span<const std::uint32_t> getFirsts() const noexcept
+	{
+		return m_firsts.asSpan();
+	}
+
+	std::size_t getDistinctCount() const noexcept
+	{
+		return m_firsts.getSize();
+	}
+
+	std::size_t getPartitionCount() const noexcept
+	{
+		return m_nTables;
+	}
+};
+
+
+//============================================================
+//	\class	Groups<Key, T>
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 06:00
+//
+//	\brief	groupBy's result: the elements stored group after group, each group in
+//				input order, with the group's key and start offset alongside
+//=============================================================
+template<typename Key, typename T>
+class Groups
+{
+	Vector<Key> m_keys;
+	Vector<std::size_t> m_offsets;	// getCount() + 1 entries
+	Vector<T> m_items;
+public:
+	Groups( Vector<Key> keys,
+		Vector<std::size_t> offsets,
+		Vector<T> items )
+		:
+		m_keys{std::move( keys )},
+		m_offsets{std::move( offsets )},
+		m_items{std::move( items )}
+	{
+
+	}
+
+	std::span<const T> operator[]( std::size_t group ) const noexcept
+	{
+		return std::span<const T>{m_items.data() + m_offsets[group], m_offsets[group + 1] - m_offsets[group]};
+	}
+
+	const Key& getKey( std::size_t group ) const noexcept
+	{
+		return m_keys[group];
+	}
+
+	std::span<const Key> keys() const noexcept
+	{
+		return m_keys.asSpan();
+	}
+
+	std::size_t getCount() const noexcept
+	{
+		return m_keys.getSize();
+	}
+};
+
+
+// the distinct elements of s
+template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<>>
+Vector<T> dedup( std::span<const T> s,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	const Index<T, Hash, Eq> index{s, order, nullptr, pool};
+	return detail::gather( s, index.getFirsts(), pool );
+}
+
+template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<>>
+std::size_t countDistinct( std::span<const T> s,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return Index<T, Hash, Eq>{s, Order::Any, nullptr, pool}.getDistinctCount();
+}
+
+// groups the elements of s by keyFn( element ); FirstSeen orders the groups by their first element
+template<typename T, typename KeyFn>
+auto groupBy( std::span<const T> s,
+	KeyFn keyFn,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	using Key = std::decay_t<std::invoke_result_t<KeyFn&, const T&>>;
+	Vector<Key> keys{std::max<std::size_t>( s.size(), 1 ), Key{}};
+	parallel::parallelTransform( s, keys.asSpan(), std::move( keyFn ), 0, pool );
+	if ( s.empty() )
+	{
+		keys.clear();
+	}
+	Vector<std::uint32_t> ids{1};
+	const Index<Key> index{keys.asSpan(), order, &ids, pool};
+	const std::size_t nGroups = index.getDistinctCount();
+
+	Vector<std::size_t> offsets{nGroups + 1, 0};
+	for ( const std::uint32_t id : ids )
+	{
+		++offsets[id + 1];
+	}
+	for ( std::size_t g = 0; g < nGroups; ++g )
+	{
+		offsets[g + 1] += offsets[g];
+	}
+	Vector<T> items{1};
+	if ( !s.empty() )
+	{
+		// a stable counting sort on the ids
+		items = Vector<T>{s.size(), s[0]};
+		Vector<std::size_t> cursor{offsets};
+		for ( std::size_t i = 0; i < s.size(); ++i )
+		{
+			items[cursor[ids[i]]++] = s[i];
+		}
+	}
+	return Groups<Key, T>{detail::gather( std::span<const Key>{keys.asSpan()}, index.getFirsts(), pool ), std::move( offsets ), std::move( items )};
+}
+
+namespace detail
+{
+
+// distinct elements of a that do (keep = true) or don't occur in b
+template<typename T, typename Hash, typename Eq>
+Vector<T> filterDistinct( std::span<const T> a,
+	std::span<const T> b,
+	bool keep,
+	Order order,
+	parallel::ThreadPool& pool )
+{
+	const Index<T, Hash, Eq> inB{b, Order::Any, nullptr, pool};
+	const Vector<T> distinct = gather( a, Index<T, Hash, Eq>{a, order, nullptr, pool}.getFirsts(), pool );
+	return compact<T>( distinct.data(), distinct.getSize(),
+		[&]( std::size_t i )
+		{
+			return inB.contains( distinct[i] ) == keep;
+		},
+		[&]( std::size_t i ) -> const T&
+		{
+			return distinct[i];
+		}, pool );
+}
+
+}//detail
+
+// distinct elements of a that occur in b
+template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<>>
+Vector<T> setIntersection( std::span<const T> a,
+	std::span<const T> b,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return detail::filterDistinct<T, Hash, Eq>( a, b, true, order, pool );
+}
+
+// distinct elements of a that do not occur in b
+template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<>>
+Vector<T> setDifference( std::span<const T> a,
+	std::span<const T> b,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return detail::filterDistinct<T, Hash, Eq>( a, b, false, order, pool );
+}
+
+// distinct elements of a, then those of b not in a
+template<typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<>>
+Vector<T> setUnion( std::span<const T> a,
+	std::span<const T> b,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	Vector<T> out = detail::gather( a, Index<T, Hash, Eq>{a, order, nullptr, pool}.getFirsts(), pool );
+	const Vector<T> onlyB = detail::filterDistinct<T, Hash, Eq>( b, std::span<const T>{out.asSpan()}, false, order, pool );
+	out.append( onlyB.data(), onlyB.data() + onlyB.getSize() );
+	return out;
+}
+
+
+// Vector overloads
+template<typename T, typename Alloc, typename ErrorPolicy>
+Vector<T> dedup( const Vector<T, Alloc, ErrorPolicy>& v,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return dedup( v.asSpan(), order, pool );
+}
+
+template<typename T, typename Alloc, typename ErrorPolicy>
+std::size_t countDistinct( const Vector<T, Alloc, ErrorPolicy>& v,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return countDistinct( v.asSpan(), pool );
+}
+
+template<typename T, typename Alloc, typename ErrorPolicy, typename KeyFn>
+auto groupBy( const Vector<T, Alloc, ErrorPolicy>& v,
+	KeyFn keyFn,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return groupBy( v.asSpan(), std::move( keyFn ), order, pool );
+}
+
+template<typename T, typename AllocA, typename ErrorPolicyA, typename AllocB, typename ErrorPolicyB>
+Vector<T> setIntersection( const Vector<T, AllocA, ErrorPolicyA>& a,
+	const Vector<T, AllocB, ErrorPolicyB>& b,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return setIntersection( a.asSpan(), b.asSpan(), order, pool );
+}
+
+template<typename T, typename AllocA, typename ErrorPolicyA, typename AllocB, typename ErrorPolicyB>
+Vector<T> setDifference( const Vector<T, AllocA, ErrorPolicyA>& a,
+	const Vector<T, AllocB, ErrorPolicyB>& b,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return setDifference( a.asSpan(), b.asSpan(), order, pool );
+}
+
+template<typename T, typename AllocA, typename ErrorPolicyA, typename AllocB, typename ErrorPolicyB>
+Vector<T> setUnion( const Vector<T, AllocA, ErrorPolicyA>& a,
+	const Vector<T, AllocB, ErrorPolicyB>& b,
+	Order order = Order::FirstSeen,
+	parallel::ThreadPool& pool = parallel::ThreadPool::instance() )
+{
+	return setUnion( a.asSpan(), b.asSpan(), order, pool );
+}
+
+}//hashed
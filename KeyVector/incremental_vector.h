@@ -0,0 +1,396 @@
+#pragma once
+
+#include <memory>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <span>
+#include <cstdint>
+#include "custom_exception.h"
+#include "relocation.h"
+#if defined __linux__
+#	include <sys/mman.h>
+#endif
+
+
+//============================================================
+//	\class	IncrementalVector<T, Alloc>
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 03:00
+//
+//	\brief	growable array whose growth is amortized over the pushes that follow it
+//			when full, a buffer twice as big is allocated but nothing is copied; new
+//				elements go straight to it and every later push migrates the next
+//				`migrationStep` old elements, so no single push pays for the whole copy
+//			while growing, the elements [m_migrated, m_oldSize) still live in the old
+//				buffer & everything else in the new one; indexing picks the right one
+//			with a step >= 1 the migration ends before the new buffer fills up, so at
+//				most two buffers ever coexist
+//			freeing a large buffer unmaps all of its pages at once (~8 ms per 128 MiB), so
+//				with std::allocator on Linux the pages of the old buffer are handed back
+//				(madvise) 64 KiB at a time as the migration passes them
+//			linearize() finishes an ongoing migration and returns the contiguous span
+//=============================================================
+template<class T, class Alloc = std::allocator<T>>
+class IncrementalVector
+{
+	using AllocTraits = std::allocator_traits<Alloc>;
+
+	Alloc m_alloc;
+	std::size_t m_size;
+	std::size_t m_capacity;
+	T* m_pData;
+	// while growing
+	T* m_pOld;
+	std::size_t m_oldCapacity;
+	std::size_t m_oldSize;
+	std::size_t m_migrated;
+	std::uintptr_t m_releasedUpTo;	// old buffer pages before this address are already returned
+	std::size_t m_migrationStep;
+
+	static constexpr std::uintptr_t pageSize = 4096;
+	static constexpr std::uintptr_t releaseGranularity = 1ull << 16;
+	static constexpr std::size_t releaseThreshold = 1ull << 20;	// smaller buffers free fast enough
+public:
+	using value_type = typename AllocTraits::value_type;
+	using size_type = typename AllocTraits::size_type;
+	using difference_type = typename AllocTraits::difference_type;
+	using reference = T&;
+	using const_reference = const T&;
+	using allocator_type = Alloc;
+private:
+	T* locate( std::size_t i ) const noexcept
+	{
+		return m_pOld && i >= m_migrated && i < m_oldSize ?
+			m_pOld + i :
+			m_pData + i;
+	}
+
+	// copies instead of moving if T's move may throw (see relocation.h); the old buffer is intact if it does
+	void migrate( std::size_t count ) noexcept( relocation::isNothrow<T> )
+	{
+		const std::size_t n = std::min( count, m_oldSize - m_migrated );
+		relocation::relocate( m_pData + m_migrated, m_pOld + m_migrated, n );
+		m_migrated += n;
+		if ( m_migrated == m_oldSize )
+		{
+			AllocTraits::deallocate( m_alloc, m_pOld, m_oldCapacity );
+			m_pOld = nullptr;
+			return;
+		}
+		releaseMigrated();
+	}
+
+	void releaseMigrated() noexcept
+	{
+#if defined __linux__
+		if constexpr ( std::is_same_v<Alloc, std::allocator<T>> )
+		{
+			const std::uintptr_t end = reinterpret_cast<std::uintptr_t>( m_pOld + m_migrated ) & ~( pageSize - 1 );
+			if ( m_oldCapacity * sizeof( T ) >= releaseThreshold && end >= m_releasedUpTo + releaseGranularity )
+			{
+				::madvise( reinterpret_cast<void*>( m_releasedUpTo ), end - m_releasedUpTo, MADV_DONTNEED );
+				m_releasedUpTo = end;
+			}
+		}
+#endif
+	}
+
+	void startGrowth( std::size_t newCapacity )
+	{
+		assert( !m_pOld );
+		T* pNew = AllocTraits::allocate( m_alloc, newCapacity );
+		if ( m_size == 0 )
+		{
+			AllocTraits::deallocate( m_alloc, m_pData, m_capacity );
+		}
+		else
+		{
+			m_pOld = m_pData;
+			m_oldCapacity = m_capacity;
+			m_oldSize = m_size;
+			m_migrated = 0;
+			m_releasedUpTo = ( reinterpret_cast<std::uintptr_t>( m_pOld ) + pageSize - 1 ) & ~( pageSize - 1 );
+		}
+		m_pData = pNew;
+		m_capacity = newCapacity;
+	}
+public:
+	IncrementalVector()
+		:
+		IncrementalVector(64)
+	{
+
+	}
+
+	// migrationStep: old elements moved per push while growing (at least 1)
+	explicit IncrementalVector( std::size_t capacity,
+		std::size_t migrationStep = 4 )
+		:
+		m_alloc{},
+		m_size{0},
+		m_capacity{std::max<std::size_t>( capacity, 1 )},
+		m_pData{AllocTraits::allocate( m_alloc, m_capacity )},
+		m_pOld{nullptr},
+		m_oldCapacity{0},
+		m_oldSize{0},
+		m_migrated{0},
+		m_releasedUpTo{0},
+		m_migrationStep{std::max<std::size_t>( migrationStep, 1 )}
+	{
+
+	}
+
+	~IncrementalVector() noexcept
+	{
+		clear();
+		if ( m_pData )
+		{
+			AllocTraits::deallocate( m_alloc, m_pData, m_capacity );
+		}
+	}
+
+	IncrementalVector( const IncrementalVector& rhs )
+		:
+		IncrementalVector(rhs.m_capacity, rhs.m_migrationStep)
+	{
+		for ( std::size_t i = 0; i < rhs.m_size; ++i )
+		{
+			pushBack( rhs[i] );
+		}
+	}
+
+	IncrementalVector& operator=( const IncrementalVector& rhs )
+	{
+		IncrementalVector temp{rhs};
+		temp.swap( *this );
+		return *this;
+	}
+
+	IncrementalVector( IncrementalVector&& rhs ) noexcept
+		:
+		m_alloc{},
+		m_size{0},
+		m_capacity{0},
+		m_pData{nullptr},
+		m_pOld{nullptr},
+		m_oldCapacity{0},
+		m_oldSize{0},
+		m_migrated{0},
+		m_releasedUpTo{0},
+		m_migrationStep{rhs.m_migrationStep}
+	{
+		rhs.swap( *this );
+	}
+
+	IncrementalVector& operator=( IncrementalVector&& rhs ) noexcept
+	{
+		IncrementalVector temp{std::move( rhs )};
+		temp.swap( *this );
+		return *this;
+	}
+
+	void swap( IncrementalVector& rhs ) noexcept
+	{
+		std::swap( m_size, rhs.m_size );
+		std::swap( m_capacity, rhs.m_capacity );
+		std::swap( m_pData, rhs.m_pData );
+		std::swap( m_pOld, rhs.m_pOld );
+		std::swap( m_oldCapacity, rhs.m_oldCapacity );
+		std::swap( m_oldSize, rhs.m_oldSize );
+		std::swap( m_migrated, rhs.m_migrated );
+		std::swap( m_releasedUpTo, rhs.m_releasedUpTo );
+		std::swap( m_migrationStep, rhs.m_migrationStep );
+	}
+
+	template<typename... TArgs>
+	T& emplaceBack( TArgs&&... args )
+	{
+		if ( m_size == m_capacity )
+		{
+			startGrowth( std::max<std::size_t>( m_capacity << 1ull, 1 ) );	// a moved-from vector has no capacity
+		}
+		T* p = ::new ( m_pData + m_size ) T(std::forward<TArgs>( args )...);
+		++m_size;
+		if ( m_pOld )
+		{
+#ifdef KEYVECTOR_EXCEPTIONS
+			if constexpr ( !relocation::isNothrow<T> )
+			{
+				try
+				{
+					migrate( m_migrationStep );
+				}
+				catch ( ... )
+				{
+					// a failed migration step takes the push back with it
+					--m_size;
+					p->~T();
+					throw;
+				}
+			}
+			else
+			{
+				migrate( m_migrationStep );
+			}
+#else
+			migrate( m_migrationStep );
+#endif
+		}
+		return *p;
+	}
+
+	void pushBack( const T& val )
+	{
+		emplaceBack( val );
+	}
+	void pushBack( T&& val )
+	{
+		emplaceBack( std::move( val ) );
+	}
+
+	void popBack() noexcept
+	{
+		--m_size;
+		locate( m_size )->~T();
+		if ( m_pOld && m_size < m_oldSize )
+		{
+			m_oldSize = std::max( m_size, m_migrated );
+			migrate( 0 );	// releases the old buffer if nothing is left in it
+		}
+	}
+
+	void clear() noexcept
+	{
+		if constexpr ( !std::is_trivially_destructible_v<T> )
+		{
+			for ( std::size_t i = 0; i < m_size; ++i )
+			{
+				locate( i )->~T();
+			}
+		}
+		if ( m_pOld )
+		{
+			AllocTraits::deallocate( m_alloc, m_pOld, m_oldCapacity );
+			m_pOld = nullptr;
+		}
+		m_size = 0;
+	}
+
+	// completes an ongoing migration in one go
+	void finishGrowth() noexcept( relocation::isNothrow<T> )
+	{
+		if ( m_pOld )
+		{
+			migrate( m_oldSize );
+		}
+	}
+
+	// grows eagerly to at least newCapacity, never shrinks
+	void reserve( std::size_t newCapacity )
+	{
+		if ( newCapacity > m_capacity )
+		{
+			finishGrowth();
+			T* pNew = AllocTraits::allocate( m_alloc, newCapacity );
+#ifdef KEYVECTOR_EXCEPTIONS
+			try
+			{
+				relocation::relocate( pNew, m_pData, m_size );
+			}
+			catch ( ... )
+			{
+				AllocTraits::deallocate( m_alloc, pNew, newCapacity );
+				throw;
+			}
+#else
+			relocation::relocate( pNew, m_pData, m_size );
+#endif
+			AllocTraits::deallocate( m_alloc, m_pData, m_capacity );
+			m_pData = pNew;
+			m_capacity = newCapacity;
+		}
+	}
+
+	std::span<T> linearize() noexcept( relocation::isNothrow<T> )
+	{
+		finishGrowth();
+		return std::span<T>{m_pData, m_size};
+	}
+
+	// true while the old buffer still holds elements
+	bool isGrowing() const noexcept
+	{
+		return m_pOld != nullptr;
+	}
+
+	T& operator[]( std::size_t index ) noexcept
+	{
+		return *locate( index );
+	}
+	const T& operator[]( std::size_t index ) const noexcept
+	{
+		return *locate( index );
+	}
+	T& at( std::size_t index )
+	{
+		if ( index < m_size )
+		{
+			return *locate( index );
+		}
+		throwException( "IncrementalVector index out of bounds." );
+	}
+
+	T& front() noexcept
+	{
+		return *locate( 0 );
+	}
+	const T& cfront() const noexcept
+	{
+		return *locate( 0 );
+	}
+	T& back() noexcept
+	{
+		return *locate( m_size - 1 );
+	}
+	const T& cback() const noexcept
+	{
+		return *locate( m_size - 1 );
+	}
+
+	// visits every element in order, a segment at a time
+	template<typename F>
+	void forEach( F&& fn )
+	{
+		if ( !m_pOld )
+		{
+			std::for_each( m_pData, m_pData + m_size, fn );
+			return;
+		}
+		std::for_each( m_pData, m_pData + m_migrated, fn );
+		std::for_each( m_pOld + m_migrated, m_pOld + m_oldSize, fn );
+		std::for_each( m_pData + m_oldSize, m_pData + m_size, fn );
+	}
+
+	bool isEmpty() const noexcept
+	{
+		return m_size == 0;
+	}
+	std::size_t getSize() const noexcept
+	{
+		return m_size;
+	}
+	std::size_t getCapacity() const noexcept
+	{
+		return m_capacity;
+	}
+};
+
+template <typename T, typename Alloc>
+void swap( IncrementalVector<T, Alloc>& lhs,
+	IncrementalVector<T, Alloc>& rhs ) noexcept
+{
+	lhs.swap( rhs );
+}
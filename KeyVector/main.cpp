@@ -1,6 +1,33 @@
 #include <string>
 #include <cassert>
 #include "vector.h"
+#include "compressed_vector.h"
+#include "numa.h"
+#include "circular_vector.h"
+#include "buffer_cache.h"
+#include "shared_memory.h"
+#include "slot_map.h"
+#include "parallel.h"
+#include "tracked_vector.h"
+#include "search_index.h"
+#include "string_vector.h"
+#include "rcu_vector.h"
+#include "incremental_vector.h"
+#include "sparse_vector.h"
+#include "md_vector.h"
+#include "hash_ops.h"
+#include "selection.h"
+#include "async_channel.h"
+#include <thread>
+#include <span>
+#include <ranges>
+#include <numeric>
+#include <latch>
+#include <sstream>
+#include <iomanip>
+#ifdef BENCHMARK
+#	include "benchmarks.h"
+#endif
 #if defined _DEBUG && !defined NDEBUG
 #	pragma comment( lib, "C:/Program Files (x86)/Visual Leak Detector/lib/Win64/vld.lib" )
 #	include <C:/Program Files (x86)/Visual Leak Detector/include/vld.h>
@@ -12,6 +39,117 @@ struct MyStruct
 	int i;
 };
 
+// element & allocation counters for the lifecycle tier checks
+struct Tally
+{
+	static inline int copies = 0;
+	static inline int moves = 0;
+	static inline int destroyed = 0;
+	static inline int allocations = 0;
+
+	static void reset() noexcept
+	{
+		copies = moves = destroyed = allocations = 0;
+	}
+};
+
+template<bool NothrowMove>
+struct Counted
+{
+	int value;
+
+	Counted( int v ) noexcept
+		:
+		value{v}
+	{
+
+	}
+	Counted( const Counted& rhs ) noexcept
+		:
+		value{rhs.value}
+	{
+		++Tally::copies;
+	}
+	Counted( Counted&& rhs ) noexcept( NothrowMove )
+		:
+		value{rhs.value}
+	{
+		++Tally::moves;
+	}
+	Counted& operator=( const Counted& rhs ) noexcept
+	{
+		value = rhs.value;
+		++Tally::copies;
+		return *this;
+	}
+	~Counted() noexcept
+	{
+		++Tally::destroyed;
+	}
+};
+
+template<typename T>
+struct CountingAllocator
+{
+	using value_type = T;
+
+	T* allocate( std::size_t n )
+	{
+		++Tally::allocations;
+		return std::allocator<T>{}.allocate( n );
+	}
+	void deallocate( T* p,
+		std::size_t n ) noexcept
+	{
+		std::allocator<T>{}.deallocate( p, n );
+	}
+	bool operator==( const CountingAllocator& ) const noexcept
+	{
+		return true;
+	}
+};
+
+
+// channel smoke test coroutines; the last producer to finish closes the channel
+coro::Task<> produceRange( coro::Channel<int>& channel,
+	int first,
+	int last,
+	std::atomic<int>& producersLeft )
+{
+	auto producer = channel.makeProducer();
+	for ( int i = first; i < last; ++i )
+	{
+		co_await producer.push( i );
+	}
+	co_await producer.flush();
+	if ( --producersLeft == 0 )
+	{
+		channel.close();
+	}
+}
+
+coro::Task<int> countOf( const Vector<int>& batch )
+{
+	co_return static_cast<int>( batch.getSize() );
+}
+
+coro::Task<> consumeAll( coro::Channel<int>& channel,
+	Vector<int>& received,
+	int& batches,
+	std::latch* done )
+{
+	while ( std::optional<Vector<int>> batch = co_await channel.nextBatch() )
+	{
+		batches += co_await countOf( *batch ) > 0;
+		received.append( *batch );
+		channel.recycle( std::move( *batch ) );
+	}
+	if ( done )
+	{
+		done->count_down();
+	}
+}
+
 
 int main()
 {
@@ -190,6 +328,821 @@ int main()
 			<< '\n';
 	}
 
+	std::cout << "packed & delta encoded vectors" << '\n';
+	Vector<std::uint64_t> ids;
+	for ( std::uint64_t i = 0; i < 1000; ++i )
+	{
+		ids.pushBack( 1000 + i * 3 );
+	}
+	auto packed = PackedIntVector<std::uint64_t>::fromVector( ids );
+	assert( packed.getBitWidth() == 12 );
+	assert( packed[999] == ids[999] );
+	auto delta = DeltaVector<std::uint64_t>::fromVector( ids );
+	assert( delta.getSize() == 1000 );
+	assert( delta[500] == ids[500] );
+	assert( delta.lowerBound( 1001 ) == 1 );
+	assert( delta.lowerBound( 5000 ) == 1000 );
+	Vector<std::uint64_t> unpacked = delta.toVector();
+	assert( unpacked.getSize() == 1000 && unpacked[999] == ids[999] );
+	std::cout << "delta ratio=" << delta.compressionRatio() << '\n';
+
+	Vector<int> appended{v7};
+	appended.append( v9 );
+	assert( appended.getSize() == v7.getSize() + v9.getSize() );
+	assert( appended.back() == v9.back() );
+	Vector<std::wstring> wideCopy{2, L"w"};
+	wideCopy.append( v5 );
+	assert( wideCopy.getSize() == 2 + v5.getSize() );
+	// appending (part of) itself while growing reads the elements from the new buffer
+	Vector<int> selfAppended{4};
+	for ( int i = 0; i < 4; ++i )
+	{
+		selfAppended.pushBack( i );
+	}
+	selfAppended.append( selfAppended );
+	selfAppended.append( selfAppended.data() + 1, selfAppended.data() + 3 );
+	assert( selfAppended.getSize() == 10 && selfAppended[7] == 3 && selfAppended[8] == 1 && selfAppended[9] == 2 );
+	Vector<std::string> selfAppendedStrings{2};
+	selfAppendedStrings.pushBack( "first long enough to live on the heap" );
+	selfAppendedStrings.pushBack( "second" );
+	selfAppendedStrings.append( selfAppendedStrings );
+	selfAppendedStrings.pushBack( selfAppendedStrings[0] );
+	assert( selfAppendedStrings.getSize() == 5 && selfAppendedStrings[2] == selfAppendedStrings[0] && selfAppendedStrings[4] == selfAppendedStrings[0] );
+	Vector<std::string> selfEmplaced{1};
+	selfEmplaced.pushBack( "emplaced from itself, on the heap as well" );
+	selfEmplaced.emplaceBack( selfEmplaced[0] );
+	selfEmplaced.emplaceBack( selfEmplaced[1], 0, 8 );
+	assert( selfEmplaced.getSize() == 3 && selfEmplaced[1] == selfEmplaced[0] && selfEmplaced[2] == "emplaced" );
+	selfEmplaced.pushBack( "fills the capacity" );
+	selfEmplaced.pushBack( std::move( selfEmplaced[0] ) );
+	assert( selfEmplaced.getSize() == 5 && selfEmplaced[4] == selfEmplaced[1] );
+	while ( selfEmplaced.getSize() < selfEmplaced.getCapacity() )
+	{
+		selfEmplaced.pushBack( "padding" );
+	}
+	assert( selfEmplaced.tryPushBack( std::move( selfEmplaced[4] ) ) && selfEmplaced.getSize() == 9 && selfEmplaced[8] == selfEmplaced[1] );
+
+	Vector<int> numaVec{4096, 1};
+	numa::place( numaVec, numa::Placement::Interleaved );	// best effort
+	numa::parallelForEach( numaVec, []( int& x )
+		{
+			x *= 2;
+		}
+	);
+	assert( numaVec[0] == 2 && numaVec[4095] == 2 );
+
+	CircularVector<std::string> window{4};
+	for ( int i = 0; i < 6; ++i )
+	{
+		window.pushBack( std::to_string( i ) );
+		window.pushFront( std::to_string( -i ) );
+		window.popBack();
+	}
+	window.pushBack( "tail" );
+	assert( window.getSize() == 7 );
+	assert( window.cfront() == "-5" && window.cback() == "tail" );
+	auto linear = window.linearize();
+	assert( linear.size() == 7 && linear[0] == "-5" );
+	// moved-from rings are empty & reusable from either end; move assignment doesn't hand our elements to the source
+	CircularVector<std::string> movedWindow{std::move( window )};
+	window.pushFront( "front" );
+	window.pushBack( "back" );
+	assert( window.getSize() == 2 && window.cfront() == "front" && window.cback() == "back" );
+	CircularVector<std::string> emptied{std::move( movedWindow )};
+	movedWindow.pushBack( "only" );
+	assert( movedWindow.getSize() == 1 && movedWindow.cfront() == "only" );
+	window = std::move( emptied );
+	assert( window.getSize() == 7 && window.cback() == "tail" && emptied.getSize() == 0 );
+	// a full ring pushing its own elements builds the new one before relocating them
+	CircularVector<std::string> full{2};
+	full.pushBack( "front, long enough to live on the heap" );
+	full.pushBack( "back, long enough to live on the heap too" );
+	full.pushBack( full.cfront() );
+	assert( full.getSize() == 3 && full.cback() == full.cfront() );
+	full.pushBack( "fills the 4 slots" );
+	full.pushFront( full.cback() );
+	assert( full.getSize() == 5 && full.cfront() == "fills the 4 slots" && full[1] == full[3] );
+	// elements whose move may throw are copied on growth
+	struct ThrowingMove
+	{
+		int value;
+
+		explicit ThrowingMove( int x )
+			:
+			value{x}
+		{
+
+		}
+		ThrowingMove( const ThrowingMove& rhs ) = default;
+		ThrowingMove( ThrowingMove&& rhs )
+			:
+			value{rhs.value}
+		{
+			throwException( "ThrowingMove moved." );
+		}
+	};
+	CircularVector<ThrowingMove> copiedRing{1};
+	for ( int i = 0; i < 5; ++i )
+	{
+		const ThrowingMove element{i};
+		copiedRing.pushBack( element );
+	}
+	assert( copiedRing.getSize() == 5 && copiedRing[4].value == 4 );
+
+	SpscCircularVector<int> handoff{256};
+	std::thread producer{[&handoff]()
+		{
+			for ( int i = 0; i < 10000; ++i )
+			{
+				while ( !handoff.tryPushBack( i ) )
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+	};
+	for ( int expected = 0; expected < 10000; )
+	{
+		int got;
+		if ( handoff.tryPopFront( got ) )
+		{
+			assert( got == expected );
+			++expected;
+		}
+	}
+	producer.join();
+
+	for ( int i = 0; i < 4; ++i )
+	{
+		Vector<int, CachingAllocator<int>> cached;
+		cached.pushBack( i );
+		Vector<int, CachingAllocator<int>> copied{cached};
+		assert( copied[0] == i );
+	}
+	const BufferCacheStats cacheStats = ThreadBufferCache::stats();
+	assert( cacheStats.hits >= 6 );
+	std::cout << "buffer cache hits=" << cacheStats.hits << " misses=" << cacheStats.misses << '\n';
+
+	Vector<int, std::allocator<int>, ReturnError> checked{4};
+	checked.pushBack( 1 );
+	assert( checked.at( 0 ) && *checked.at( 0 ) == 1 );
+	assert( !checked.at( 1 ) && checked.at( 1 ).error() == VectorError::OutOfRange );	// within capacity, past size
+	assert( !v9.tryAt( v9.getSize() ) );
+	assert( v9.tryPushBack( 42 ) && v9.back() == 42 );
+	assert( v9.tryReserve( v9.getCapacity() * 4 ) && v9.back() == 42 );
+	assert( v9.tryReserve( std::numeric_limits<std::size_t>::max() ).error() == VectorError::LengthError );
+
+	std::span<int> v9Span = v9;
+	assert( v9Span.data() == v9.data() && v9Span.size() == v9.getSize() );
+	assert( std::ranges::find( v9, 42 ) == v9.end() - 1 );
+	const Vector<int>& v9Ref = v9;
+	assert( std::ranges::distance( v9Ref ) == static_cast<std::ptrdiff_t>( v9.getSize() ) );
+
+	Vector<int> numbers{3};
+	numbers.pushBack( -3 );
+	numbers.pushBack( 0 );
+	numbers.pushBack( 42 );
+	textio::BulkFormatter csv{textio::FormatOptions{",", false}};
+	assert( csv.toString( numbers ) == "-3,0,42" );
+	Expected<Vector<int>> parsed = Vector<int>::fromChars( " -3,0;42\n" );
+	assert( parsed && parsed->getSize() == 3 && ( *parsed )[2] == 42 );
+	assert( Vector<int>::fromChars( "1 2x 3" ).error() == VectorError::ParseError );
+	assert( Vector<std::int16_t>::fromChars( "40000" ).error() == VectorError::ParseError );
+	Vector<double> reals{std::size_t{2}};
+	reals.pushBack( 0.1 );
+	reals.pushBack( 2.5e-300 );
+	Expected<Vector<double>> realsBack = Vector<double>::fromChars( textio::BulkFormatter{}.toString( reals ) );
+	assert( realsBack && ( *realsBack )[0] == 0.1 && ( *realsBack )[1] == 2.5e-300 );
+	std::cout << numbers << '\n';
+	// stream flags the bulk formatter can't reproduce fall back to per element insertion
+	std::ostringstream hexOut;
+	hexOut << std::hex << std::showbase;
+	Vector<int> flagged{2};
+	flagged.pushBack( 255 );
+	flagged.pushBack( 16 );
+	flagged.print( hexOut );
+	assert( hexOut.str() == "0xff 0x10 " );
+	std::ostringstream pointOut;
+	pointOut << std::showpoint << std::setprecision( 3 );
+	Vector<double> two{1};
+	two.pushBack( 2.0 );
+	pointOut << two;
+	assert( pointOut.str() == "2.00 " );
+	std::ostringstream plainOut;
+	plainOut << flagged;
+	assert( plainOut.str() == "255 16 " );
+
+#if defined __linux__
+	{
+		shm::Segment segment = shm::Segment::createAnonymous( 1 << 20 );
+		shm::ScopedSegment allocateFrom{segment};
+		shm::SharedVector<int> table{1000};
+		for ( int i = 0; i < 1000; ++i )
+		{
+			table.pushBack( i * i );
+		}
+		shm::publish( segment, table );
+		// a 2nd, read only mapping of the same memory (as another process would see it)
+		shm::SharedVectorReader<int> reader{shm::Segment::fromFd( segment.getFd() )};
+		assert( reader.view().data() != table.data() && reader.view()[999] == 999 * 999 );
+		assert( reader.snapshot().getSize() == 1000 );
+		const std::uint64_t version = reader.getVersion();
+		segment.write( [&table]()
+			{
+				table[0] = -1;
+			}
+		);
+		assert( !reader.isCurrent( version ) && reader.read( []( std::span<const int> s ) { return s[0]; } ) == -1 );
+
+		// self relative pointers resolve in either mapping
+		auto* link = ::new ( segment.allocate( sizeof( shm::OffsetPtr<int> ), alignof( shm::OffsetPtr<int> ) ) ) shm::OffsetPtr<int>{table.data() + 1};
+		const auto* linkSeenByReader = reinterpret_cast<const shm::OffsetPtr<int>*>( reader.getSegment().base() + ( reinterpret_cast<std::byte*>( link ) - segment.base() ) );
+		assert( **linkSeenByReader == 1 && linkSeenByReader->get() != link->get() );
+	}
+#endif
+
+	SlotMap<std::string> names;
+	const SlotHandle alice = names.insert( "alice" );
+	const SlotHandle bob = names.insert( "bob" );
+	const SlotHandle carol = names.insert( "carol" );
+	assert( names.erase( alice ) && !names.erase( alice ) );
+	assert( !names.contains( alice ) && !names.find( alice ) && names[carol] == "carol" );
+	const SlotHandle dave = names.insert( "dave" );	// reuses alice's slot
+	assert( dave.index == alice.index && !names.contains( alice ) && names[dave] == "dave" );
+	assert( names.getSize() == 3 && names.values()[0] == "carol" && names[bob] == "bob" );
+	names.clear();
+	assert( names.isEmpty() && !names.contains( bob ) );
+
+	Vector<int> ints{128};
+	for ( int i = 0; i < 103; ++i )
+	{
+		ints.pushBack( i );
+	}
+	assert( ints.eraseIf( []( int x ) { return x % 3 == 0; } ) == 35 );	// 0, 3, .., 102
+	assert( ints.getSize() == 68 && ints[0] == 1 && ints[1] == 2 && ints[2] == 4 && ints.back() == 101 );
+	assert( *ints.erase( ints.cbegin() ) == 2 && ints.getSize() == 67 );
+	assert( ints.erase( ints.cbegin() + 1, ints.cbegin() + 3 ) == ints.begin() + 1 && ints[1] == 7 && ints.getSize() == 65 );
+	ints.swapRemove( 0 );
+	assert( ints[0] == 101 && ints.getSize() == 64 );
+	const std::size_t drop[] = {0, 1, 63};
+	ints.removeIndices( drop );
+	assert( ints.getSize() == 61 && ints[0] == 8 && ints[1] == 10 && ints.back() == 98 );
+
+	Vector<double> reals2{40};
+	for ( int i = 0; i < 37; ++i )
+	{
+		reals2.pushBack( i * 0.5 );
+	}
+	reals2.eraseIf( []( double x ) { return x > 3.0 && x < 15.0; } );
+	assert( reals2.getSize() == 14 && reals2[6] == 3.0 && reals2[7] == 15.0 );
+
+	Vector<std::string> words{8};
+	for ( const char* w : {"keep", "drop", "keep", "drop", "keep"} )
+	{
+		words.pushBack( w );
+	}
+	assert( words.eraseIf( []( const std::string& w ) { return w == "drop"; } ) == 2 && words.getSize() == 3 && words[2] == "keep" );
+
+	{
+		parallel::ThreadPool pool{3};
+		Vector<std::int64_t> series{100'003};
+		for ( std::int64_t i = 0; i < 100'003; ++i )
+		{
+			series.pushBack( i );
+		}
+		constexpr std::size_t grain = 1000;
+		assert( parallel::parallelReduce( series, std::int64_t{0}, std::plus<>{}, grain, pool ) == 100'002ll * 100'003 / 2 );
+		assert( parallel::parallelCountIf( series, []( std::int64_t x ) { return x % 7 == 0; }, grain, pool ) == 14'287 );
+		parallel::parallelForEach( series, []( std::int64_t& x ) { x = 1; }, grain, pool );
+		parallel::parallelInclusiveScan( series, std::plus<>{}, grain, pool );
+		assert( series[0] == 1 && series[50'000] == 50'001 && series.back() == 100'003 );
+		parallel::parallelTransform( series, []( std::int64_t x ) { return x - 1; }, grain, pool );
+		parallel::parallelExclusiveScan( series, std::int64_t{10}, std::plus<>{}, grain, pool );
+		assert( series[0] == 10 && series[1] == 10 && series[3] == 13 && series.back() == 10 + 100'001ll * 100'002 / 2 );
+		Vector<double> halves = parallel::parallelTransformed( series, []( std::int64_t x ) { return x * 0.5; }, grain, pool );
+		assert( halves.getSize() == series.getSize() && halves[0] == 5.0 );
+	}
+
+	{
+		Vector<int> seed{64, 0};
+		Vector<int> follower{seed};
+		TrackedVector<int> leader{seed};
+		leader[3] = 7;
+		leader[4] += 2;
+		leader[10] = 1;
+		leader[11] = 1;
+		const int fresh[] = {5, 6};
+		leader.write( 20, fresh, 2 );
+		leader.pushBack( 99 );
+		assert( leader.getDirtyRanges().getRangeCount() == 4 && leader.getDirtyRanges().getElementCount() == 7 );
+		Vector<std::byte> delta = leader.collectDelta();
+		assert( leader.getDirtyRanges().isEmpty() && delta.getSize() < 64 * sizeof( int ) );
+		assert( TrackedVector<int>::applyDelta( follower, delta.asSpan() ) );
+		assert( follower.getSize() == 65 && follower[3] == 7 && follower[4] == 2 && follower[21] == 6 && follower.back() == 99 );
+		leader.popBack();
+		leader.popBack();
+		assert( TrackedVector<int>::applyDelta( follower, leader.collectDelta().asSpan() ) && follower.getSize() == 63 );
+		delta.popBack();
+		assert( TrackedVector<int>::applyDelta( follower, delta.asSpan() ).error() == VectorError::ParseError && follower.getSize() == 63 );
+		// headers whose sizes the payload can't back: a range whose byte count wraps, a size nothing carries
+		auto craft = [&delta]( std::initializer_list<std::uint64_t> words )
+		{
+			Vector<std::byte> out{64};
+			out.append( delta.data(), delta.data() + sizeof( std::uint64_t ) );	// magic
+			for ( std::uint64_t word : words )
+			{
+				const std::byte* p = reinterpret_cast<const std::byte*>( &word );
+				out.append( p, p + sizeof( word ) );
+			}
+			return out;
+		};
+		const Vector<std::byte> wrapping = craft( {sizeof( int ), 1ull << 62, 1, 0, 1ull << 62} );
+		assert( TrackedVector<int>::applyDelta( follower, wrapping.asSpan() ).error() == VectorError::ParseError && follower.getSize() == 63 );
+		const Vector<std::byte> unbacked = craft( {sizeof( int ), 1ull << 40, 0} );
+		assert( TrackedVector<int>::applyDelta( follower, unbacked.asSpan() ).error() == VectorError::ParseError && follower.getSize() == 63 );
+	}
+
+	for ( std::size_t n : {0, 1, 7, 8, 9, 100, 1000, 4097} )
+	{
+		Vector<std::uint64_t> sortedKeys{n + 1};
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			sortedKeys.pushBack( 10 * ( i / 2 ) );	// pairs of duplicates
+		}
+		const search::EytzingerIndex<std::uint64_t> eytzinger{sortedKeys};
+		const search::StaticBTreeIndex<std::uint64_t> btree{sortedKeys};
+		Vector<std::uint64_t> queries{10 * n + 20};
+		Vector<std::size_t> expected{10 * n + 20};
+		for ( std::uint64_t x = 0; x < 5 * n + 20; ++x )
+		{
+			const std::size_t lb = static_cast<std::size_t>( std::lower_bound( sortedKeys.begin(), sortedKeys.end(), x ) - sortedKeys.begin() );
+			queries.pushBack( x );
+			expected.pushBack( lb == n ? search::npos : lb );
+			assert( eytzinger.lowerBound( x ) == expected.back() && btree.lowerBound( x ) == expected.back() );
+			const bool present = lb != n && sortedKeys[lb] == x;
+			assert( ( eytzinger.find( x ) != search::npos ) == present && ( btree.find( x ) != search::npos ) == present );
+		}
+		Vector<std::size_t> batched{queries.getSize(), 0};
+		eytzinger.lowerBound( queries.asSpan(), batched.asSpan() );
+		assert( std::equal( batched.begin(), batched.end(), expected.begin() ) );
+		btree.lowerBound( queries.asSpan(), batched.asSpan() );
+		assert( std::equal( batched.begin(), batched.end(), expected.begin() ) );
+	}
+	{
+		const std::uint32_t shuffled[] = {40, 10, 30, 20};
+		const auto index = search::StaticBTreeIndex<std::uint32_t>::fromUnsorted( shuffled );
+		assert( index.lowerBound( 25 ) == 2 && index.find( 10 ) == 1 && index.lowerBound( 41 ) == search::npos );
+		assert( search::EytzingerIndex<std::uint32_t>::fromUnsorted( shuffled ).lowerBound( 35 ) == 0 );
+	}
+
+	{
+		StringVector names;
+		assert( names.pushBack( "alpha" ) == 0 && names.pushBack( "" ) == 1 );
+		const std::string_view more[] = {"beta", "gamma"};
+		names.append( more );
+		names.appendSplit( "x,,yz", ',' );
+		assert( names.getSize() == 7 && names[0] == "alpha" && names[1].empty() && names.back() == "yz" );
+		assert( std::distance( names.begin(), names.end() ) == 7 && *( names.begin() + 3 ) == "gamma" );
+		StringVector interned{Interning::On};
+		for ( int i = 0; i < 1000; ++i )
+		{
+			interned.pushBack( std::to_string( i % 10 ) );
+		}
+		assert( interned.getSize() == 1000 && interned.getUniqueCount() == 10 && interned.getCharCount() == 10 );
+		interned.popBack();
+		assert( interned[998] == "8" && interned.pushBack( "9" ) == 999 && interned.getCharCount() == 10 );
+		WStringVector wide{Interning::On};
+		wide.appendSplit( L"a b a", L' ' );
+		assert( wide.getUniqueCount() == 2 && wide[2] == L"a" );
+		// re-pushing & splitting its own strings while the arena is full
+		StringVector arena{Interning::Off, 4, 8};
+		arena.pushBack( "ab,cd,ef" );
+		assert( arena.getCharCount() == 8 );
+		arena.pushBack( arena[0] );
+		arena.appendSplit( arena[1], ',' );
+		assert( arena.getSize() == 5 && arena[1] == "ab,cd,ef" && arena[2] == "ab" && arena[4] == "ef" );
+	}
+
+	{
+		// every published version holds `size` copies of its own size
+		RcuVector<std::size_t> table;
+		std::atomic<bool> done{false};
+		std::atomic<std::size_t> torn{0};
+		std::vector<std::thread> readers;
+		for ( int r = 0; r < 3; ++r )
+		{
+			readers.emplace_back( [&table, &done, &torn]
+				{
+					while ( !done.load() )
+					{
+						const auto snapshot = table.read();
+						const auto nested = table.read();
+						torn += std::any_of( snapshot.begin(), snapshot.end(), [n = snapshot.getSize()]( std::size_t x ) { return x != n; } );
+						torn += nested.getSize() < snapshot.getSize();
+					}
+				} );
+		}
+		for ( std::size_t n = 1; n <= 200; ++n )
+		{
+			table.update( [n]( Vector<std::size_t>& v )
+				{
+					std::fill( v.begin(), v.end(), n );
+					v.pushBack( n );
+				} );
+		}
+		done = true;
+		for ( std::thread& t : readers )
+		{
+			t.join();
+		}
+		assert( torn == 0 && table.read().getSize() == 200 && table.read()[199] == 200 );
+		assert( table.reclaim() == 0 );
+		Vector<std::size_t> fresh{4, 7};
+		table.assign( std::move( fresh ) );
+		assert( table.read().asSpan().size() == 4 && table.getRetiredCount() == 0 );
+	}
+
+	{
+		IncrementalVector<std::string> log{4, 1};
+		for ( int i = 0; i < 1000; ++i )
+		{
+			log.pushBack( std::to_string( i ) );
+			assert( log[i / 2] == std::to_string( i / 2 ) && log.back() == std::to_string( i ) );
+		}
+		assert( log.isGrowing() && log.getCapacity() == 1024 );	// 512 old elements, 1 migrated per push
+		for ( int i = 999; i >= 300; --i )
+		{
+			assert( log.back() == std::to_string( i ) );
+			log.popBack();
+		}
+		assert( !log.isGrowing() && log.getSize() == 300 && log[299] == "299" );
+		// moved-from vectors are empty & reusable; move assignment doesn't hand our elements to the source
+		IncrementalVector<std::string> moved{std::move( log )};
+		log.pushBack( "reused" );
+		assert( log.getSize() == 1 && log[0] == "reused" );
+		log = std::move( moved );
+		assert( log.getSize() == 300 && log[299] == "299" && moved.getSize() == 0 );
+		moved.pushBack( "again" );
+		assert( moved.getSize() == 1 && moved.back() == "again" );
+		IncrementalVector<ThrowingMove> copiedLog{1, 1};
+		for ( int i = 0; i < 100; ++i )
+		{
+			const ThrowingMove element{i};
+			copiedLog.pushBack( element );
+		}
+		copiedLog.reserve( 256 );
+		assert( copiedLog.getSize() == 100 && copiedLog[99].value == 99 && copiedLog.linearize()[50].value == 50 );
+		IncrementalVector<std::uint64_t> ids{1, 2};
+		std::uint64_t expected = 0;
+		for ( std::uint64_t i = 0; i < 5000; ++i )
+		{
+			ids.pushBack( i );
+			expected += i;
+		}
+		std::uint64_t sum = 0;
+		ids.forEach( [&sum]( std::uint64_t x ) { sum += x; } );
+		const auto contiguous = ids.linearize();
+		assert( sum == expected && !ids.isGrowing() && std::accumulate( contiguous.begin(), contiguous.end(), std::uint64_t{0} ) == expected );
+	}
+
+	{
+		Vector<float> dense{100, 0.0f};
+		dense[3] = 1.5f;
+		dense[40] = -2.0f;
+		dense[99] = 4.0f;
+		const auto sv = SparseVector<float>::fromDense( dense );
+		assert( sv.getNonZeroCount() == 3 && sv.get( 40 ) == -2.0f && sv.get( 41 ) == 0.0f );
+		const Vector<float> back = sv.toDense();
+		assert( back.getSize() == 100 && std::equal( back.begin(), back.end(), dense.begin() ) );
+		assert( sv.dot( dense ) == 1.5f * 1.5f + 4.0f + 16.0f );
+
+		// indices: multiples of 3 vs multiples of 5 below 3000, intersecting at multiples of 15
+		SparseVector<double> threes{3000};
+		SparseVector<double> fives{3000};
+		for ( std::size_t i = 0; i < 3000; ++i )
+		{
+			if ( i % 3 == 0 && i > 0 )
+			{
+				threes.pushBack( i, 1.0 );
+			}
+			if ( i % 5 == 0 && i > 0 )
+			{
+				fives.pushBack( i, static_cast<double>( i ) );
+			}
+		}
+		const auto product = SparseVector<double>::multiply( threes, fives );
+		assert( product.getNonZeroCount() == 199 && product.indices()[0] == 15 && product.get( 2985 ) == 2985.0 );
+		double expectedDot = 0;
+		for ( std::size_t i = 15; i < 3000; i += 15 )
+		{
+			expectedDot += static_cast<double>( i );
+		}
+		assert( threes.dot( fives ) == expectedDot );
+		const auto sum = SparseVector<double>::add( threes, fives );
+		assert( sum.getNonZeroCount() == 999 + 599 - 199 && sum.get( 15 ) == 16.0 && sum.get( 10 ) == 10.0 );
+
+		SparseVector<int> edits{10};
+		edits.set( 7, 1 );
+		edits.set( 2, 5 );
+		edits.set( 7, 0 );
+		edits.set( 4, 3 );
+		assert( edits.getNonZeroCount() == 2 && edits.indices()[0] == 2 && edits.indices()[1] == 4 && edits.get( 4 ) == 3 );
+	}
+
+	{
+		MdVector<int, 3> grid{{2, 3, 4}};
+		MdVector<int, 3, md::ColumnMajor<3>> gridColumns{{2, 3, 4}};
+		for ( int x = 0; x < 2; ++x )
+		{
+			for ( int y = 0; y < 3; ++y )
+			{
+				for ( int z = 0; z < 4; ++z )
+				{
+					grid( x, y, z ) = 100 * x + 10 * y + z;
+					gridColumns( x, y, z ) = grid( x, y, z );
+				}
+			}
+		}
+		assert( grid.getStorage()[1] == 1 && grid.getStorage()[4] == 10 && gridColumns.getStorage()[1] == 100 );
+		// the middle column of the row-major 2x3x4 buffer's first plane: a 3 element strided view
+		const MdView<const int, md::Strided<1>> column{grid.getStorage().data() + 1, md::Strided<1>{{3}, {4}}};
+		assert( column( 2 ) == 21 );
+
+		const std::size_t rows = 37;
+		const std::size_t cols = 70;
+		MdVector<double, 2> a{{rows, cols}};
+		MdVector<double, 2, md::Tiled<8>> tiled{{rows, cols}};
+		for ( std::size_t r = 0; r < rows; ++r )
+		{
+			for ( std::size_t c = 0; c < cols; ++c )
+			{
+				a( r, c ) = static_cast<double>( r * cols + c );
+				tiled( r, c ) = a( r, c );
+			}
+		}
+		assert( tiled.getStorage().getSize() == 40 * 72 && tiled.getStorage()[9] == a( 1, 1 ) );
+		MdVector<double, 2, md::ColumnMajor<2>> t{{cols, rows}};
+		md::transpose( tiled.view(), t.view() );
+		assert( t( 69, 36 ) == a( 36, 69 ) && t( 5, 7 ) == a( 7, 5 ) );
+		std::size_t tiles = 0;
+		std::size_t covered = 0;
+		md::forEachTile( a.view(), 16, 16, [&]( std::size_t r0, std::size_t r1, std::size_t c0, std::size_t c1 )
+			{
+				++tiles;
+				covered += ( r1 - r0 ) * ( c1 - c0 );
+			} );
+		assert( tiles == 3 * 5 && covered == rows * cols );
+
+		// (rows x cols) * (cols x rows) against the plain triple loop
+		MdVector<double, 2> product{{rows, rows}};
+		md::multiply( a.view(), t.view(), product.view(), 16 );
+		for ( std::size_t i = 0; i < rows; i += 9 )
+		{
+			for ( std::size_t j = 0; j < rows; j += 7 )
+			{
+				double expected = 0;
+				for ( std::size_t k = 0; k < cols; ++k )
+				{
+					expected += a( i, k ) * t( k, j );
+				}
+				assert( product( i, j ) == expected );
+			}
+		}
+	}
+
+	{
+		// trivial tier: bytes only, the counts are allocations
+		Tally::reset();
+		Vector<int, CountingAllocator<int>> ints{4};
+		for ( int i = 0; i < 10; ++i )
+		{
+			ints.pushBack( i );
+		}
+		assert( Tally::allocations == 3 && ints.getCapacity() == 16 );
+		Vector<int, CountingAllocator<int>> intsCopy{ints};
+		Vector<int, CountingAllocator<int>> bigger{64};
+		Tally::reset();
+		bigger = intsCopy;
+		assert( Tally::allocations == 0 && bigger.getSize() == 10 && bigger[9] == 9 );
+		bigger.clear();
+		assert( bigger.isEmpty() && bigger.getCapacity() == 64 );
+
+		// nothrow move tier: growth moves, copies copy, destructors run
+		Vector<Counted<true>> nothrow{2};
+		nothrow.emplaceBack( 1 );
+		nothrow.emplaceBack( 2 );
+		Tally::reset();
+		nothrow.emplaceBack( 3 );
+		assert( Tally::moves == 2 && Tally::copies == 0 && Tally::destroyed == 2 );
+		Tally::reset();
+		Vector<Counted<true>> nothrowCopy{nothrow};
+		assert( Tally::copies == 3 && Tally::destroyed == 0 );
+		Tally::reset();
+		nothrowCopy = nothrow;	// same capacity: destroy & copy construct in place
+		assert( Tally::copies == 3 && Tally::destroyed == 3 );
+		Tally::reset();
+		nothrowCopy.popBack();
+		nothrowCopy.clear();
+		assert( Tally::destroyed == 3 && nothrowCopy.isEmpty() );
+		Tally::reset();
+		Vector<Counted<true>> filled{5, Counted<true>{7}};
+		assert( Tally::copies == 5 && filled[4].value == 7 );
+		Tally::reset();
+		filled = std::move( nothrow );	// the old 5 go now
+		assert( Tally::destroyed == 5 && Tally::moves == 0 && filled.getSize() == 3 );
+
+		// general tier: a throwing move constructor makes growth copy
+		Vector<Counted<false>> general{2};
+		general.emplaceBack( 1 );
+		general.emplaceBack( 2 );
+		Tally::reset();
+		general.emplaceBack( 3 );
+		assert( Tally::copies == 2 && Tally::moves == 0 && Tally::destroyed == 2 && general[1].value == 2 );
+	}
+
+	{
+		// large enough for the partitioned path
+		parallel::ThreadPool pool{3};
+		Vector<int> residues{200'000};
+		for ( int i = 0; i < 200'000; ++i )
+		{
+			residues.pushBack( i * 7 % 1000 );
+		}
+		assert( hashed::countDistinct( residues, pool ) == 1000 );
+		const hashed::Index<int> index{residues, hashed::Order::FirstSeen, nullptr, pool};
+		assert( index.getPartitionCount() > 1 && index.find( 7 ) == 1 && index.find( 1000 ) == hashed::detail::npos );
+		const Vector<int> distinct = hashed::dedup( residues, hashed::Order::FirstSeen, pool );
+		assert( distinct.getSize() == 1000 && distinct[0] == 0 && distinct[1] == 7 && distinct[999] == 999 * 7 % 1000 );
+		Vector<int> unordered = hashed::dedup( residues, hashed::Order::Any, pool );
+		std::sort( unordered.begin(), unordered.end() );
+		assert( unordered.getSize() == 1000 && unordered[0] == 0 && unordered[999] == 999 );
+
+		Vector<int> series{200'000};
+		for ( int i = 0; i < 200'000; ++i )
+		{
+			series.pushBack( i );
+		}
+		const auto groups = hashed::groupBy( series, []( int x ) { return x % 3; }, hashed::Order::FirstSeen, pool );
+		assert( groups.getCount() == 3 && groups.getKey( 1 ) == 1 && groups.getKey( 2 ) == 2 );
+		assert( groups[0].size() == 66'667 && groups[2].size() == 66'666 && groups[1][0] == 1 && groups[1][1] == 4 && groups[1].back() == 199'999 );
+
+		Vector<int> evens{100'000};
+		for ( int i = 50'000; i < 200'000; i += 2 )
+		{
+			evens.pushBack( i );
+		}
+		Vector<int> firstHalf{series.cbegin(), series.cbegin() + 100'000};
+		const Vector<int> both = hashed::setIntersection( firstHalf, evens, hashed::Order::FirstSeen, pool );
+		assert( both.getSize() == 25'000 && both[0] == 50'000 && both.cback() == 99'998 );
+		const Vector<int> onlyFirst = hashed::setDifference( firstHalf, evens, hashed::Order::FirstSeen, pool );
+		assert( onlyFirst.getSize() == 75'000 && onlyFirst[0] == 0 && onlyFirst[25'000] == 25'000 );
+		const Vector<int> either = hashed::setUnion( firstHalf, evens, hashed::Order::FirstSeen, pool );
+		assert( either.getSize() == 150'000 && either[99'999] == 99'999 && either[100'000] == 100'000 && either.cback() == 199'998 );
+
+		// small inputs take the single table path
+		Vector<std::string> tags{8};
+		for ( const char* tag : {"b", "a", "b", "c", "a"} )
+		{
+			tags.pushBack( tag );
+		}
+		const Vector<std::string> uniqueTags = hashed::dedup( tags );
+		assert( uniqueTags.getSize() == 3 && uniqueTags[0] == "b" && uniqueTags[2] == "c" );
+		assert( hashed::setDifference( tags, uniqueTags ).isEmpty() );
+	}
+
+	{
+		// 1003: whole SIMD blocks and a tail
+		Vector<int> column{1003};
+		Vector<double> doubles{1003};
+		Vector<std::uint32_t> reversed{1003};
+		Vector<std::uint8_t> everyThird{1003};
+		for ( int i = 0; i < 1003; ++i )
+		{
+			column.pushBack( i * 3 );
+			doubles.pushBack( i * 0.5 );
+			reversed.pushBack( static_cast<std::uint32_t>( 1002 - i ) );
+			everyThird.pushBack( i % 3 == 0 );
+		}
+		const Vector<int> gathered = selection::gather( column, reversed );
+		assert( gathered.getSize() == 1003 && gathered[0] == 3006 && gathered[1002] == 0 && gathered[500] == 1506 );
+		const Vector<double> gatheredDoubles = selection::gather( doubles, reversed );
+		assert( gatheredDoubles[0] == 501.0 && gatheredDoubles[1002] == 0.0 );
+
+		Vector<int> scattered{1003, -1};
+		selection::scatter( gathered, reversed, scattered );
+		assert( std::equal( scattered.cbegin(), scattered.cend(), column.cbegin(), column.cend() ) );
+		Vector<std::uint32_t> sameSlot{32, 7};	// repeated index: the last write wins
+		Vector<int> lastWins{32, 0};
+		std::iota( lastWins.begin(), lastWins.end(), 100 );
+		selection::scatter( lastWins, sameSlot, scattered );
+		assert( scattered[7] == 131 && scattered[8] == 24 );
+
+		const Vector<int> kept = selection::compress( column, everyThird );
+		assert( kept.getSize() == 335 && kept[1] == 9 && kept.cback() == 3006 );
+		const Vector<double> keptDoubles = selection::compress( doubles, everyThird );
+		assert( keptDoubles.getSize() == 335 && keptDoubles[334] == 501.0 );
+		const Vector<int> odd = selection::selectIf( column, []( int x ) { return x % 2 != 0; } );
+		assert( odd.getSize() == 501 && odd[0] == 3 && odd.cback() == 3003 );
+
+		Vector<std::string> names{4};
+		for ( const char* name : {"ann", "bob", "cid", "dee"} )
+		{
+			names.pushBack( name );
+		}
+		Vector<std::uint32_t> picks{3};
+		for ( std::uint32_t pick : {3u, 0u, 3u} )
+		{
+			picks.pushBack( pick );
+		}
+		const Vector<std::string> picked = selection::gather( names, picks );
+		assert( picked.getSize() == 3 && picked[0] == "dee" && picked[1] == "ann" );
+		assert( selection::selectIf( names, []( const std::string& n ) { return n[0] != 'b'; } ).getSize() == 3 );
+	}
+
+	{
+		// single threaded: 25 batches of 4 through a channel that holds 2, so the producer keeps blocking
+		coro::RunLoop loop;
+		coro::Channel<int> channel{loop, 4, 2};
+		std::atomic<int> producersLeft{1};
+		Vector<int> received{128};
+		int batches = 0;
+		coro::spawn( loop, produceRange( channel, 0, 100, producersLeft ) );
+		coro::spawn( loop, consumeAll( channel, received, batches, nullptr ) );
+		loop.run();
+		assert( batches == 25 && received.getSize() == 100 && received[0] == 0 && received[99] == 99 );
+		assert( std::is_sorted( received.cbegin(), received.cend() ) );
+
+		// pool: 3 producers (the last batch of each is partial), 1 consumer
+		parallel::ThreadPool pool{2};
+		coro::PoolExecutor executor{pool};
+		coro::Channel<int> shared{executor, 64, 4};
+		std::atomic<int> left{3};
+		Vector<int> all{4096};
+		int sharedBatches = 0;
+		std::latch done{1};
+		coro::spawn( executor, consumeAll( shared, all, sharedBatches, &done ) );
+		for ( int p = 0; p < 3; ++p )
+		{
+			coro::spawn( executor, produceRange( shared, p * 1000, ( p + 1 ) * 1000, left ) );
+		}
+		done.wait();
+		std::sort( all.begin(), all.end() );
+		assert( all.getSize() == 3000 && sharedBatches == 3 * 16 && all[2999] == 2999 );
+
+		Vector<int> seven{7};
+		for ( int i = 0; i < 7; ++i )
+		{
+			seven.pushBack( i );
+		}
+		Vector<std::size_t> sizes{4};
+		for ( const Vector<int>& batch : coro::batches( seven, 3 ) )
+		{
+			sizes.pushBack( batch.getSize() );
+		}
+		assert( sizes.getSize() == 3 && sizes[0] == 3 && sizes[2] == 1 );
+		int sum = 0;
+		for ( const Vector<int>& batch : coro::batches( std::views::iota( 0, 10 ), 4 ) )
+		{
+			sum += std::accumulate( batch.cbegin(), batch.cend(), 0 );
+		}
+		assert( sum == 45 );
+	}
+
+	{// tracing hooks
+		static_assert( tracing::detail::TypeName<int>::view == "int" );
+#ifdef KEYVECTOR_TRACING
+		tracing::reset();
+		Vector<int> grown{64};
+		for ( int i = 0; i < 1000; ++i )
+		{
+			grown.pushBack( i );
+		}
+		grown.reserve( 5000 );
+		grown.resize( 100 );
+		Vector<int> big{1 << 20, 7};
+		Vector<int> copied{big};
+
+		Vector<tracing::Event> events{tracing::ringSize};
+		const std::size_t count = tracing::snapshot( events );
+		assert( count == events.getSize() && count == 4 + 1 + 1 + 1 );
+		assert( events[0].kind == tracing::Kind::Realloc && events[0].oldCapacity == 64 && events[0].newCapacity == 128 );
+		assert( events[4].kind == tracing::Kind::Reserve && events[4].bytes == 1000 * sizeof( int ) );
+		assert( events[5].kind == tracing::Kind::Shrink && events[5].newCapacity == 100 );
+		assert( events[6].kind == tracing::Kind::BulkCopy && events[6].bytes == ( 1u << 22 ) );
+		assert( std::string_view{events[6].typeName} == "int" && events[6].sequence == 6 );
+		std::size_t storms = 0;
+		tracing::findStorms( events.data(), count, 1'000'000'000, 7, [&storms]( const tracing::Storm& storm )
+			{
+				storms += storm.events == 7;
+			} );
+		assert( storms == 1 );
+#endif
+	}
+
+#ifdef BENCHMARK
+	runBenchmarks();
+#endif
+
 #if defined _DEBUG && !defined NDEBUG
 	while ( !getchar() );
 #endif
@@ -0,0 +1,488 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include "vector.h"
+
+
+//============================================================
+//	multidimensional views & MdVector over flat Vector storage
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 05:00
+//
+//	\brief	a layout mapping turns a Rank-d index into an offset into the flat buffer:
+//				RowMajor (last index contiguous), ColumnMajor (first index contiguous),
+//				Strided (any strides, e.g. a column or every other row of a larger buffer)
+//				and Tiled<Tile> (rank 2, Tile x Tile row-major tiles laid out row-major,
+//				so a tile is one contiguous block whichever way it is walked)
+//			the unit stride of RowMajor / ColumnMajor is a compile time constant, so
+//				inner loops over the contiguous dimension vectorize
+//			MdView<T, Mapping> is a non owning pointer + mapping; MdVector<T, Rank, Mapping>
+//				owns a Vector<T> sized for the mapping
+//			md::transpose is cache oblivious (recursive halving of the longer side down
+//				to 32 x 32 blocks); md::multiply is a blocked i-k-j kernel
+//=============================================================
+namespace md
+{
+
+template<std::size_t Rank>
+class RowMajor
+{
+	static_assert( Rank >= 1 );
+
+	std::array<std::size_t, Rank> m_extents;
+	std::array<std::size_t, Rank> m_strides;
+public:
+	static constexpr std::size_t rank = Rank;
+
+	explicit RowMajor( const std::array<std::size_t, Rank>& extents ) noexcept
+		:
+		m_extents{extents},
+		m_strides{}
+	{
+		std::size_t stride = 1;
+		for ( std::size_t d = Rank; d-- > 0; )
+		{
+			m_strides[d] = stride;
+			stride *= m_extents[d];
+		}
+	}
+
+	std::size_t operator()( const std::array<std::size_t, Rank>& idx ) const noexcept
+	{
+		std::size_t offset = idx[Rank - 1];
+		for ( std::size_t d = 0; d + 1 < Rank; ++d )
+		{
+			offset += idx[d] * m_strides[d];
+		}
+		return offset;
+	}
+
+	std::size_t getExtent( std::size_t d ) const noexcept
+	{
+		return m_extents[d];
+	}
+	std::size_t getStride( std::size_t d ) const noexcept
+	{
+		return m_strides[d];
+	}
+	std::size_t getRequiredSize() const noexcept
+	{
+		return m_strides[0] * m_extents[0];
+	}
+};
+
+template<std::size_t Rank>
+class ColumnMajor
+{
+	static_assert( Rank >= 1 );
+
+	std::array<std::size_t, Rank> m_extents;
+	std::array<std::size_t, Rank> m_strides;
+public:
+	static constexpr std::size_t rank = Rank;
+
+	explicit ColumnMajor( const std::array<std::size_t, Rank>& extents ) noexcept
+		:
+		m_extents{extents},
+		m_strides{}
+	{
+		std::size_t stride = 1;
+		for ( std::size_t d = 0; d < Rank; ++d )
+		{
+			m_strides[d] = stride;
+			stride *= m_extents[d];
+		}
+	}
+
+	std::size_t operator()( const std::array<std::size_t, Rank>& idx ) const noexcept
+	{
+		std::size_t offset = idx[0];
+		for ( std::size_t d = 1; d < Rank; ++d )
+		{
+			offset += idx[d] * m_strides[d];
+		}
+		return offset;
+	}
+
+	std::size_t getExtent( std::size_t d ) const noexcept
+	{
+		return m_extents[d];
+	}
+	std::size_t getStride( std::size_t d ) const noexcept
+	{
+		return m_strides[d];
+	}
+	std::size_t getRequiredSize() const noexcept
+	{
+		return m_strides[Rank - 1] * m_extents[Rank - 1];
+	}
+};
+
+template<std::size_t Rank>
+class Strided
+{
+	static_assert( Rank >= 1 );
+
+	std::array<std::size_t, Rank> m_extents;
+	std::array<std::size_t, Rank> m_strides;
+public:
+	static constexpr std::size_t rank = Rank;
+
+	Strided( const std::array<std::size_t, Rank>& extents,
+		const std::array<std::size_t, Rank>& strides ) noexcept
+		:
+		m_extents{extents},
+		m_strides{strides}
+	{
+
+	}
+
+	std::size_t operator()( const std::array<std::size_t, Rank>& idx ) const noexcept
+	{
+		std::size_t offset = 0;
+		for ( std::size_t d = 0; d < Rank; ++d )
+		{
+			offset += idx[d] * m_strides[d];
+		}
+		return offset;
+	}
+
+	std::size_t getExtent( std::size_t d ) const noexcept
+	{
+		return m_extents[d];
+	}
+	std::size_t getStride( std::size_t d ) const noexcept
+	{
+		return m_strides[d];
+	}
+	// one past the largest offset
+	std::size_t getRequiredSize() const noexcept
+	{
+		std::size_t last = 0;
+		for ( std::size_t d = 0; d < Rank; ++d )
+		{
+			if ( m_extents[d] == 0 )
+			{
+				return 0;
+			}
+			last += ( m_extents[d] - 1 ) * m_strides[d];
+		}
+		return last + 1;
+	}
+};
+
+// rank 2; the extents are padded up to whole tiles in storage
+template<std::size_t Tile>
+class Tiled
+{
+	static_assert( std::has_single_bit( Tile ), "Tile has to be a power of 2." );
+	static constexpr std::size_t shift = std::countr_zero( Tile );
+	static constexpr std::size_t mask = Tile - 1;
+
+	std::array<std::size_t, 2> m_extents;
+	std::size_t m_tilesPerRow;
+	std::size_t m_tileRows;
+public:
+	static constexpr std::size_t rank = 2;
+	static constexpr std::size_t tile = Tile;
+
+	explicit Tiled( const std::array<std::size_t, 2>& extents ) noexcept
+		:
+		m_extents{extents},
+		m_tilesPerRow{( extents[1] + mask ) >> shift},
+		m_tileRows{( extents[0] + mask ) >> shift}
+	{
+
+	}
+
+	std::size_t operator()( const std::array<std::size_t, 2>& idx ) const noexcept
+	{
+		const std::size_t tileIndex = ( idx[0] >> shift ) * m_tilesPerRow + ( idx[1] >> shift );
+		return ( tileIndex << ( 2 * shift ) ) + ( ( idx[0] & mask ) << shift ) + ( idx[1] & mask );
+	}
+
+	std::size_t getExtent( std::size_t d ) const noexcept
+	{
+		return m_extents[d];
+	}
+	std::size_t getRequiredSize() const noexcept
+	{
+		return ( m_tileRows * m_tilesPerRow ) << ( 2 * shift );
+	}
+};
+
+}//md
+
+
+template<typename T, typename Mapping>
+class MdView
+{
+	T* m_pData;
+	Mapping m_mapping;
+public:
+	static constexpr std::size_t rank = Mapping::rank;
+	using value_type = std::remove_cv_t<T>;
+	using mapping_type = Mapping;
+
+	MdView( T* data,
+		const Mapping& mapping ) noexcept
+		:
+		m_pData{data},
+		m_mapping{mapping}
+	{
+
+	}
+	// a view of T converts to a view of const T
+	template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+	MdView( const MdView<U, Mapping>& rhs ) noexcept
+		:
+		m_pData{rhs.data()},
+		m_mapping{rhs.getMapping()}
+	{
+
+	}
+
+	template<typename... I>
+	T& operator()( I... idx ) const noexcept
+	{
+		static_assert( sizeof...( I ) == rank, "MdView takes one index per dimension." );
+		return m_pData[m_mapping( std::array<std::size_t, rank>{static_cast<std::size_t>( idx )...} )];
+	}
+	T& operator[]( const std::array<std::size_t, rank>& idx ) const noexcept
+	{
+		return m_pData[m_mapping( idx )];
+	}
+
+	std::size_t getExtent( std::size_t d ) const noexcept
+	{
+		return m_mapping.getExtent( d );
+	}
+	const Mapping& getMapping() const noexcept
+	{
+		return m_mapping;
+	}
+	T* data() const noexcept
+	{
+		return m_pData;
+	}
+};
+
+
+//============================================================
+//	\class	MdVector<T, Rank, Mapping>
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 05:00
+//
+//	\brief	a Rank-d array stored in a Vector<T> laid out by Mapping
+//			all elements are value initialized (or set to `value`); the storage
+//				includes a Tiled mapping's padding
+//=============================================================
+template<typename T, std::size_t Rank, typename Mapping = md::RowMajor<Rank>>
+class MdVector
+{
+	static_assert( Mapping::rank == Rank, "MdVector's Mapping has to be of the same rank." );
+
+	Mapping m_mapping;
+	Vector<T> m_storage;
+public:
+	explicit MdVector( const std::array<std::size_t, Rank>& extents,
+		const T& value = T{} )
+		:
+		m_mapping{extents},
+		m_storage{std::max<std::size_t>( m_mapping.getRequiredSize(), 1 ), value}
+	{
+
+	}
+
+	template<typename... I>
+	T& operator()( I... idx ) noexcept
+	{
+		static_assert( sizeof...( I ) == Rank, "MdVector takes one index per dimension." );
+		return m_storage[m_mapping( std::array<std::size_t, Rank>{static_cast<std::size_t>( idx )...} )];
+	}
+	template<typename... I>
+	const T& operator()( I... idx ) const noexcept
+	{
+		static_assert( sizeof...( I ) == Rank, "MdVector takes one index per dimension." );
+		return m_storage.data()[m_mapping( std::array<std::size_t, Rank>{static_cast<std::size_t>( idx )...} )];
+	}
+
+	MdView<T, Mapping> view() noexcept
+	{
+		return MdView<T, Mapping>{m_storage.data(), m_mapping};
+	}
+	MdView<const T, Mapping> view() const noexcept
+	{
+		return MdView<const T, Mapping>{m_storage.data(), m_mapping};
+	}
+
+	std::size_t getExtent( std::size_t d ) const noexcept
+	{
+		return m_mapping.getExtent( d );
+	}
+	const Mapping& getMapping() const noexcept
+	{
+		return m_mapping;
+	}
+	Vector<T>& getStorage() noexcept
+	{
+		return m_storage;
+	}
+	const Vector<T>& getStorage() const noexcept
+	{
+		return m_storage;
+	}
+};
+
+
+namespace md
+{
+
+// fn( rowBegin, rowEnd, colBegin, colEnd ) for every tileRows x tileCols tile of a rank 2 view,
+//	row of tiles by row of tiles; edge tiles are clipped
+template<typename View, typename F>
+void forEachTile( const View& v,
+	std::size_t tileRows,
+	std::size_t tileCols,
+	F&& fn )
+{
+	static_assert( View::rank == 2 );
+	const std::size_t rows = v.getExtent( 0 );
+	const std::size_t cols = v.getExtent( 1 );
+	for ( std::size_t r = 0; r < rows; r += tileRows )
+	{
+		for ( std::size_t c = 0; c < cols; c += tileCols )
+		{
+			fn( r, std::min( r + tileRows, rows ), c, std::min( c + tileCols, cols ) );
+		}
+	}
+}
+
+namespace detail
+{
+
+inline constexpr std::size_t transposeLeaf = 32;
+
+template<typename Src, typename Dst>
+void transposeRecursive( const Src& src,
+	const Dst& dst,
+	std::size_t r0,
+	std::size_t r1,
+	std::size_t c0,
+	std::size_t c1 ) noexcept
+{
+	if ( r1 - r0 <= transposeLeaf && c1 - c0 <= transposeLeaf )
+	{
+		for ( std::size_t r = r0; r < r1; ++r )
+		{
+			for ( std::size_t c = c0; c < c1; ++c )
+			{
+				dst( c, r ) = src( r, c );
+			}
+		}
+	}
+	else if ( r1 - r0 >= c1 - c0 )
+	{
+		const std::size_t mid = r0 + ( r1 - r0 ) / 2;
+		transposeRecursive( src, dst, r0, mid, c0, c1 );
+		transposeRecursive( src, dst, mid, r1, c0, c1 );
+	}
+	else
+	{
+		const std::size_t mid = c0 + ( c1 - c0 ) / 2;
+		transposeRecursive( src, dst, r0, r1, c0, mid );
+		transposeRecursive( src, dst, r0, r1, mid, c1 );
+	}
+}
+
+// c[0, n) += a * b[0, n); __restrict (no overlap) and the 4 independent lanes per step let
+//	the compiler vectorize it without alias checks or a cost model that allows an epilogue
+template<typename T, typename U>
+void axpy( T* __restrict c,
+	const U* __restrict b,
+	const std::remove_cv_t<U> a,
+	std::size_t n ) noexcept
+{
+	std::size_t j = 0;
+	for ( ; j + 4 <= n; j += 4 )
+	{
+		c[j] += a * b[j];
+		c[j + 1] += a * b[j + 1];
+		c[j + 2] += a * b[j + 2];
+		c[j + 3] += a * b[j + 3];
+	}
+	for ( ; j < n; ++j )
+	{
+		c[j] += a * b[j];
+	}
+}
+
+}//detail
+
+// dst( c, r ) = src( r, c ); dst has to be cols x rows and must not alias src
+template<typename Src, typename Dst>
+void transpose( const Src& src,
+	const Dst& dst ) noexcept
+{
+	static_assert( Src::rank == 2 && Dst::rank == 2 );
+	assert( dst.getExtent( 0 ) == src.getExtent( 1 ) && dst.getExtent( 1 ) == src.getExtent( 0 ) );
+	detail::transposeRecursive( src, dst, 0, src.getExtent( 0 ), 0, src.getExtent( 1 ) );
+}
+
+// views whose last index is the contiguous one
+template<typename View>
+inline constexpr bool hasContiguousRows = std::is_same_v<typename View::mapping_type, RowMajor<View::rank>>;
+
+// c += a * b over blocks of `block` rows/cols/depth, i-k-j order inside a block so the
+//	innermost loop walks a row of b and c (contiguous for RowMajor)
+template<typename A, typename B, typename C>
+void multiply( const A& a,
+	const B& b,
+	const C& c,
+	std::size_t block = 64 ) noexcept
+{
+	static_assert( A::rank == 2 && B::rank == 2 && C::rank == 2 );
+	const std::size_t n = a.getExtent( 0 );
+	const std::size_t depth = a.getExtent( 1 );
+	const std::size_t m = b.getExtent( 1 );
+	assert( b.getExtent( 0 ) == depth && c.getExtent( 0 ) == n && c.getExtent( 1 ) == m );
+	for ( std::size_t i0 = 0; i0 < n; i0 += block )
+	{
+		const std::size_t i1 = std::min( i0 + block, n );
+		for ( std::size_t k0 = 0; k0 < depth; k0 += block )
+		{
+			const std::size_t k1 = std::min( k0 + block, depth );
+			for ( std::size_t j0 = 0; j0 < m; j0 += block )
+			{
+				const std::size_t j1 = std::min( j0 + block, m );
+				for ( std::size_t i = i0; i < i1; ++i )
+				{
+					for ( std::size_t k = k0; k < k1; ++k )
+					{
+						const auto aik = a( i, k );
+						if constexpr ( hasContiguousRows<B> && hasContiguousRows<C> )
+						{
+							detail::axpy( &c( i, j0 ), &b( k, j0 ), aik, j1 - j0 );
+						}
+						else
+						{
+							for ( std::size_t j = j0; j < j1; ++j )
+							{
+								c( i, j ) += aik * b( k, j );
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+}//md
@@ -0,0 +1,392 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cctype>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <algorithm>
+#include "vector.h"
+#if defined __linux__
+#	include <unistd.h>
+#	include <sched.h>
+#	include <pthread.h>
+#	include <sys/syscall.h>
+#endif
+
+
+//============================================================
+//	NUMA placement for Vector buffers & node-partitioned iteration
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 14:05
+//
+//	\brief	Linux: talks to the kernel directly through mbind/set_mempolicy
+//				(no libnuma dependency) and reads the topology from sysfs
+//			elsewhere, on single node machines or if the syscalls are refused,
+//				everything degrades to a single node and placement calls return false
+//			set KEYVECTOR_NUMA_EMULATE=<n> to emulate n nodes by splitting the
+//				available cpus; memory placement is then a no-op
+//=============================================================
+namespace numa
+{
+
+enum class Placement
+{
+	Default,		// first touch
+	Interleaved,	// pages round-robin across all nodes
+	Local,			// prefer a single node
+	Partitioned		// contiguous index ranges, one per node (matches parallelForEach slices)
+};
+
+class Topology final
+{
+	int m_nodes;
+	bool m_emulated;
+	Vector<Vector<int>> m_cpus;	// cpus per node
+
+	// parses sysfs "0-3,8,10-11" style lists
+	static Vector<int> parseList( const std::string& list )
+	{
+		Vector<int> out;
+		std::size_t i = 0;
+		while ( i < list.size() )
+		{
+			std::size_t end = list.find( ',', i );
+			if ( end == std::string::npos )
+			{
+				end = list.size();
+			}
+			const std::string item = list.substr( i, end - i );
+			const std::size_t dash = item.find( '-' );
+			if ( !item.empty() && std::isdigit( static_cast<unsigned char>( item[0] ) ) )
+			{
+				const int lo = std::stoi( item.substr( 0, dash ) );
+				const int hi = dash == std::string::npos ?
+					lo :
+					std::stoi( item.substr( dash + 1 ) );
+				for ( int v = lo; v <= hi; ++v )
+				{
+					out.pushBack( v );
+				}
+			}
+			i = end + 1;
+		}
+		return out;
+	}
+
+	static std::string readLine( const std::string& path )
+	{
+		std::ifstream file{path};
+		std::string line;
+		std::getline( file, line );
+		return line;
+	}
+
+	Topology()
+		:
+		m_nodes{1},
+		m_emulated{false},
+		m_cpus{}
+	{
+		const int nCpus = static_cast<int>( std::max( 1u, std::thread::hardware_concurrency() ) );
+		if ( const char* emulate = std::getenv( "KEYVECTOR_NUMA_EMULATE" ) )
+		{
+			m_nodes = std::max( 1, std::atoi( emulate ) );
+			m_emulated = true;
+			for ( int n = 0; n < m_nodes; ++n )
+			{
+				m_cpus.pushBack( Vector<int>{} );
+			}
+			for ( int c = 0; c < nCpus; ++c )
+			{
+				m_cpus[c % m_nodes].pushBack( c );
+			}
+			return;
+		}
+#if defined __linux__
+		Vector<int> online = parseList( readLine( "/sys/devices/system/node/online" ) );
+		if ( online.getSize() > 1 )
+		{
+			m_nodes = online.back() + 1;
+			for ( int n = 0; n < m_nodes; ++n )
+			{
+				m_cpus.pushBack( parseList( readLine( "/sys/devices/system/node/node" + std::to_string( n ) + "/cpulist" ) ) );
+			}
+			return;
+		}
+#endif
+		m_cpus.pushBack( Vector<int>{} );
+		for ( int c = 0; c < nCpus; ++c )
+		{
+			m_cpus[0].pushBack( c );
+		}
+	}
+public:
+	static const Topology& instance()
+	{
+		static const Topology topology;
+		return topology;
+	}
+
+	int getNodeCount() const noexcept
+	{
+		return m_nodes;
+	}
+	bool isEmulated() const noexcept
+	{
+		return m_emulated;
+	}
+	const Vector<int>& getCpus( int node ) const noexcept
+	{
+		return m_cpus[node];
+	}
+};
+
+inline int nodeCount()
+{
+	return Topology::instance().getNodeCount();
+}
+
+// [begin, end) of the slice of `n` elements owned by `node`
+inline constexpr std::size_t sliceBegin( std::size_t n,
+	int node,
+	int nodes ) noexcept
+{
+	return static_cast<std::size_t>( ( static_cast<unsigned long long>( n ) * node ) / nodes );
+}
+
+#if defined __linux__
+namespace detail
+{
+// <numaif.h> values, spelled out to avoid depending on libnuma headers
+constexpr int mpolDefault = 0;
+constexpr int mpolPreferred = 1;
+constexpr int mpolInterleave = 3;
+constexpr unsigned mpolMfMove = 1u << 1;
+constexpr unsigned long maxNodes = 64;
+
+inline bool mbindRange( void* addr,
+	std::size_t bytes,
+	int mode,
+	unsigned long nodeMask ) noexcept
+{
+	const std::uintptr_t page = static_cast<std::uintptr_t>( ::sysconf( _SC_PAGESIZE ) );
+	const std::uintptr_t lo = reinterpret_cast<std::uintptr_t>( addr ) & ~( page - 1 );
+	const std::uintptr_t hi = ( reinterpret_cast<std::uintptr_t>( addr ) + bytes + page - 1 ) & ~( page - 1 );
+	if ( hi <= lo )
+	{
+		return true;
+	}
+	const unsigned long* mask = mode == mpolDefault ?
+		nullptr :
+		&nodeMask;
+	return ::syscall( SYS_mbind, lo, hi - lo, mode, mask, maxNodes + 1, mpolMfMove ) == 0;
+}
+
+inline unsigned long allNodesMask( int nodes ) noexcept
+{
+	return nodes >= 64 ?
+		~0ul :
+		( 1ul << nodes ) - 1;
+}
+}//detail
+#endif
+
+// applies `policy` to [addr, addr + bytes); already touched pages are migrated
+//	for Partitioned the range is treated as `bytes / elemSize` elements split by sliceBegin
+//	returns false if placement is unsupported/refused - the memory stays usable either way
+inline bool place( void* addr,
+	std::size_t bytes,
+	Placement policy,
+	int node = 0,
+	std::size_t elemSize = 1 ) noexcept
+{
+#if defined __linux__
+	const Topology& topo = Topology::instance();
+	const int nodes = topo.getNodeCount();
+	if ( topo.isEmulated() || nodes <= 1 || node < 0 || node >= nodes
+		|| nodes > static_cast<int>( detail::maxNodes ) )
+	{
+		return false;
+	}
+	switch ( policy )
+	{
+	case Placement::Default:
+		return detail::mbindRange( addr, bytes, detail::mpolDefault, 0 );
+	case Placement::Interleaved:
+		return detail::mbindRange( addr, bytes, detail::mpolInterleave, detail::allNodesMask( nodes ) );
+	case Placement::Local:
+		return detail::mbindRange( addr, bytes, detail::mpolPreferred, 1ul << node );
+	case Placement::Partitioned:
+	{
+		const std::uintptr_t page = static_cast<std::uintptr_t>( ::sysconf( _SC_PAGESIZE ) );
+		const std::size_t n = bytes / elemSize;
+		char* base = static_cast<char*>( addr );
+		bool ok = true;
+		for ( int k = 0; k < nodes; ++k )
+		{
+			// round both ends down to a page so that neighbouring slices never share a binding
+			const std::uintptr_t lo = reinterpret_cast<std::uintptr_t>( base + sliceBegin( n, k, nodes ) * elemSize ) & ~( page - 1 );
+			const std::uintptr_t hi = k + 1 == nodes ?
+				reinterpret_cast<std::uintptr_t>( base + bytes ) :
+				reinterpret_cast<std::uintptr_t>( base + sliceBegin( n, k + 1, nodes ) * elemSize ) & ~( page - 1 );
+			if ( hi > lo )
+			{
+				ok &= detail::mbindRange( reinterpret_cast<void*>( lo ), hi - lo, detail::mpolPreferred, 1ul << k );
+			}
+		}
+		return ok;
+	}
+	}
+	return false;
+#else
+	(void) addr;
+	(void) bytes;
+	(void) policy;
+	(void) node;
+	(void) elemSize;
+	return false;
+#endif
+}
+
+// places the whole capacity of `v`; do it right after reserve() to steer first touch,
+//	or later to migrate. A reallocation (growth, resize) drops the placement.
+template<typename T, typename Alloc, typename ErrorPolicy>
+bool place( Vector<T, Alloc, ErrorPolicy>& v,
+	Placement policy,
+	int node = 0 ) noexcept
+{
+	return place( v.begin(), v.getCapacity() * sizeof( T ), policy, node, sizeof( T ) );
+}
+
+// pins the calling thread to the cpus of `node`
+inline bool pinThreadToNode( int node ) noexcept
+{
+#if defined __linux__
+	const Topology& topo = Topology::instance();
+	if ( node < 0 || node >= topo.getNodeCount() || topo.getCpus( node ).isEmpty() )
+	{
+		return false;
+	}
+	cpu_set_t set;
+	CPU_ZERO( &set );
+	const Vector<int>& cpus = topo.getCpus( node );
+	for ( std::size_t i = 0; i < cpus.getSize(); ++i )
+	{
+		CPU_SET( cpus[i], &set );
+	}
+	return ::pthread_setaffinity_np( ::pthread_self(), sizeof( set ), &set ) == 0;
+#else
+	(void) node;
+	return false;
+#endif
+}
+
+//============================================================
+//	\class	ScopedMemPolicy
+//	\brief	sets the calling thread's default allocation policy (set_mempolicy)
+//			for its lifetime, so that a Vector filled by this thread with pushBack
+//			gets interleaved/local pages instead of plain first touch
+//=============================================================
+class ScopedMemPolicy final
+{
+	bool m_active;
+public:
+	explicit ScopedMemPolicy( Placement policy,
+		int node = 0 ) noexcept
+		:
+		m_active{false}
+	{
+#if defined __linux__
+		const Topology& topo = Topology::instance();
+		const int nodes = topo.getNodeCount();
+		if ( topo.isEmulated() || nodes <= 1 || node < 0 || node >= nodes
+			|| nodes > static_cast<int>( detail::maxNodes ) )
+		{
+			return;
+		}
+		unsigned long mask = 0;
+		int mode = detail::mpolDefault;
+		if ( policy == Placement::Interleaved || policy == Placement::Partitioned )
+		{
+			mode = detail::mpolInterleave;
+			mask = detail::allNodesMask( nodes );
+		}
+		else if ( policy == Placement::Local )
+		{
+			mode = detail::mpolPreferred;
+			mask = 1ul << node;
+		}
+		m_active = ::syscall( SYS_set_mempolicy, mode, mode == detail::mpolDefault ? nullptr : &mask, detail::maxNodes + 1 ) == 0;
+#else
+		(void) policy;
+		(void) node;
+#endif
+	}
+
+	~ScopedMemPolicy() noexcept
+	{
+#if defined __linux__
+		if ( m_active )
+		{
+			::syscall( SYS_set_mempolicy, detail::mpolDefault, nullptr, 0 );
+		}
+#endif
+	}
+
+	ScopedMemPolicy( const ScopedMemPolicy& rhs ) = delete;
+	ScopedMemPolicy& operator=( const ScopedMemPolicy& rhs ) = delete;
+
+	bool isActive() const noexcept
+	{
+		return m_active;
+	}
+};
+
+// runs f( element ) over `v`, one group of workers per node, each group pinned to
+//	its node and walking the index range Placement::Partitioned put there
+//	slices are derived from the capacity so that they match the placement
+//	threadsPerNode == 0 uses every cpu of the node
+template<typename T, typename Alloc, typename ErrorPolicy, typename F>
+void parallelForEach( Vector<T, Alloc, ErrorPolicy>& v,
+	F&& f,
+	std::size_t threadsPerNode = 0 )
+{
+	const Topology& topo = Topology::instance();
+	const int nodes = topo.getNodeCount();
+	const std::size_t capacity = v.getCapacity();
+	const std::size_t size = v.getSize();
+	T* const data = v.begin();
+
+	std::vector<std::thread> workers;
+	for ( int node = 0; node < nodes; ++node )
+	{
+		const std::size_t lo = std::min( sliceBegin( capacity, node, nodes ), size );
+		const std::size_t hi = std::min( sliceBegin( capacity, node + 1, nodes ), size );
+		const std::size_t nThreads = std::max<std::size_t>( 1,
+			threadsPerNode ? threadsPerNode : topo.getCpus( node ).getSize() );
+		for ( std::size_t t = 0; t < nThreads; ++t )
+		{
+			const std::size_t b = lo + ( hi - lo ) * t / nThreads;
+			const std::size_t e = lo + ( hi - lo ) * ( t + 1 ) / nThreads;
+			workers.emplace_back( [node, data, b, e, &f]()
+				{
+					pinThreadToNode( node );
+					for ( std::size_t i = b; i < e; ++i )
+					{
+						f( data[i] );
+					}
+				}
+			);
+		}
+	}
+	for ( std::thread& worker : workers )
+	{
+		worker.join();
+	}
+}
+
+}//numa
@@ -0,0 +1,689 @@
+#pragma once
+
+#include <new>
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <cassert>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include "vector.h"
+
+
+//============================================================
+//	parallel algorithms over Vector (and any contiguous span)
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 22:45
+//
+//	\brief	ThreadPool: one deque per worker; a worker pops its own deque LIFO and
+//				steals FIFO from the others when it runs dry, idle workers sleep
+//			the algorithms fork-join over chunks of at least `grain` elements
+//				(0 = default) and at most 4 chunks per thread; interior chunk
+//				boundaries sit on 64 byte boundaries of the buffer, so no two
+//				chunks ever write the same cache line
+//			the calling thread takes part (it runs chunk 0 and then helps with
+//				queued tasks while it waits), which also makes nested calls safe
+//			the first exception a chunk throws is rethrown by the calling thread
+//=============================================================
+namespace parallel
+{
+
+class ThreadPool final
+{
+	using Task = std::function<void()>;
+
+	struct alignas( 64 ) Queue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	std::unique_ptr<Queue[]> m_queues;		// one per worker + one shared by outside threads
+	std::size_t m_nQueues;
+	std::vector<std::thread> m_threads;
+	alignas( 64 ) std::atomic<std::size_t> m_pending;
+	std::atomic<std::size_t> m_nextQueue;
+	std::atomic<bool> m_stop;
+	std::mutex m_sleepMutex;
+	std::condition_variable m_wake;
+
+	static inline thread_local const ThreadPool* t_pool = nullptr;
+	static inline thread_local std::size_t t_index = 0;
+
+	// own queue first (newest task, still warm), then the oldest task of the others
+	bool tryTake( std::size_t self,
+		Task& task )
+	{
+		{
+			Queue& q = m_queues[self];
+			std::lock_guard<std::mutex> lock{q.mutex};
+			if ( !q.tasks.empty() )
+			{
+				task = std::move( q.tasks.back() );
+				q.tasks.pop_back();
+				m_pending.fetch_sub( 1, std::memory_order_relaxed );
+				return true;
+			}
+		}
+		for ( std::size_t i = 1; i < m_nQueues; ++i )
+		{
+			Queue& q = m_queues[( self + i ) % m_nQueues];
+			std::unique_lock<std::mutex> lock{q.mutex, std::try_to_lock};
+			if ( lock && !q.tasks.empty() )
+			{
+				task = std::move( q.tasks.front() );
+				q.tasks.pop_front();
+				m_pending.fetch_sub( 1, std::memory_order_relaxed );
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void workerLoop( std::size_t index )
+	{
+		t_pool = this;
+		t_index = index;
+		Task task;
+		while ( true )
+		{
+			if ( tryTake( index, task ) )
+			{
+				task();
+				task = nullptr;
+				continue;
+			}
+			std::unique_lock<std::mutex> lock{m_sleepMutex};
+			m_wake.wait( lock, [this]()
+				{
+					return m_stop.load( std::memory_order_relaxed ) || m_pending.load( std::memory_order_relaxed ) > 0;
+				}
+			);
+			if ( m_stop.load( std::memory_order_relaxed ) && m_pending.load( std::memory_order_relaxed ) == 0 )
+			{
+				return;
+			}
+		}
+	}
+
+	std::size_t callerQueue() const noexcept
+	{
+		return t_pool == this ?
+			t_index :
+			m_nQueues - 1;
+	}
+public:
+	// nThreads == 0: a worker per hardware thread but one, the calling thread always helps on top of them
+	explicit ThreadPool( std::size_t nThreads = 0 )
+		:
+		m_queues{},
+		m_nQueues{},
+		m_threads{},
+		m_pending{0},
+		m_nextQueue{0},
+		m_stop{false}
+	{
+		if ( nThreads == 0 )
+		{
+			nThreads = std::max( 1u, std::thread::hardware_concurrency() ) - 1;
+		}
+		m_nQueues = nThreads + 1;
+		m_queues = std::make_unique<Queue[]>( m_nQueues );
+		m_threads.reserve( nThreads );
+		for ( std::size_t i = 0; i < nThreads; ++i )
+		{
+			m_threads.emplace_back( &ThreadPool::workerLoop, this, i );
+		}
+	}
+
+	~ThreadPool() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock{m_sleepMutex};
+			m_stop.store( true, std::memory_order_relaxed );
+		}
+		m_wake.notify_all();
+		for ( std::thread& t : m_threads )
+		{
+			t.join();
+		}
+	}
+
+	ThreadPool( const ThreadPool& rhs ) = delete;
+	ThreadPool& operator=( const ThreadPool& rhs ) = delete;
+
+	// from a worker: onto its own deque; from outside: spread round robin
+	void submit( Task task )
+	{
+		std::size_t q = callerQueue();
+		if ( q == m_nQueues - 1 && m_nQueues > 1 )
+		{
+			q = m_nextQueue.fetch_add( 1, std::memory_order_relaxed ) % ( m_nQueues - 1 );
+		}
+		// counted before it is visible, so a taker's decrement can't precede the increment
+		{
+			std::lock_guard<std::mutex> lock{m_sleepMutex};
+			m_pending.fetch_add( 1, std::memory_order_relaxed );
+		}
+		{
+			std::lock_guard<std::mutex> lock{m_queues[q].mutex};
+			m_queues[q].tasks.push_back( std::move( task ) );
+		}
+		m_wake.notify_one();
+	}
+
+	// runs one queued task on the calling thread, false if there was none
+	bool runPendingTask()
+	{
+		Task task;
+		if ( tryTake( callerQueue(), task ) )
+		{
+			task();
+			return true;
+		}
+		return false;
+	}
+
+	// fn( chunk ) for chunk in [0, nChunks), returns once all of them did
+	template<typename F>
+	void forkJoin( std::size_t nChunks,
+		F&& fn )
+	{
+		if ( nChunks == 1 || m_threads.empty() )
+		{
+			for ( std::size_t c = 0; c < nChunks; ++c )
+			{
+				fn( c );
+			}
+			return;
+		}
+		struct Join
+		{
+			std::atomic<std::size_t> remaining;
+			std::mutex errorMutex;
+			std::exception_ptr error;
+		} join;
+		join.remaining.store( nChunks - 1, std::memory_order_relaxed );
+
+		auto runChunk = [&fn, &join]( std::size_t c )
+		{
+#ifdef KEYVECTOR_EXCEPTIONS
+			try
+			{
+				fn( c );
+			}
+			catch ( ... )
+			{
+				std::lock_guard<std::mutex> lock{join.errorMutex};
+				if ( !join.error )
+				{
+					join.error = std::current_exception();
+				}
+			}
+#else
+			fn( c );
+#endif
+		};
+		for ( std::size_t c = 1; c < nChunks; ++c )
+		{
+			submit( [&runChunk, &join, c]()
+				{
+					runChunk( c );
+					join.remaining.fetch_sub( 1, std::memory_order_release );
+				}
+			);
+		}
+		runChunk( 0 );
+		while ( join.remaining.load( std::memory_order_acquire ) != 0 )
+		{
+			if ( !runPendingTask() )
+			{
+				std::this_thread::yield();
+			}
+		}
+#ifdef KEYVECTOR_EXCEPTIONS
+		if ( join.error )
+		{
+			std::rethrow_exception( join.error );
+		}
+#endif
+	}
+
+	// worker threads, not counting the callers that help out
+	std::size_t getThreadCount() const noexcept
+	{
+		return m_threads.size();
+	}
+
+	static ThreadPool& instance()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+};
+
+
+//============================================================
+//	\class	Chunking<T>
+//	\brief	splits n elements at `data` into cache line aligned chunks
+//			chunk 0 absorbs the misaligned head, the last one the tail
+//=============================================================
+template<typename T>
+class Chunking final
+{
+	static constexpr std::size_t cacheLineSize = 64;
+	static constexpr std::size_t defaultGrain = 16384;
+	static constexpr std::size_t lineElements = sizeof( T ) < cacheLineSize && cacheLineSize % sizeof( T ) == 0 ?
+		cacheLineSize / sizeof( T ) :
+		1;
+
+	std::size_t m_n;
+	std::size_t m_head;		// elements before the first cache line boundary
+	std::size_t m_step;		// elements per chunk, a multiple of lineElements
+	std::size_t m_count;
+public:
+	Chunking( const T* data,
+		std::size_t n,
+		std::size_t grain,
+		std::size_t nThreads ) noexcept
+		:
+		m_n{n},
+		m_head{0},
+		m_step{n},
+		m_count{1}
+	{
+		if ( lineElements > 1 )
+		{
+			const std::size_t misalignment = reinterpret_cast<std::uintptr_t>( data ) % cacheLineSize;
+			if ( misalignment % sizeof( T ) == 0 )
+			{
+				m_head = std::min( n, ( ( cacheLineSize - misalignment ) % cacheLineSize ) / sizeof( T ) );
+			}
+		}
+		grain = std::max( grain ? grain : defaultGrain, lineElements );
+		const std::size_t maxChunks = std::max<std::size_t>( 1, nThreads * 4 );
+		const std::size_t wanted = std::clamp<std::size_t>( ( n + grain - 1 ) / grain, 1, maxChunks );
+		if ( wanted > 1 )
+		{
+			const std::size_t body = n - m_head;
+			m_step = ( body + wanted - 1 ) / wanted;
+			m_step = ( m_step + lineElements - 1 ) / lineElements * lineElements;
+			m_count = ( body + m_step - 1 ) / m_step;
+		}
+		else
+		{
+			m_head = 0;
+		}
+	}
+
+	std::size_t getCount() const noexcept
+	{
+		return m_count;
+	}
+	std::size_t begin( std::size_t chunk ) const noexcept
+	{
+		return chunk == 0 ?
+			0 :
+			std::min( m_n, m_head + chunk * m_step );
+	}
+	std::size_t end( std::size_t chunk ) const noexcept
+	{
+		return chunk + 1 == m_count ?
+			m_n :
+			std::min( m_n, m_head + ( chunk + 1 ) * m_step );
+	}
+};
+
+namespace detail
+{
+
+// one per chunk, on its own cache line
+template<typename R>
+struct alignas( 64 ) Partial
+{
+	std::optional<R> value;
+};
+
+template<typename T, typename F>
+void forEachChunk( std::span<T> s,
+	std::size_t grain,
+	ThreadPool& pool,
+	F&& fn )
+{
+	if ( s.empty() )
+	{
+		return;
+	}
+	const Chunking<std::remove_const_t<T>> chunks{s.data(), s.size(), grain, pool.getThreadCount() + 1};
+	pool.forkJoin( chunks.getCount(), [&]( std::size_t c )
+		{
+			fn( c, chunks.begin( c ), chunks.end( c ) );
+		}
+	);
+}
+
+}//detail
+
+
+// fn( element ) for every element
+template<typename T, typename F>
+void parallelForEach( std::span<T> s,
+	F fn,
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	detail::forEachChunk( s, grain, pool, [s, &fn]( std::size_t, std::size_t b, std::size_t e )
+		{
+			for ( std::size_t i = b; i < e; ++i )
+			{
+				fn( s[i] );
+			}
+		}
+	);
+}
+
+// out[i] = fn( in[i] ); out has to hold at least in.size() elements (in place is fine)
+template<typename T, typename U, typename F>
+void parallelTransform( std::span<const T> in,
+	std::span<U> out,
+	F fn,
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	assert( out.size() >= in.size() );
+	// chunk on the output, those are the cache lines written to
+	const Chunking<U> chunks{out.data(), in.size(), grain, pool.getThreadCount() + 1};
+	if ( in.empty() )
+	{
+		return;
+	}
+	pool.forkJoin( chunks.getCount(), [&]( std::size_t c )
+		{
+			for ( std::size_t i = chunks.begin( c ), e = chunks.end( c ); i < e; ++i )
+			{
+				out[i] = fn( in[i] );
+			}
+		}
+	);
+}
+
+// op has to be associative and commutative (as for std::reduce); init is folded in once
+template<typename T, typename R, typename Op = std::plus<>>
+R parallelReduce( std::span<const T> s,
+	R init,
+	Op op = {},
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	std::vector<detail::Partial<R>> partials( 4 * ( pool.getThreadCount() + 1 ) );
+	detail::forEachChunk( s, grain, pool, [&]( std::size_t c, std::size_t b, std::size_t e )
+		{
+			if constexpr ( std::is_arithmetic_v<R> )
+			{
+				// independent accumulators break the dependency chain (and let floats vectorize)
+				constexpr std::size_t lanes = 8;
+				if ( e - b >= 2 * lanes )
+				{
+					R acc[lanes];
+					for ( std::size_t j = 0; j < lanes; ++j )
+					{
+						acc[j] = static_cast<R>( s[b + j] );
+					}
+					std::size_t i = b + lanes;
+					for ( ; i + lanes <= e; i += lanes )
+					{
+						for ( std::size_t j = 0; j < lanes; ++j )
+						{
+							acc[j] = op( acc[j], s[i + j] );
+						}
+					}
+					for ( ; i < e; ++i )
+					{
+						acc[0] = op( acc[0], s[i] );
+					}
+					for ( std::size_t j = 1; j < lanes; ++j )
+					{
+						acc[0] = op( acc[0], acc[j] );
+					}
+					partials[c].value.emplace( acc[0] );
+					return;
+				}
+			}
+			R acc = static_cast<R>( s[b] );
+			for ( std::size_t i = b + 1; i < e; ++i )
+			{
+				acc = op( std::move( acc ), s[i] );
+			}
+			partials[c].value.emplace( std::move( acc ) );
+		}
+	);
+	for ( detail::Partial<R>& p : partials )
+	{
+		if ( p.value )
+		{
+			init = op( std::move( init ), std::move( *p.value ) );
+		}
+	}
+	return init;
+}
+
+template<typename T, typename Pred>
+std::size_t parallelCountIf( std::span<const T> s,
+	Pred pred,
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	std::vector<detail::Partial<std::size_t>> partials( 4 * ( pool.getThreadCount() + 1 ) );
+	detail::forEachChunk( s, grain, pool, [&]( std::size_t c, std::size_t b, std::size_t e )
+		{
+			std::size_t count = 0;
+			for ( std::size_t i = b; i < e; ++i )
+			{
+				count += pred( s[i] ) ? 1 : 0;
+			}
+			partials[c].value.emplace( count );
+		}
+	);
+	std::size_t total = 0;
+	for ( const detail::Partial<std::size_t>& p : partials )
+	{
+		total += p.value.value_or( 0 );
+	}
+	return total;
+}
+
+namespace detail
+{
+
+// sequential scan of s[b, e) continuing from carry (nullopt: nothing on the left)
+template<bool inclusive, typename T, typename Op>
+void scanRange( std::span<T> s,
+	std::size_t b,
+	std::size_t e,
+	std::optional<T> carry,
+	Op& op )
+{
+	if ( b == e )
+	{
+		return;
+	}
+	if constexpr ( inclusive )
+	{
+		T acc = carry ?
+			op( std::move( *carry ), s[b] ) :
+			s[b];
+		s[b] = acc;
+		for ( std::size_t i = b + 1; i < e; ++i )
+		{
+			acc = op( std::move( acc ), s[i] );
+			s[i] = acc;
+		}
+	}
+	else
+	{
+		// exclusive scans always have an init, so a carry
+		T acc = std::move( *carry );
+		for ( std::size_t i = b; i < e; ++i )
+		{
+			T x = std::move( s[i] );
+			s[i] = acc;
+			acc = op( std::move( acc ), std::move( x ) );
+		}
+	}
+}
+
+// 2 passes: chunk totals, then every chunk rescans starting from the combined totals left of it
+template<bool inclusive, typename T, typename Op>
+void scan( std::span<T> s,
+	std::optional<T> init,
+	Op op,
+	std::size_t grain,
+	ThreadPool& pool )
+{
+	if ( s.empty() )
+	{
+		return;
+	}
+	const Chunking<T> chunks{s.data(), s.size(), grain, pool.getThreadCount() + 1};
+	const std::size_t n = chunks.getCount();
+	if ( n == 1 || pool.getThreadCount() == 0 )
+	{
+		scanRange<inclusive>( s, 0, s.size(), std::move( init ), op );
+		return;
+	}
+	std::vector<Partial<T>> carry( n );
+	pool.forkJoin( n, [&]( std::size_t c )
+		{
+			const std::size_t b = chunks.begin( c );
+			const std::size_t e = chunks.end( c );
+			T acc = s[b];
+			for ( std::size_t i = b + 1; i < e; ++i )
+			{
+				acc = op( std::move( acc ), s[i] );
+			}
+			carry[c].value.emplace( std::move( acc ) );
+		}
+	);
+	// carry[c] := everything left of chunk c (exclusive prefix of the totals)
+	std::optional<T> running = std::move( init );
+	for ( std::size_t c = 0; c < n; ++c )
+	{
+		std::optional<T> total = std::move( carry[c].value );
+		carry[c].value = running;
+		running = running ?
+			op( std::move( *running ), std::move( *total ) ) :
+			std::move( total );
+	}
+	pool.forkJoin( n, [&]( std::size_t c )
+		{
+			scanRange<inclusive>( s, chunks.begin( c ), chunks.end( c ), std::move( carry[c].value ), op );
+		}
+	);
+}
+
+}//detail
+
+// in place: s[i] = s[0] op .. op s[i]
+template<typename T, typename Op = std::plus<>>
+void parallelInclusiveScan( std::span<T> s,
+	Op op = {},
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	detail::scan<true>( s, std::optional<T>{}, op, grain, pool );
+}
+
+// in place: s[i] = init op s[0] op .. op s[i - 1]
+template<typename T, typename Op = std::plus<>>
+void parallelExclusiveScan( std::span<T> s,
+	T init,
+	Op op = {},
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	detail::scan<false>( s, std::optional<T>{std::move( init )}, op, grain, pool );
+}
+
+
+// Vector overloads
+template<typename T, typename Alloc, typename ErrorPolicy, typename F>
+void parallelForEach( Vector<T, Alloc, ErrorPolicy>& v,
+	F fn,
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	parallelForEach( v.asSpan(), std::move( fn ), grain, pool );
+}
+
+// in place
+template<typename T, typename Alloc, typename ErrorPolicy, typename F>
+void parallelTransform( Vector<T, Alloc, ErrorPolicy>& v,
+	F fn,
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	parallelTransform( std::span<const T>{v.asSpan()}, v.asSpan(), std::move( fn ), grain, pool );
+}
+
+// into a new Vector of fn's result type
+template<typename T, typename Alloc, typename ErrorPolicy, typename F>
+auto parallelTransformed( const Vector<T, Alloc, ErrorPolicy>& v,
+	F fn,
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	using U = std::decay_t<std::invoke_result_t<F&, const T&>>;
+	Vector<U> out{std::max<std::size_t>( v.getSize(), 1 ), U{}};
+	parallelTransform( v.asSpan(), out.asSpan(), std::move( fn ), grain, pool );
+	out.erase( out.cbegin() + v.getSize(), out.cend() );
+	return out;
+}
+
+template<typename T, typename Alloc, typename ErrorPolicy, typename R, typename Op = std::plus<>>
+R parallelReduce( const Vector<T, Alloc, ErrorPolicy>& v,
+	R init,
+	Op op = {},
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	return parallelReduce( v.asSpan(), std::move( init ), std::move( op ), grain, pool );
+}
+
+template<typename T, typename Alloc, typename ErrorPolicy, typename Pred>
+std::size_t parallelCountIf( const Vector<T, Alloc, ErrorPolicy>& v,
+	Pred pred,
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	return parallelCountIf( v.asSpan(), std::move( pred ), grain, pool );
+}
+
+template<typename T, typename Alloc, typename ErrorPolicy, typename Op = std::plus<>>
+void parallelInclusiveScan( Vector<T, Alloc, ErrorPolicy>& v,
+	Op op = {},
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	parallelInclusiveScan( v.asSpan(), std::move( op ), grain, pool );
+}
+
+template<typename T, typename Alloc, typename ErrorPolicy, typename Op = std::plus<>>
+void parallelExclusiveScan( Vector<T, Alloc, ErrorPolicy>& v,
+	T init,
+	Op op = {},
+	std::size_t grain = 0,
+	ThreadPool& pool = ThreadPool::instance() )
+{
+	parallelExclusiveScan( v.asSpan(), std::move( init ), std::move( op ), grain, pool );
+}
+
+}//parallel
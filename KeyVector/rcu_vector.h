@@ -0,0 +1,333 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <span>
+#include "vector.h"
+
+
+//============================================================
+//	read-copy-update over Vector with epoch based reclamation
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 02:00
+//
+//	\brief	rcu::Domain: a global epoch counter and one cache line per reader thread
+//				holding the epoch it entered at (0 = not reading)
+//			entering a read section is a load of the global epoch and a store to the
+//				thread's own slot; nothing shared is written, so readers on different
+//				cores never contend on a line; sections nest (only the outermost
+//				one announces)
+//			RcuVector publishes every version with one atomic pointer exchange, then
+//				advances the epoch & tags the replaced version with it; a retired version
+//				is freed once every reader still inside a section entered at or after
+//				that tag - such a reader read the epoch after the exchange, so it can
+//				only have loaded a newer version
+//			writers serialize on a mutex; they are expected to be rare
+//=============================================================
+namespace rcu
+{
+
+class Domain final
+{
+public:
+	static constexpr std::size_t maxReaders = 256;
+private:
+	struct alignas( 64 ) Slot
+	{
+		std::atomic<std::uint64_t> epoch{0};
+		std::atomic<bool> taken{false};
+	};
+
+	// a thread's slot, claimed on its first read section and handed back when it exits
+	struct ThreadState
+	{
+		std::size_t slot;
+		unsigned depth;
+
+		ThreadState()
+			:
+			slot{Domain::instance().claimSlot()},
+			depth{0}
+		{
+
+		}
+		~ThreadState() noexcept
+		{
+			Domain::instance().m_slots[slot].epoch.store( 0, std::memory_order_relaxed );
+			Domain::instance().m_slots[slot].taken.store( false, std::memory_order_release );
+		}
+	};
+
+	std::atomic<std::uint64_t> m_epoch{1};
+	std::atomic<std::size_t> m_slotsInUse{0};	// high water mark; writers scan [0, m_slotsInUse)
+	Slot m_slots[maxReaders];
+
+	Domain() = default;
+
+	std::size_t claimSlot()
+	{
+		for ( std::size_t i = 0; i < maxReaders; ++i )
+		{
+			if ( !m_slots[i].taken.exchange( true, std::memory_order_acq_rel ) )
+			{
+				std::size_t inUse = m_slotsInUse.load( std::memory_order_relaxed );
+				while ( inUse < i + 1 && !m_slotsInUse.compare_exchange_weak( inUse, i + 1, std::memory_order_seq_cst ) )
+				{
+
+				}
+				return i;
+			}
+		}
+		throwException( "rcu::Domain ran out of reader slots." );
+	}
+
+	static ThreadState& local()
+	{
+		thread_local ThreadState state;
+		return state;
+	}
+public:
+	Domain( const Domain& rhs ) = delete;
+	Domain& operator=( const Domain& rhs ) = delete;
+
+	void enter()
+	{
+		ThreadState& state = local();
+		if ( state.depth++ == 0 )
+		{
+			// seq_cst: the announcement must be visible before the caller loads any pointer
+			m_slots[state.slot].epoch.store( m_epoch.load( std::memory_order_seq_cst ), std::memory_order_seq_cst );
+		}
+	}
+
+	void exit() noexcept
+	{
+		ThreadState& state = local();
+		assert( state.depth > 0 );
+		if ( --state.depth == 0 )
+		{
+			m_slots[state.slot].epoch.store( 0, std::memory_order_release );
+		}
+	}
+
+	// call after publishing; returns the tag for whatever the publish replaced
+	std::uint64_t advance() noexcept
+	{
+		return m_epoch.fetch_add( 1, std::memory_order_seq_cst ) + 1;
+	}
+
+	// epoch of the oldest read section in flight, max() if there is none
+	std::uint64_t getOldestActive() const noexcept
+	{
+		std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+		const std::size_t inUse = m_slotsInUse.load( std::memory_order_seq_cst );
+		for ( std::size_t i = 0; i < inUse; ++i )
+		{
+			const std::uint64_t e = m_slots[i].epoch.load( std::memory_order_seq_cst );
+			if ( e != 0 && e < oldest )
+			{
+				oldest = e;
+			}
+		}
+		return oldest;
+	}
+
+	std::uint64_t getEpoch() const noexcept
+	{
+		return m_epoch.load( std::memory_order_relaxed );
+	}
+
+	static Domain& instance()
+	{
+		static Domain domain;
+		return domain;
+	}
+};
+
+}//rcu
+
+
+//============================================================
+//	\class	RcuVector<T, Alloc>
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 02:00
+//
+//	\brief	read mostly Vector: read() hands out a Snapshot - an immutable version
+//				that stays valid for the Snapshot's lifetime, whatever writers do
+//			update( fn ) copies the current version, lets fn edit the copy and
+//				publishes it; assign() publishes a ready made Vector
+//			retired versions are reclaimed by the writers (see rcu::Domain)
+//=============================================================
+template<typename T, typename Alloc = std::allocator<T>>
+class RcuVector
+{
+	using VectorType = Vector<T, Alloc>;
+
+	struct Retired
+	{
+		VectorType* version;
+		std::uint64_t epoch;
+	};
+
+	std::atomic<VectorType*> m_current;
+	std::mutex m_writeMutex;
+	Vector<Retired> m_retired;
+
+	// m_writeMutex held
+	void publish( VectorType* next )
+	{
+		VectorType* prev = m_current.exchange( next, std::memory_order_seq_cst );
+		m_retired.pushBack( Retired{prev, rcu::Domain::instance().advance()} );
+		reclaimLocked();
+	}
+
+	std::size_t reclaimLocked() noexcept
+	{
+		const std::uint64_t oldest = rcu::Domain::instance().getOldestActive();
+		m_retired.eraseIf( [oldest]( const Retired& r )
+			{
+				if ( r.epoch <= oldest )
+				{
+					delete r.version;
+					return true;
+				}
+				return false;
+			} );
+		return m_retired.getSize();
+	}
+public:
+	class Snapshot
+	{
+		const VectorType* m_v;
+	public:
+		explicit Snapshot( const RcuVector& owner )
+			:
+			m_v{nullptr}
+		{
+			rcu::Domain::instance().enter();
+			m_v = owner.m_current.load( std::memory_order_seq_cst );
+		}
+		Snapshot( const Snapshot& rhs ) = delete;
+		Snapshot& operator=( const Snapshot& rhs ) = delete;
+		Snapshot( Snapshot&& rhs ) noexcept
+			:
+			m_v{std::exchange( rhs.m_v, nullptr )}
+		{
+
+		}
+		Snapshot& operator=( Snapshot&& rhs ) = delete;
+		~Snapshot() noexcept
+		{
+			if ( m_v )
+			{
+				rcu::Domain::instance().exit();
+			}
+		}
+
+		const T& operator[]( std::size_t i ) const noexcept
+		{
+			return m_v->data()[i];
+		}
+		const T* begin() const noexcept
+		{
+			return m_v->data();
+		}
+		const T* end() const noexcept
+		{
+			return m_v->data() + m_v->getSize();
+		}
+		const T* data() const noexcept
+		{
+			return m_v->data();
+		}
+		std::span<const T> asSpan() const noexcept
+		{
+			return {m_v->data(), m_v->getSize()};
+		}
+		std::size_t getSize() const noexcept
+		{
+			return m_v->getSize();
+		}
+		bool isEmpty() const noexcept
+		{
+			return m_v->getSize() == 0;
+		}
+	};
+
+	explicit RcuVector( VectorType v = VectorType{} )
+		:
+		m_current{new VectorType{std::move( v )}},
+		m_retired{8}
+	{
+
+	}
+	RcuVector( const RcuVector& rhs ) = delete;
+	RcuVector& operator=( const RcuVector& rhs ) = delete;
+	// no reader may still hold a Snapshot
+	~RcuVector() noexcept
+	{
+		for ( const Retired& r : m_retired )
+		{
+			delete r.version;
+		}
+		delete m_current.load( std::memory_order_relaxed );
+	}
+
+	Snapshot read() const
+	{
+		return Snapshot{*this};
+	}
+
+	template<typename F>
+	void update( F&& fn )
+	{
+		std::lock_guard<std::mutex> lock{m_writeMutex};
+		auto next = std::make_unique<VectorType>( *m_current.load( std::memory_order_relaxed ) );
+		fn( *next );
+		publish( next.release() );
+	}
+
+	void assign( VectorType v )
+	{
+		auto next = std::make_unique<VectorType>( std::move( v ) );
+		std::lock_guard<std::mutex> lock{m_writeMutex};
+		publish( next.release() );
+	}
+
+	void pushBack( const T& val )
+	{
+		update( [&val]( VectorType& v )
+			{
+				v.pushBack( val );
+			} );
+	}
+
+	void append( const T* first,
+		const T* last )
+	{
+		update( [first, last]( VectorType& v )
+			{
+				v.append( first, last );
+			} );
+	}
+
+	// frees what no reader can see any more; returns the number of versions still waiting
+	std::size_t reclaim()
+	{
+		std::lock_guard<std::mutex> lock{m_writeMutex};
+		return reclaimLocked();
+	}
+
+	std::size_t getRetiredCount()
+	{
+		std::lock_guard<std::mutex> lock{m_writeMutex};
+		return m_retired.getSize();
+	}
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <new>
+#include <cstring>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include "custom_exception.h"
+
+
+//============================================================
+//	element relocation for the ring & incremental containers
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 10:30
+//
+//	\brief	the same tiers Vector picks for its own growth:
+//				trivially copyable types are memcpy'd,
+//				nothrow movable ones are moved,
+//				& the rest is copied, as a throwing move could leave both buffers half built
+//			construct() leaves the sources alive; if a copy throws, what it built is destroyed
+//				and the sources are as before, so callers can roll back (strong guarantee)
+//=============================================================
+namespace relocation
+{
+
+template<typename T>
+inline constexpr bool isBitwise = std::is_trivially_copyable_v<T>;
+
+template<typename T>
+inline constexpr bool isNothrow = isBitwise<T> || std::is_nothrow_move_constructible_v<T>;
+
+template<typename T>
+void destroy( T* p,
+	std::size_t n ) noexcept
+{
+	if constexpr ( !std::is_trivially_destructible_v<T> )
+	{
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			p[i].~T();
+		}
+	}
+}
+
+// constructs n elements at uninitialized dst from src (moved, or copied if moving may throw)
+template<typename T>
+void construct( T* dst,
+	T* src,
+	std::size_t n ) noexcept( isNothrow<T> )
+{
+	if constexpr ( isBitwise<T> )
+	{
+		if ( n > 0 )
+		{
+			std::memcpy( static_cast<void*>( dst ), src, n * sizeof( T ) );
+		}
+	}
+	else if constexpr ( std::is_nothrow_move_constructible_v<T> )
+	{
+		for ( std::size_t i = 0; i < n; ++i )
+		{
+			::new ( dst + i ) T(std::move( src[i] ));
+		}
+	}
+	else
+	{
+		std::size_t i = 0;
+#ifdef KEYVECTOR_EXCEPTIONS
+		try
+		{
+#endif
+			for ( ; i < n; ++i )
+			{
+				::new ( dst + i ) T(std::as_const( src[i] ));
+			}
+#ifdef KEYVECTOR_EXCEPTIONS
+		}
+		catch ( ... )
+		{
+			destroy( dst, i );
+			throw;
+		}
+#endif
+	}
+}
+
+// moves n elements to uninitialized dst & destroys the sources; they are untouched if it throws
+template<typename T>
+void relocate( T* dst,
+	T* src,
+	std::size_t n ) noexcept( isNothrow<T> )
+{
+	construct( dst, src, n );
+	destroy( src, n );
+}
+
+}// namespace relocation
@@ -0,0 +1,417 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+#include <numeric>
+#include <algorithm>
+#include <type_traits>
+#include "vector.h"
+#include "streaming.h"
+
+
+//============================================================
+//	read optimized lower_bound indexes over sorted keys
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 00:20
+//
+//	\brief	built once from a sorted Vector (or from unsorted keys, which get sorted);
+//				results are positions in the source - the original index of the key -
+//				or npos if every key is smaller than the query
+//			EytzingerIndex: the keys in BFS order of the implicit binary search tree,
+//				so all descendants a few levels below a node share one cache line,
+//				which is prefetched ahead of the compares; the search loop is branchless
+//			StaticBTreeIndex: implicit (B + 1)-ary tree with one 64 byte cache line of
+//				keys per node, every level costs a single (SIMD friendly) node scan
+//			lowerBound( queries, out ) interleaves a group of queries level by level, so
+//				their cache misses overlap instead of queueing up one search at a time
+//=============================================================
+namespace search
+{
+
+inline constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+namespace detail
+{
+
+inline constexpr std::size_t cacheLineSize = 64;
+inline constexpr std::size_t batchSize = 16;	// queries in flight per interleaved group
+
+// sorted keys + their source positions
+template<typename T>
+struct SortedKeys
+{
+	Vector<T> keys;
+	Vector<std::size_t> positions;
+};
+
+template<typename T>
+SortedKeys<T> sortWithPositions( std::span<const T> values )
+{
+	const std::size_t n = values.size();
+	Vector<std::size_t> order{std::max<std::size_t>( n, 1 ), 0};
+	order.erase( order.cbegin() + n, order.cend() );
+	std::iota( order.begin(), order.end(), std::size_t{0} );
+	std::stable_sort( order.begin(), order.end(), [values]( std::size_t a, std::size_t b )
+		{
+			return values[a] < values[b];
+		}
+	);
+	SortedKeys<T> sorted{Vector<T>{std::max<std::size_t>( n, 1 )}, std::move( order )};
+	for ( std::size_t i : sorted.positions )
+	{
+		sorted.keys.pushBack( values[i] );
+	}
+	return sorted;
+}
+
+template<typename T>
+std::size_t alignedOffset( const T* p ) noexcept
+{
+	const std::size_t misalignment = reinterpret_cast<std::uintptr_t>( p ) % cacheLineSize;
+	return misalignment == 0 ?
+		0 :
+		( cacheLineSize - misalignment ) / sizeof( T );
+}
+
+}//detail
+
+
+//============================================================
+//	\class	EytzingerIndex<T>
+//	\brief	tree slot k (1 based) has children 2k and 2k + 1; a search walks
+//				k = 2k + ( key[k] < x ) to the bottom and the answer is the last
+//				node where it went left, recovered by stripping the trailing 1 bits
+//=============================================================
+template<typename T>
+class EytzingerIndex
+{
+	static_assert( std::is_trivially_copyable_v<T>, "EytzingerIndex keys are compared & copied as plain values." );
+	// slots per prefetched line: the block of descendants 3 levels down for 8 byte keys, 4 for 4 byte ones..
+	static constexpr std::size_t lineKeys = std::max<std::size_t>( 1, detail::cacheLineSize / sizeof( T ) );
+
+	std::size_t m_n;
+	std::size_t m_offset;					// m_storage[m_offset] is slot 0, cache line aligned
+	Vector<T> m_storage;
+	Vector<std::size_t> m_positions;		// per slot
+
+	const T* tree() const noexcept
+	{
+		return m_storage.data() + m_offset;
+	}
+
+	// in-order walk of the implicit tree hands out the sorted keys; returns the next key to place
+	std::size_t build( std::size_t k,
+		std::size_t i,
+		const T* keys,
+		const std::size_t* positions )
+	{
+		if ( k <= m_n )
+		{
+			i = build( 2 * k, i, keys, positions );
+			m_storage[m_offset + k] = keys[i];
+			m_positions[k] = positions ? positions[i] : i;
+			i = build( 2 * k + 1, i + 1, keys, positions );
+		}
+		return i;
+	}
+
+	std::size_t finish( std::size_t k ) const noexcept
+	{
+		k >>= std::countr_one( k ) + 1;
+		return k == 0 ?
+			npos :
+			m_positions[k];
+	}
+public:
+	EytzingerIndex( std::span<const T> sortedKeys,
+		const std::size_t* positions = nullptr )
+		:
+		m_n{sortedKeys.size()},
+		m_offset{0},
+		m_storage{m_n + 1 + lineKeys, T{}},
+		m_positions{m_n + 1, npos}
+	{
+		assert( std::is_sorted( sortedKeys.begin(), sortedKeys.end() ) );
+		m_offset = detail::alignedOffset( m_storage.data() );
+		build( 1, 0, sortedKeys.data(), positions );
+	}
+	template<typename Alloc, typename ErrorPolicy>
+	explicit EytzingerIndex( const Vector<T, Alloc, ErrorPolicy>& sortedKeys )
+		:
+		EytzingerIndex(sortedKeys.asSpan())
+	{
+
+	}
+
+	// keys in any order: answers are their indices in `values`
+	static EytzingerIndex fromUnsorted( std::span<const T> values )
+	{
+		detail::SortedKeys<T> sorted = detail::sortWithPositions( values );
+		return EytzingerIndex{sorted.keys.asSpan(), sorted.positions.data()};
+	}
+
+	// position of the first key >= x, npos if none
+	std::size_t lowerBound( const T& x ) const noexcept
+	{
+		const T* t = tree();
+		std::size_t k = 1;
+		while ( k <= m_n )
+		{
+			streaming::prefetch( t + k * lineKeys );
+			k = 2 * k + ( t[k] < x );
+		}
+		return finish( k );
+	}
+
+	// out[i] = lowerBound( queries[i] ), groups of queries descend in lockstep
+	void lowerBound( std::span<const T> queries,
+		std::span<std::size_t> out ) const noexcept
+	{
+		assert( out.size() >= queries.size() );
+		const T* t = tree();
+		const int depth = std::bit_width( m_n );	// levels of the tree, the last one partial
+		std::size_t k[detail::batchSize];
+		for ( std::size_t base = 0; base < queries.size(); base += detail::batchSize )
+		{
+			const std::size_t g = std::min( detail::batchSize, queries.size() - base );
+			const T* q = queries.data() + base;
+			for ( std::size_t j = 0; j < g; ++j )
+			{
+				k[j] = 1;
+			}
+			for ( int level = 0; level < depth - 1; ++level )
+			{
+				// every level but the last is complete
+				for ( std::size_t j = 0; j < g; ++j )
+				{
+					streaming::prefetch( t + k[j] * lineKeys );
+					k[j] = 2 * k[j] + ( t[k[j]] < q[j] );
+				}
+			}
+			for ( std::size_t j = 0; j < g; ++j )
+			{
+				if ( k[j] <= m_n )
+				{
+					k[j] = 2 * k[j] + ( t[k[j]] < q[j] );
+				}
+				out[base + j] = finish( k[j] );
+			}
+		}
+	}
+
+	// position of a key equal to x, npos if there's none
+	std::size_t find( const T& x ) const noexcept
+	{
+		const T* t = tree();
+		std::size_t k = 1;
+		while ( k <= m_n )
+		{
+			streaming::prefetch( t + k * lineKeys );
+			k = 2 * k + ( t[k] < x );
+		}
+		k >>= std::countr_one( k ) + 1;
+		return k != 0 && !( x < t[k] ) ?
+			m_positions[k] :
+			npos;
+	}
+
+	std::size_t getSize() const noexcept
+	{
+		return m_n;
+	}
+	std::size_t getSizeInBytes() const noexcept
+	{
+		return m_storage.getCapacity() * sizeof( T ) + m_positions.getCapacity() * sizeof( std::size_t );
+	}
+};
+
+
+//============================================================
+//	\class	StaticBTreeIndex<T>
+//	\brief	node k holds B = 64 / sizeof( T ) keys (one cache line) and has
+//				children k * ( B + 1 ) + i + 1, i in [0, B]; unused slots hold
+//				the largest T and come after every real key in order
+//=============================================================
+template<typename T>
+class StaticBTreeIndex
+{
+	static_assert( std::is_arithmetic_v<T>, "StaticBTreeIndex pads nodes with numeric_limits<T>::max()." );
+	static constexpr std::size_t B = std::max<std::size_t>( 2, detail::cacheLineSize / sizeof( T ) );
+
+	std::size_t m_n;
+	std::size_t m_nodes;
+	std::size_t m_offset;
+	Vector<T> m_storage;
+	Vector<std::size_t> m_positions;	// per slot, npos for padding
+
+	const T* node( std::size_t k ) const noexcept
+	{
+		return m_storage.data() + m_offset + k * B;
+	}
+
+	static constexpr std::size_t child( std::size_t k,
+		std::size_t i ) noexcept
+	{
+		return k * ( B + 1 ) + i + 1;
+	}
+
+	// keys of the node < x; fixed trip count, compiles to a vector compare + mask count
+	static std::size_t rank( const T* keys,
+		const T& x ) noexcept
+	{
+		std::size_t r = 0;
+		for ( std::size_t j = 0; j < B; ++j )
+		{
+			r += keys[j] < x;
+		}
+		return r;
+	}
+
+	void build( std::size_t k,
+		std::size_t& t,
+		const T* keys,
+		const std::size_t* positions )
+	{
+		if ( k >= m_nodes )
+		{
+			return;
+		}
+		T* slots = m_storage.data() + m_offset + k * B;
+		for ( std::size_t i = 0; i < B; ++i )
+		{
+			build( child( k, i ), t, keys, positions );
+			if ( t < m_n )
+			{
+				slots[i] = keys[t];
+				m_positions[k * B + i] = positions ? positions[t] : t;
+				++t;
+			}
+		}
+		build( child( k, B ), t, keys, positions );
+	}
+public:
+	StaticBTreeIndex( std::span<const T> sortedKeys,
+		const std::size_t* positions = nullptr )
+		:
+		m_n{sortedKeys.size()},
+		m_nodes{( m_n + B - 1 ) / B},
+		m_offset{0},
+		m_storage{m_nodes * B + B, std::numeric_limits<T>::max()},
+		m_positions{std::max<std::size_t>( m_nodes * B, 1 ), npos}
+	{
+		assert( std::is_sorted( sortedKeys.begin(), sortedKeys.end() ) );
+		m_offset = detail::alignedOffset( m_storage.data() );
+		std::size_t t = 0;
+		build( 0, t, sortedKeys.data(), positions );
+	}
+	template<typename Alloc, typename ErrorPolicy>
+	explicit StaticBTreeIndex( const Vector<T, Alloc, ErrorPolicy>& sortedKeys )
+		:
+		StaticBTreeIndex(sortedKeys.asSpan())
+	{
+
+	}
+
+	static StaticBTreeIndex fromUnsorted( std::span<const T> values )
+	{
+		detail::SortedKeys<T> sorted = detail::sortWithPositions( values );
+		return StaticBTreeIndex{sorted.keys.asSpan(), sorted.positions.data()};
+	}
+
+	std::size_t lowerBound( const T& x ) const noexcept
+	{
+		std::size_t slot = npos;
+		std::size_t k = 0;
+		while ( k < m_nodes )
+		{
+			const std::size_t i = rank( node( k ), x );
+			slot = i < B ?
+				k * B + i :
+				slot;
+			k = child( k, i );
+		}
+		return slot == npos ?
+			npos :
+			m_positions[slot];
+	}
+
+	void lowerBound( std::span<const T> queries,
+		std::span<std::size_t> out ) const noexcept
+	{
+		assert( out.size() >= queries.size() );
+		std::size_t k[detail::batchSize];
+		std::size_t slot[detail::batchSize];
+		for ( std::size_t base = 0; base < queries.size(); base += detail::batchSize )
+		{
+			const std::size_t g = std::min( detail::batchSize, queries.size() - base );
+			const T* q = queries.data() + base;
+			for ( std::size_t j = 0; j < g; ++j )
+			{
+				k[j] = 0;
+				slot[j] = npos;
+			}
+			bool active = m_nodes > 0;
+			while ( active )
+			{
+				active = false;
+				for ( std::size_t j = 0; j < g; ++j )
+				{
+					if ( k[j] < m_nodes )
+					{
+						const std::size_t i = rank( node( k[j] ), q[j] );
+						slot[j] = i < B ?
+							k[j] * B + i :
+							slot[j];
+						k[j] = child( k[j], i );
+						if ( k[j] < m_nodes )
+						{
+							streaming::prefetch( node( k[j] ) );
+							active = true;
+						}
+					}
+				}
+			}
+			for ( std::size_t j = 0; j < g; ++j )
+			{
+				out[base + j] = slot[j] == npos ?
+					npos :
+					m_positions[slot[j]];
+			}
+		}
+	}
+
+	std::size_t find( const T& x ) const noexcept
+	{
+		std::size_t slot = npos;
+		std::size_t k = 0;
+		while ( k < m_nodes )
+		{
+			const T* keys = node( k );
+			const std::size_t i = rank( keys, x );
+			if ( i < B && keys[i] == x && m_positions[k * B + i] != npos )
+			{
+				slot = k * B + i;	// deeper equal keys only exist with duplicates, any of them will do
+				break;
+			}
+			k = child( k, i );
+		}
+		return slot == npos ?
+			npos :
+			m_positions[slot];
+	}
+
+	std::size_t getSize() const noexcept
+	{
+		return m_n;
+	}
+	std::size_t getSizeInBytes() const noexcept
+	{
+		return m_storage.getCapacity() * sizeof( T ) + m_positions.getCapacity() * sizeof( std::size_t );
+	}
+};
+
+}//search
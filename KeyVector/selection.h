@@ -0,0 +1,428 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <limits>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include "vector.h"
+#include "compaction.h"
+#if defined __AVX2__ || defined __AVX512F__
+#	include <immintrin.h>
+#endif
+
+
+//============================================================
+//	gather, scatter & stream compaction kernels for columnar selection
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 07:00
+//
+//	\brief	gather:		out[i] = src[idx[i]]
+//			scatter:	dst[idx[i]] = values[i]; on repeated indices the last one wins
+//			compress:	the src[i] with mask[i] != 0, in order (a byte per element)
+//			selectIf:	the src[i] pred accepts, in order
+//			4 & 8 byte trivially copyable types take the vector paths, chosen at compile
+//				time like compaction.h: AVX-512F gathers, scatters & compresses; AVX2
+//				gathers and compresses through a permute LUT, its scatter stays scalar
+//			the gather instructions sign extend 32 bit indices, so only 32 bit indices
+//				into a source of less than 2^31 elements are vectorized
+//			no software prefetching: every access is independent, so the core already
+//				overlaps the misses and prefetches ahead measured no faster (benchSelection)
+//			everything else (and all tails) runs the scalar loops, which the *Scalar
+//				functions expose on their own
+//=============================================================
+namespace selection
+{
+
+namespace detail
+{
+
+template<typename T>
+inline constexpr bool isSimdMovable = std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>
+	&& ( sizeof( T ) == 4 || sizeof( T ) == 8 );
+
+template<typename T, typename Index>
+inline constexpr bool isSimdGatherable = isSimdMovable<T> && std::is_integral_v<Index> && sizeof( Index ) == 4;
+
+#if defined __AVX2__ || defined __AVX512F__
+#	if defined __AVX512F__
+template<typename T>
+inline constexpr std::size_t lanes = 64 / sizeof( T );
+#	else
+template<typename T>
+inline constexpr std::size_t lanes = 32 / sizeof( T );
+#	endif
+
+// out[0, lanes) = idx gathered from src; idx & src as in gather()
+template<typename T, typename Index>
+void gatherBlock( const T* src,
+	const Index* idx,
+	T* out ) noexcept
+{
+#	if defined __AVX512F__
+	// the all lanes masked forms: the plain ones start from an undefined register GCC warns about
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		const __m512i vidx = _mm512_loadu_si512( idx );
+		_mm512_storeu_si512( out, _mm512_mask_i32gather_epi32( _mm512_setzero_si512(), 0xFFFF, vidx, src, 4 ) );
+	}
+	else
+	{
+		const __m256i vidx = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( idx ) );
+		_mm512_storeu_si512( out, _mm512_mask_i32gather_epi64( _mm512_setzero_si512(), 0xFF, vidx, src, 8 ) );
+	}
+#	else
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		const __m256i vidx = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( idx ) );
+		_mm256_storeu_si256( reinterpret_cast<__m256i*>( out ), _mm256_i32gather_epi32( reinterpret_cast<const int*>( src ), vidx, 4 ) );
+	}
+	else
+	{
+		const __m128i vidx = _mm_loadu_si128( reinterpret_cast<const __m128i*>( idx ) );
+		_mm256_storeu_si256( reinterpret_cast<__m256i*>( out ), _mm256_i32gather_epi64( reinterpret_cast<const long long*>( src ), vidx, 8 ) );
+	}
+#	endif
+}
+
+// the lanes of src[0, lanes) whose bit is set in keep, packed to the front of a full block at out
+template<typename T>
+void compressBlock( const T* src,
+	unsigned keep,
+	T* out ) noexcept
+{
+#	if defined __AVX512F__
+	const __m512i block = _mm512_loadu_si512( src );
+	const __m512i packed = sizeof( T ) == 4 ?
+		_mm512_maskz_compress_epi32( static_cast<__mmask16>( keep ), block ) :
+		_mm512_maskz_compress_epi64( static_cast<__mmask8>( keep ), block );
+	_mm512_storeu_si512( out, packed );
+#	else
+	const __m256i block = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( src ) );
+	const std::uint32_t* perm = sizeof( T ) == 4 ?
+		compaction::detail::permute8x32[keep].data() :
+		compaction::detail::permute4x64[keep].data();
+	const __m256i packed = _mm256_permutevar8x32_epi32( block, _mm256_loadu_si256( reinterpret_cast<const __m256i*>( perm ) ) );
+	_mm256_storeu_si256( reinterpret_cast<__m256i*>( out ), packed );
+#	endif
+}
+
+// bit lane set for every non zero byte of mask[0, lanes<T>)
+template<typename T>
+unsigned maskBits( const std::uint8_t* mask ) noexcept
+{
+#	if defined __AVX512F__
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		const __m512i wide = _mm512_maskz_cvtepu8_epi32( 0xFFFF, _mm_loadu_si128( reinterpret_cast<const __m128i*>( mask ) ) );
+		return _mm512_test_epi32_mask( wide, wide );
+	}
+	else
+	{
+		const __m512i wide = _mm512_maskz_cvtepu8_epi64( 0xFF, _mm_loadl_epi64( reinterpret_cast<const __m128i*>( mask ) ) );
+		return _mm512_test_epi64_mask( wide, wide );
+	}
+#	else
+	__m128i bytes;
+	if constexpr ( sizeof( T ) == 4 )
+	{
+		bytes = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( mask ) );
+	}
+	else
+	{
+		std::uint32_t four;
+		std::memcpy( &four, mask, sizeof( four ) );
+		bytes = _mm_cvtsi32_si128( static_cast<int>( four ) );
+	}
+	const unsigned zero = static_cast<unsigned>( _mm_movemask_epi8( _mm_cmpeq_epi8( bytes, _mm_setzero_si128() ) ) );
+	return ~zero & ( ( 1u << lanes<T> ) - 1 );
+#	endif
+}
+
+// compresses the whole blocks of src[0, n) by keepOf( i ) (lane mask of block i..); returns {consumed, written}
+template<typename T, typename KeepOf>
+std::pair<std::size_t, std::size_t> compressBlocks( const T* src,
+	std::size_t n,
+	T* out,
+	KeepOf& keepOf )
+{
+	constexpr std::size_t width = lanes<T>;
+	std::size_t k = 0;
+	std::size_t i = 0;
+	for ( ; i + width <= n; i += width )
+	{
+		const unsigned keep = keepOf( i );
+		if ( keep == ( 1u << width ) - 1 )
+		{
+			std::memcpy( out + k, src + i, sizeof( T ) * width );
+			k += width;
+			continue;
+		}
+		compressBlock( src + i, keep, out + k );
+		k += static_cast<std::size_t>( std::popcount( keep ) );
+	}
+	return {i, k};
+}
+#endif
+
+}//detail
+
+
+template<typename T, typename Index>
+void gatherScalar( std::span<const T> src,
+	std::span<const Index> idx,
+	std::span<T> out,
+	std::size_t from = 0 )
+{
+	assert( out.size() >= idx.size() );
+	for ( std::size_t i = from; i < idx.size(); ++i )
+	{
+		assert( static_cast<std::size_t>( idx[i] ) < src.size() );
+		out[i] = src[idx[i]];
+	}
+}
+
+template<typename T, typename Index>
+void gather( std::span<const T> src,
+	std::span<const Index> idx,
+	std::span<T> out )
+{
+	assert( out.size() >= idx.size() );
+	std::size_t i = 0;
+#if defined __AVX2__ || defined __AVX512F__
+	if constexpr ( detail::isSimdGatherable<T, Index> )
+	{
+		if ( src.size() <= static_cast<std::size_t>( std::numeric_limits<std::int32_t>::max() ) )
+		{
+			constexpr std::size_t width = detail::lanes<T>;
+			for ( ; i + width <= idx.size(); i += width )
+			{
+				detail::gatherBlock( src.data(), idx.data() + i, out.data() + i );
+			}
+		}
+	}
+#endif
+	gatherScalar( src, idx, out, i );
+}
+
+template<typename T, typename Index>
+void scatterScalar( std::span<const T> values,
+	std::span<const Index> idx,
+	std::span<T> dst,
+	std::size_t from = 0 )
+{
+	assert( values.size() >= idx.size() );
+	for ( std::size_t i = from; i < idx.size(); ++i )
+	{
+		assert( static_cast<std::size_t>( idx[i] ) < dst.size() );
+		dst[idx[i]] = values[i];
+	}
+}
+
+template<typename T, typename Index>
+void scatter( std::span<const T> values,
+	std::span<const Index> idx,
+	std::span<T> dst )
+{
+	assert( values.size() >= idx.size() );
+	std::size_t i = 0;
+#if defined __AVX512F__
+	if constexpr ( detail::isSimdGatherable<T, Index> )
+	{
+		if ( dst.size() <= static_cast<std::size_t>( std::numeric_limits<std::int32_t>::max() ) )
+		{
+			constexpr std::size_t width = detail::lanes<T>;
+			// lanes are written low to high, so a repeated index keeps the last value like the scalar loop
+			for ( ; i + width <= idx.size(); i += width )
+			{
+				const __m512i v = _mm512_loadu_si512( values.data() + i );
+				if constexpr ( sizeof( T ) == 4 )
+				{
+					_mm512_i32scatter_epi32( dst.data(), _mm512_loadu_si512( idx.data() + i ), v, 4 );
+				}
+				else
+				{
+					_mm512_i32scatter_epi64( dst.data(), _mm256_loadu_si256( reinterpret_cast<const __m256i*>( idx.data() + i ) ), v, 8 );
+				}
+			}
+		}
+	}
+#endif
+	scatterScalar( values, idx, dst, i );
+}
+
+// out has to hold src.size() elements; returns the number kept
+template<typename T>
+std::size_t compressScalar( std::span<const T> src,
+	std::span<const std::uint8_t> mask,
+	std::span<T> out )
+{
+	assert( mask.size() >= src.size() && out.size() >= src.size() );
+	std::size_t k = 0;
+	if constexpr ( std::is_trivially_copyable_v<T> && sizeof( T ) <= 16 )
+	{
+		// unconditional copy, advance only on keep - no unpredictable branch
+		for ( std::size_t i = 0; i < src.size(); ++i )
+		{
+			out[k] = src[i];
+			k += mask[i] != 0;
+		}
+	}
+	else
+	{
+		for ( std::size_t i = 0; i < src.size(); ++i )
+		{
+			if ( mask[i] )
+			{
+				out[k++] = src[i];
+			}
+		}
+	}
+	return k;
+}
+
+template<typename T>
+std::size_t compress( std::span<const T> src,
+	std::span<const std::uint8_t> mask,
+	std::span<T> out )
+{
+	assert( mask.size() >= src.size() && out.size() >= src.size() );
+#if defined __AVX2__ || defined __AVX512F__
+	if constexpr ( detail::isSimdMovable<T> )
+	{
+		auto keepOf = [&mask]( std::size_t i )
+		{
+			return detail::maskBits<T>( mask.data() + i );
+		};
+		const auto [consumed, written] = detail::compressBlocks( src.data(), src.size(), out.data(), keepOf );
+		return written + compressScalar( src.subspan( consumed ), mask.subspan( consumed ), out.subspan( written ) );
+	}
+#endif
+	return compressScalar( src, mask, out );
+}
+
+// out has to hold src.size() elements; returns the number selected
+template<typename T, typename Pred>
+std::size_t selectIf( std::span<const T> src,
+	std::span<T> out,
+	Pred pred )
+{
+	assert( out.size() >= src.size() );
+	std::size_t i = 0;
+	std::size_t k = 0;
+#if defined __AVX2__ || defined __AVX512F__
+	if constexpr ( detail::isSimdMovable<T> )
+	{
+		auto keepOf = [&src, &pred]( std::size_t b )
+		{
+			unsigned keep = 0;
+			for ( std::size_t lane = 0; lane < detail::lanes<T>; ++lane )
+			{
+				keep |= static_cast<unsigned>( static_cast<bool>( pred( src[b + lane] ) ) ) << lane;
+			}
+			return keep;
+		};
+		const auto [consumed, written] = detail::compressBlocks( src.data(), src.size(), out.data(), keepOf );
+		i = consumed;
+		k = written;
+	}
+#endif
+	for ( ; i < src.size(); ++i )
+	{
+		if constexpr ( std::is_trivially_copyable_v<T> && sizeof( T ) <= 16 )
+		{
+			out[k] = src[i];
+			k += static_cast<bool>( pred( src[i] ) );
+		}
+		else if ( pred( src[i] ) )
+		{
+			out[k++] = src[i];
+		}
+	}
+	return k;
+}
+
+
+// Vector overloads, into a new Vector; trivial types are written straight into its buffer,
+//	anything else has to be default constructible
+namespace detail
+{
+
+template<typename T, typename Kernel>
+Vector<T> collect( std::size_t maxCount,
+	Kernel kernel )
+{
+	Vector<T> out{std::max<std::size_t>( maxCount, 1 )};
+	if constexpr ( std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> )
+	{
+		out.appendInPlace( maxCount, [&kernel, maxCount]( T* dst )
+			{
+				return kernel( std::span<T>{dst, maxCount} );
+			} );
+	}
+	else
+	{
+		Vector<T> staging{maxCount};
+		// non trivial T: default construct the slots, let the kernel assign them
+		for ( std::size_t i = 0; i < maxCount; ++i )
+		{
+			staging.emplaceBack();
+		}
+		const std::size_t written = kernel( staging.asSpan() );
+		for ( std::size_t i = 0; i < written; ++i )
+		{
+			out.pushBack( std::move( staging[i] ) );
+		}
+	}
+	return out;
+}
+
+}//detail
+
+template<typename T, typename Alloc, typename ErrorPolicy, typename Index, typename IndexAlloc, typename IndexErrorPolicy>
+Vector<T> gather( const Vector<T, Alloc, ErrorPolicy>& src,
+	const Vector<Index, IndexAlloc, IndexErrorPolicy>& idx )
+{
+	return detail::collect<T>( idx.getSize(), [&]( std::span<T> out )
+		{
+			gather( src.asSpan(), idx.asSpan(), out );
+			return idx.getSize();
+		} );
+}
+
+// dst has to be large enough for every index
+template<typename T, typename Alloc, typename ErrorPolicy, typename Index, typename IndexAlloc, typename IndexErrorPolicy>
+void scatter( const Vector<T, Alloc, ErrorPolicy>& values,
+	const Vector<Index, IndexAlloc, IndexErrorPolicy>& idx,
+	Vector<T, Alloc, ErrorPolicy>& dst )
+{
+	assert( values.getSize() == idx.getSize() );
+	scatter( values.asSpan(), idx.asSpan(), dst.asSpan() );
+}
+
+template<typename T, typename Alloc, typename ErrorPolicy, typename MaskAlloc, typename MaskErrorPolicy>
+Vector<T> compress( const Vector<T, Alloc, ErrorPolicy>& src,
+	const Vector<std::uint8_t, MaskAlloc, MaskErrorPolicy>& mask )
+{
+	assert( mask.getSize() == src.getSize() );
+	return detail::collect<T>( src.getSize(), [&]( std::span<T> out )
+		{
+			return compress( src.asSpan(), mask.asSpan(), out );
+		} );
+}
+
+template<typename T, typename Alloc, typename ErrorPolicy, typename Pred>
+Vector<T> selectIf( const Vector<T, Alloc, ErrorPolicy>& src,
+	Pred pred )
+{
+	return detail::collect<T>( src.getSize(), [&]( std::span<T> out )
+		{
+			return selectIf( src.asSpan(), out, pred );
+		} );
+}
+
+}//selection
@@ -0,0 +1,735 @@
+#pragma once
+
+#include <new>
+#include <cassert>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include "vector.h"
+#if defined __unix__ || defined __APPLE__
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	define KEYVECTOR_HAS_SHM
+#endif
+
+
+//============================================================
+//	shared memory Vectors for multi process zero copy readers
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 20:30
+//
+//	\brief	a Segment is a shm_open (named) or memfd (anonymous, Linux) mapping
+//				that starts with a header; the rest is a bump arena
+//			the writer builds a Vector<T, shm::Allocator<T>> inside the segment
+//				(allocator calls go to the ScopedSegment of the calling thread)
+//				and publishes it; the header records it as an offset from the
+//				segment start, so any process can map the segment - read only
+//				and at a different address - and see the elements in place
+//			republishing (or mutating the published elements through
+//				Segment::write) is guarded by a seqlock: readers retry a read
+//				that overlapped a write
+//			one writer per segment; elements have to be trivially copyable
+//			the arena only reclaims the most recent allocation, so a Vector that
+//				grows by doubling leaves its older buffers behind - reserve up front
+//=============================================================
+namespace shm
+{
+
+//============================================================
+//	\class	OffsetPtr<T>
+//	\brief	self relative fancy pointer: stores the distance from itself to the pointee
+//				so it stays valid wherever the memory holding it is mapped
+//			copying recomputes the distance for the new location
+//=============================================================
+template<typename T>
+class OffsetPtr
+{
+	static constexpr std::ptrdiff_t nullOffset = 1;	// never a valid distance to an aligned object
+
+	std::ptrdiff_t m_offset;
+
+	std::ptrdiff_t offsetTo( const volatile void* p ) const noexcept
+	{
+		return p ?
+			reinterpret_cast<const volatile char*>( p ) - reinterpret_cast<const volatile char*>( this ) :
+			nullOffset;
+	}
+public:
+	using element_type = T;
+	using value_type = std::remove_cv_t<T>;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T*;
+	using reference = std::add_lvalue_reference_t<T>;
+	using iterator_category = std::random_access_iterator_tag;
+
+	OffsetPtr() noexcept
+		:
+		m_offset{nullOffset}
+	{
+
+	}
+	OffsetPtr( std::nullptr_t ) noexcept
+		:
+		m_offset{nullOffset}
+	{
+
+	}
+	OffsetPtr( T* p ) noexcept
+		:
+		m_offset{offsetTo( p )}
+	{
+
+	}
+	OffsetPtr( const OffsetPtr& rhs ) noexcept
+		:
+		m_offset{offsetTo( rhs.get() )}
+	{
+
+	}
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+	OffsetPtr( const OffsetPtr<U>& rhs ) noexcept
+		:
+		m_offset{offsetTo( static_cast<T*>( rhs.get() ) )}
+	{
+
+	}
+	OffsetPtr& operator=( const OffsetPtr& rhs ) noexcept
+	{
+		m_offset = offsetTo( rhs.get() );
+		return *this;
+	}
+	OffsetPtr& operator=( T* p ) noexcept
+	{
+		m_offset = offsetTo( p );
+		return *this;
+	}
+
+	T* get() const noexcept
+	{
+		return m_offset == nullOffset ?
+			nullptr :
+			reinterpret_cast<T*>( const_cast<char*>( reinterpret_cast<const volatile char*>( this ) ) + m_offset );
+	}
+
+	// std::pointer_traits hook (allocator_traits converts references back to pointers with it)
+	template<typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+	static OffsetPtr pointer_to( U& r ) noexcept
+	{
+		return OffsetPtr{std::addressof( r )};
+	}
+
+	template<typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+	U& operator*() const noexcept
+	{
+		return *get();
+	}
+	T* operator->() const noexcept
+	{
+		return get();
+	}
+	template<typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+	U& operator[]( std::ptrdiff_t i ) const noexcept
+	{
+		return get()[i];
+	}
+	explicit operator bool() const noexcept
+	{
+		return m_offset != nullOffset;
+	}
+
+	OffsetPtr& operator+=( std::ptrdiff_t n ) noexcept
+	{
+		m_offset += n * static_cast<std::ptrdiff_t>( sizeof( T ) );
+		return *this;
+	}
+	OffsetPtr& operator-=( std::ptrdiff_t n ) noexcept
+	{
+		m_offset -= n * static_cast<std::ptrdiff_t>( sizeof( T ) );
+		return *this;
+	}
+	OffsetPtr& operator++() noexcept
+	{
+		return *this += 1;
+	}
+	OffsetPtr& operator--() noexcept
+	{
+		return *this -= 1;
+	}
+	OffsetPtr operator++( int ) noexcept
+	{
+		OffsetPtr old{*this};
+		++*this;
+		return old;
+	}
+	OffsetPtr operator--( int ) noexcept
+	{
+		OffsetPtr old{*this};
+		--*this;
+		return old;
+	}
+	friend OffsetPtr operator+( const OffsetPtr& p,
+		std::ptrdiff_t n ) noexcept
+	{
+		return OffsetPtr{p.get() + n};
+	}
+	friend OffsetPtr operator-( const OffsetPtr& p,
+		std::ptrdiff_t n ) noexcept
+	{
+		return OffsetPtr{p.get() - n};
+	}
+	friend std::ptrdiff_t operator-( const OffsetPtr& lhs,
+		const OffsetPtr& rhs ) noexcept
+	{
+		return lhs.get() - rhs.get();
+	}
+	friend bool operator==( const OffsetPtr& lhs,
+		const OffsetPtr& rhs ) noexcept
+	{
+		return lhs.get() == rhs.get();
+	}
+	friend auto operator<=>( const OffsetPtr& lhs,
+		const OffsetPtr& rhs ) noexcept
+	{
+		return std::compare_three_way{}( lhs.get(), rhs.get() );
+	}
+};
+
+
+enum class Access
+{
+	ReadOnly,
+	ReadWrite
+};
+
+// lives at offset 0 of every segment
+struct alignas( 64 ) SegmentHeader
+{
+	static constexpr std::uint64_t magicValue = 0x314d48535643454bull;	// "KECVSHM1"
+
+	std::uint64_t magic;
+	std::uint64_t bytes;						// size of the whole mapping
+	std::atomic<std::uint64_t> allocCursor;		// arena bump offset (writer only)
+	alignas( 64 ) std::atomic<std::uint64_t> sequence;	// seqlock, odd while a write is in progress
+	std::atomic<std::uint64_t> elementSize;		// published Vector: sizeof( T ), 0 = nothing published
+	std::atomic<std::uint64_t> dataOffset;		//	first element, from the segment start
+	std::atomic<std::uint64_t> size;			//	element count
+};
+
+//============================================================
+//	\class	Segment
+//	\brief	move only owner of one mapping (and its file descriptor)
+//			named segments persist until unlink(); anonymous (memfd) segments are
+//				shared by handing getFd() to the other process (fork, SCM_RIGHTS, /proc/<pid>/fd)
+//			failures to create/map/validate a segment go through throwException
+//=============================================================
+class Segment final
+{
+	void* m_base;
+	std::size_t m_bytes;
+	int m_fd;
+	Access m_access;
+	std::string m_name;
+
+	static inline thread_local Segment* t_current = nullptr;
+	friend class ScopedSegment;
+
+	Segment( void* base,
+		std::size_t bytes,
+		int fd,
+		Access access,
+		std::string name ) noexcept
+		:
+		m_base{base},
+		m_bytes{bytes},
+		m_fd{fd},
+		m_access{access},
+		m_name{std::move( name )}
+	{
+
+	}
+
+	static constexpr std::size_t arenaStart() noexcept
+	{
+		return ( sizeof( SegmentHeader ) + 63 ) & ~std::size_t{63};
+	}
+
+#ifdef KEYVECTOR_HAS_SHM
+	static Segment map( int fd,
+		std::size_t bytes,
+		Access access,
+		std::string name )
+	{
+		const int prot = access == Access::ReadWrite ?
+			PROT_READ | PROT_WRITE :
+			PROT_READ;
+		void* base = ::mmap( nullptr, bytes, prot, MAP_SHARED, fd, 0 );
+		if ( base == MAP_FAILED )
+		{
+			::close( fd );
+			throwException( "Shared memory segment mmap failed." );
+		}
+		return Segment{base, bytes, fd, access, std::move( name )};
+	}
+
+	// sizes a fresh (zero filled) file & writes the header
+	static Segment initialize( int fd,
+		std::size_t bytes,
+		std::string name )
+	{
+		if ( bytes < arenaStart() || ::ftruncate( fd, static_cast<off_t>( bytes ) ) != 0 )
+		{
+			::close( fd );
+			throwException( "Shared memory segment could not be sized." );
+		}
+		Segment segment = map( fd, bytes, Access::ReadWrite, std::move( name ) );
+		SegmentHeader* h = ::new ( segment.m_base ) SegmentHeader{};
+		h->bytes = bytes;
+		h->allocCursor.store( arenaStart(), std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_release );
+		h->magic = SegmentHeader::magicValue;
+		return segment;
+	}
+
+	static Segment attach( int fd,
+		Access access,
+		std::string name )
+	{
+		struct stat st;
+		if ( ::fstat( fd, &st ) != 0 || static_cast<std::size_t>( st.st_size ) < arenaStart() )
+		{
+			::close( fd );
+			throwException( "Not a KeyVector shared memory segment." );
+		}
+		Segment segment = map( fd, static_cast<std::size_t>( st.st_size ), access, std::move( name ) );
+		if ( segment.header().magic != SegmentHeader::magicValue )
+		{
+			throwException( "Not a KeyVector shared memory segment." );
+		}
+		return segment;
+	}
+#endif
+public:
+	// named POSIX segment ("/name"), fails if it already exists
+	static Segment create( const std::string& name,
+		std::size_t bytes )
+	{
+#ifdef KEYVECTOR_HAS_SHM
+		const int fd = ::shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+		if ( fd < 0 )
+		{
+			throwException( "shm_open failed." );
+		}
+		return initialize( fd, bytes, name );
+#else
+		throwException( "Shared memory segments need POSIX shm." );
+#endif
+	}
+
+	// unnamed segment, memfd on Linux (shm_open + immediate unlink elsewhere)
+	static Segment createAnonymous( std::size_t bytes,
+		const char* debugName = "keyvector" )
+	{
+#if defined __linux__
+		const int fd = ::memfd_create( debugName, MFD_CLOEXEC );
+		if ( fd < 0 )
+		{
+			throwException( "memfd_create failed." );
+		}
+		return initialize( fd, bytes, {} );
+#elif defined KEYVECTOR_HAS_SHM
+		const std::string name = std::string{"/"} + debugName + "." + std::to_string( ::getpid() );
+		Segment segment = create( name, bytes );
+		segment.unlink();
+		return segment;
+#else
+		( void )bytes;
+		( void )debugName;
+		throwException( "Shared memory segments need POSIX shm." );
+#endif
+	}
+
+	static Segment open( const std::string& name,
+		Access access = Access::ReadOnly )
+	{
+#ifdef KEYVECTOR_HAS_SHM
+		const int fd = ::shm_open( name.c_str(), access == Access::ReadWrite ? O_RDWR : O_RDONLY, 0 );
+		if ( fd < 0 )
+		{
+			throwException( "shm_open failed." );
+		}
+		return attach( fd, access, name );
+#else
+		( void )access;
+		throwException( "Shared memory segments need POSIX shm." );
+#endif
+	}
+
+	// maps the segment behind a descriptor received from another process; fd itself is not taken over
+	static Segment fromFd( int fd,
+		Access access = Access::ReadOnly )
+	{
+#ifdef KEYVECTOR_HAS_SHM
+		const int own = ::fcntl( fd, F_DUPFD_CLOEXEC, 0 );
+		if ( own < 0 )
+		{
+			throwException( "Shared memory descriptor dup failed." );
+		}
+		return attach( own, access, {} );
+#else
+		( void )fd;
+		( void )access;
+		throwException( "Shared memory segments need POSIX shm." );
+#endif
+	}
+
+	Segment( const Segment& rhs ) = delete;
+	Segment& operator=( const Segment& rhs ) = delete;
+	Segment( Segment&& rhs ) noexcept
+		:
+		m_base{std::exchange( rhs.m_base, nullptr )},
+		m_bytes{std::exchange( rhs.m_bytes, 0 )},
+		m_fd{std::exchange( rhs.m_fd, -1 )},
+		m_access{rhs.m_access},
+		m_name{std::move( rhs.m_name )}
+	{
+
+	}
+	Segment& operator=( Segment&& rhs ) noexcept
+	{
+		Segment temp{std::move( rhs )};
+		std::swap( m_base, temp.m_base );
+		std::swap( m_bytes, temp.m_bytes );
+		std::swap( m_fd, temp.m_fd );
+		std::swap( m_access, temp.m_access );
+		std::swap( m_name, temp.m_name );
+		return *this;
+	}
+
+	~Segment() noexcept
+	{
+#ifdef KEYVECTOR_HAS_SHM
+		if ( m_base )
+		{
+			::munmap( m_base, m_bytes );
+		}
+		if ( m_fd >= 0 )
+		{
+			::close( m_fd );
+		}
+#endif
+	}
+
+	// removes the name; existing mappings stay valid
+	void unlink() noexcept
+	{
+#ifdef KEYVECTOR_HAS_SHM
+		if ( !m_name.empty() )
+		{
+			::shm_unlink( m_name.c_str() );
+			m_name.clear();
+		}
+#endif
+	}
+
+	const SegmentHeader& header() const noexcept
+	{
+		return *static_cast<const SegmentHeader*>( m_base );
+	}
+	SegmentHeader& header() noexcept
+	{
+		return *static_cast<SegmentHeader*>( m_base );
+	}
+	const std::byte* base() const noexcept
+	{
+		return static_cast<const std::byte*>( m_base );
+	}
+	std::size_t getSize() const noexcept
+	{
+		return m_bytes;
+	}
+	int getFd() const noexcept
+	{
+		return m_fd;
+	}
+	bool isWritable() const noexcept
+	{
+		return m_access == Access::ReadWrite;
+	}
+	bool contains( const void* p,
+		std::size_t bytes = 0 ) const noexcept
+	{
+		const std::byte* b = static_cast<const std::byte*>( p );
+		return b >= base() && bytes <= m_bytes && b - base() <= static_cast<std::ptrdiff_t>( m_bytes - bytes );
+	}
+
+	// arena allocation, nullptr when the segment is full
+	void* allocate( std::size_t bytes,
+		std::size_t alignment ) noexcept
+	{
+		std::atomic<std::uint64_t>& cursor = header().allocCursor;
+		std::uint64_t at = cursor.load( std::memory_order_relaxed );
+		std::uint64_t begin;
+		do
+		{
+			begin = ( at + alignment - 1 ) & ~std::uint64_t( alignment - 1 );
+			if ( begin > m_bytes || bytes > m_bytes - begin )
+			{
+				return nullptr;
+			}
+		} while ( !cursor.compare_exchange_weak( at, begin + bytes, std::memory_order_relaxed ) );
+		return static_cast<std::byte*>( m_base ) + begin;
+	}
+
+	// only the most recent allocation is given back to the arena
+	void deallocate( void* p,
+		std::size_t bytes ) noexcept
+	{
+		if ( !contains( p, bytes ) )
+		{
+			return;
+		}
+		const std::uint64_t begin = static_cast<std::uint64_t>( static_cast<std::byte*>( p ) - static_cast<std::byte*>( m_base ) );
+		std::uint64_t end = begin + bytes;
+		header().allocCursor.compare_exchange_strong( end, begin, std::memory_order_relaxed );
+	}
+
+	std::size_t getBytesUsed() const noexcept
+	{
+		return header().allocCursor.load( std::memory_order_relaxed );
+	}
+
+	// writer side of the seqlock: everything fn changes in the segment is seen by readers
+	//	either completely or not at all (their read is retried)
+	template<typename F>
+	void write( F&& fn )
+	{
+		assert( isWritable() );
+		std::atomic<std::uint64_t>& seq = header().sequence;
+		seq.store( seq.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_release );
+		std::forward<F>( fn )();
+		seq.store( seq.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+	}
+
+	// reader side: version to validate the read against, never odd
+	std::uint64_t beginRead() const noexcept
+	{
+		const std::atomic<std::uint64_t>& seq = header().sequence;
+		std::uint64_t v = seq.load( std::memory_order_acquire );
+		while ( v & 1 )
+		{
+			v = seq.load( std::memory_order_acquire );
+		}
+		return v;
+	}
+	// true if no write overlapped the read that started at beginRead() == version
+	bool validateRead( std::uint64_t version ) const noexcept
+	{
+		std::atomic_thread_fence( std::memory_order_acquire );
+		return header().sequence.load( std::memory_order_relaxed ) == version;
+	}
+
+	// calling thread's allocation target (see ScopedSegment)
+	static Segment* current() noexcept
+	{
+		return t_current;
+	}
+};
+
+// routes the calling thread's shm::Allocator calls to `segment` for its lifetime
+class ScopedSegment final
+{
+	Segment* m_previous;
+public:
+	explicit ScopedSegment( Segment& segment ) noexcept
+		:
+		m_previous{Segment::t_current}
+	{
+		Segment::t_current = &segment;
+	}
+	~ScopedSegment() noexcept
+	{
+		Segment::t_current = m_previous;
+	}
+	ScopedSegment( const ScopedSegment& rhs ) = delete;
+	ScopedSegment& operator=( const ScopedSegment& rhs ) = delete;
+};
+
+
+//============================================================
+//	\class	Allocator<T>
+//	\brief	stateless allocator over the current ScopedSegment's arena
+//			pointer is OffsetPtr<T>, so allocator aware structures living
+//				inside the segment stay position independent
+//			usage: shm::SharedVector<int> (= Vector<int, shm::Allocator<int>>)
+//=============================================================
+template<typename T>
+class Allocator
+{
+	static_assert( std::is_trivially_copyable_v<T>, "Shared memory elements have to be trivially copyable." );
+public:
+	using value_type = T;
+	using pointer = OffsetPtr<T>;
+	using const_pointer = OffsetPtr<const T>;
+
+	Allocator() noexcept = default;
+	template<typename U>
+	Allocator( const Allocator<U>& ) noexcept
+	{
+
+	}
+
+	pointer allocate( std::size_t n )
+	{
+		Segment* segment = Segment::current();
+		void* p = segment ?
+			segment->allocate( n * sizeof( T ), alignof( T ) ) :
+			nullptr;
+#ifdef KEYVECTOR_EXCEPTIONS
+		if ( !p )
+		{
+			throw std::bad_alloc{};
+		}
+#endif
+		return pointer{static_cast<T*>( p )};
+	}
+
+	void deallocate( pointer p,
+		std::size_t n ) noexcept
+	{
+		if ( Segment* segment = Segment::current() )
+		{
+			segment->deallocate( p.get(), n * sizeof( T ) );
+		}
+	}
+
+	template<typename U>
+	bool operator==( const Allocator<U>& ) const noexcept
+	{
+		return true;
+	}
+};
+
+template<typename T, class ErrorPolicy = DefaultErrorPolicy>
+using SharedVector = Vector<T, Allocator<T>, ErrorPolicy>;
+
+// makes v the segment's published Vector (v's buffer has to be inside the segment)
+//	later in place changes to v's elements should go through segment.write()
+template<typename T, class ErrorPolicy>
+void publish( Segment& segment,
+	const SharedVector<T, ErrorPolicy>& v ) noexcept
+{
+	assert( segment.contains( v.data(), v.getSize() * sizeof( T ) ) );
+	SegmentHeader& h = segment.header();
+	segment.write( [&]()
+		{
+			h.elementSize.store( sizeof( T ), std::memory_order_relaxed );
+			h.dataOffset.store( static_cast<std::uint64_t>( reinterpret_cast<const std::byte*>( v.data() ) - segment.base() ), std::memory_order_relaxed );
+			h.size.store( v.getSize(), std::memory_order_relaxed );
+		}
+	);
+}
+
+
+//============================================================
+//	\class	SharedVectorReader<T>
+//	\brief	read side of a published Vector, typically over a read only mapping
+//			read( fn ) hands fn the elements in place and retries it if a writer
+//				republished meanwhile - fn may see torn data and must only read
+//			snapshot() copies a consistent version into a private Vector
+//=============================================================
+template<typename T>
+class SharedVectorReader
+{
+	static_assert( std::is_trivially_copyable_v<T>, "Shared memory elements have to be trivially copyable." );
+
+	Segment m_segment;
+
+	// bounds checked, a torn header can't point outside the mapping
+	std::span<const T> currentSpan() const noexcept
+	{
+		const SegmentHeader& h = m_segment.header();
+		const std::uint64_t offset = h.dataOffset.load( std::memory_order_relaxed );
+		const std::uint64_t size = h.size.load( std::memory_order_relaxed );
+		if ( h.elementSize.load( std::memory_order_relaxed ) != sizeof( T )
+			|| offset % alignof( T ) != 0
+			|| size > m_segment.getSize() / sizeof( T )
+			|| !m_segment.contains( m_segment.base() + offset, size * sizeof( T ) ) )
+		{
+			return {};
+		}
+		return std::span<const T>{reinterpret_cast<const T*>( m_segment.base() + offset ), static_cast<std::size_t>( size )};
+	}
+public:
+	explicit SharedVectorReader( Segment&& segment ) noexcept
+		:
+		m_segment{std::move( segment )}
+	{
+
+	}
+
+	template<typename F>
+	auto read( F&& fn ) const
+	{
+		while ( true )
+		{
+			const std::uint64_t version = m_segment.beginRead();
+			if constexpr ( std::is_void_v<std::invoke_result_t<F&, std::span<const T>>> )
+			{
+				fn( currentSpan() );
+				if ( m_segment.validateRead( version ) )
+				{
+					return;
+				}
+			}
+			else
+			{
+				auto result = fn( currentSpan() );
+				if ( m_segment.validateRead( version ) )
+				{
+					return result;
+				}
+			}
+		}
+	}
+
+	Vector<T> snapshot() const
+	{
+		return read( []( std::span<const T> elements )
+			{
+				Vector<T> out{std::max<std::size_t>( elements.size(), 1 )};
+				out.append( elements.data(), elements.data() + elements.size() );
+				return out;
+			}
+		);
+	}
+
+	// unchecked view of the current version, pair with getVersion()/isCurrent()
+	std::span<const T> view() const noexcept
+	{
+		return currentSpan();
+	}
+	std::uint64_t getVersion() const noexcept
+	{
+		return m_segment.beginRead();
+	}
+	bool isCurrent( std::uint64_t version ) const noexcept
+	{
+		return m_segment.validateRead( version );
+	}
+	const Segment& getSegment() const noexcept
+	{
+		return m_segment;
+	}
+};
+
+}//shm
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <span>
+#include <type_traits>
+#include "vector.h"
+
+
+// stable reference to a SlotMap element; stays valid (and detectably stale after erase)
+//	while other elements come and go
+struct SlotHandle
+{
+	static constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+	std::uint32_t index = invalidIndex;	// slot
+	std::uint32_t generation = 0;		// odd while the slot is occupied
+
+	friend bool operator==( const SlotHandle& lhs,
+		const SlotHandle& rhs ) noexcept = default;
+};
+
+//============================================================
+//	\class	SlotMap<T, Alloc>
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 21:15
+//
+//	\brief	values live densely packed in a Vector (iteration is a plain array walk)
+//			handles index a sparse slot array which maps to the dense position;
+//				each slot carries a generation counter, bumped on insert & erase,
+//				so a handle to an erased (or erased and reused) slot is rejected
+//			insert/erase/lookup are O(1): erase moves the last value into the hole
+//				(swap and pop) and patches that value's slot
+//			free slots form an intrusive list threaded through the slot array
+//			dense order is not insertion order, and erase invalidates pointers
+//				(not handles) to the moved value
+//=============================================================
+template<class T, class Alloc = std::allocator<T>>
+class SlotMap
+{
+	struct Slot
+	{
+		std::uint32_t index;		// dense position while occupied, next free slot otherwise
+		std::uint32_t generation;
+	};
+	template<typename U>
+	using Rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+	Vector<T, Alloc> m_values;
+	Vector<std::uint32_t, Rebind<std::uint32_t>> m_denseToSlot;
+	Vector<Slot, Rebind<Slot>> m_slots;
+	std::uint32_t m_freeHead;
+
+	const Slot* liveSlot( SlotHandle h ) const noexcept
+	{
+		if ( h.index < m_slots.getSize() && m_slots[h.index].generation == h.generation && ( h.generation & 1 ) )
+		{
+			return &m_slots[h.index];
+		}
+		return nullptr;
+	}
+public:
+	using value_type = T;
+	using iterator = typename Vector<T, Alloc>::iterator;
+	using const_iterator = typename Vector<T, Alloc>::const_iterator;
+
+	SlotMap()
+		:
+		m_values{},
+		m_denseToSlot{},
+		m_slots{},
+		m_freeHead{SlotHandle::invalidIndex}
+	{
+
+	}
+	explicit SlotMap( std::size_t capacity )
+		:
+		m_values{capacity},
+		m_denseToSlot{capacity},
+		m_slots{capacity},
+		m_freeHead{SlotHandle::invalidIndex}
+	{
+
+	}
+
+	template<typename... TArgs>
+	SlotHandle emplace( TArgs&&... args )
+	{
+		if ( m_freeHead == SlotHandle::invalidIndex )
+		{
+			assert( m_slots.getSize() < SlotHandle::invalidIndex );
+			m_slots.pushBack( Slot{SlotHandle::invalidIndex, 0} );
+			m_freeHead = static_cast<std::uint32_t>( m_slots.getSize() - 1 );
+		}
+		const std::uint32_t slotIndex = m_freeHead;
+		m_denseToSlot.pushBack( slotIndex );
+#ifdef KEYVECTOR_EXCEPTIONS
+		try
+		{
+			m_values.emplaceBack( std::forward<TArgs>( args )... );
+		}
+		catch ( ... )
+		{
+			m_denseToSlot.popBack();
+			throw;
+		}
+#else
+		m_values.emplaceBack( std::forward<TArgs>( args )... );
+#endif
+		Slot& slot = m_slots[slotIndex];
+		m_freeHead = slot.index;
+		slot.index = static_cast<std::uint32_t>( m_values.getSize() - 1 );
+		++slot.generation;
+		return SlotHandle{slotIndex, slot.generation};
+	}
+	SlotHandle insert( const T& val )
+	{
+		return emplace( val );
+	}
+	SlotHandle insert( T&& val )
+	{
+		return emplace( std::move( val ) );
+	}
+
+	// false for a stale handle
+	bool erase( SlotHandle h ) noexcept( std::is_nothrow_move_assignable_v<T> )
+	{
+		if ( !liveSlot( h ) )
+		{
+			return false;
+		}
+		Slot& slot = m_slots[h.index];
+		const std::uint32_t dense = slot.index;
+		const std::uint32_t last = static_cast<std::uint32_t>( m_values.getSize() - 1 );
+		if ( dense != last )
+		{
+			m_values[dense] = std::move( m_values[last] );
+			m_denseToSlot[dense] = m_denseToSlot[last];
+			m_slots[m_denseToSlot[dense]].index = dense;
+		}
+		m_values.popBack();
+		m_denseToSlot.popBack();
+		++slot.generation;
+		slot.index = m_freeHead;
+		m_freeHead = h.index;
+		return true;
+	}
+
+	// every outstanding handle becomes stale
+	void clear() noexcept
+	{
+		for ( std::size_t i = m_values.getSize(); i > 0; --i )
+		{
+			const std::uint32_t slotIndex = m_denseToSlot[i - 1];
+			Slot& slot = m_slots[slotIndex];
+			++slot.generation;
+			slot.index = m_freeHead;
+			m_freeHead = slotIndex;
+			m_values.popBack();
+			m_denseToSlot.popBack();
+		}
+	}
+
+	void reserve( std::size_t capacity )
+	{
+		if ( capacity > m_values.getCapacity() )
+		{
+			m_values.reserve( capacity );
+			m_denseToSlot.reserve( capacity );
+		}
+		if ( capacity > m_slots.getCapacity() )
+		{
+			m_slots.reserve( capacity );
+		}
+	}
+
+	bool contains( SlotHandle h ) const noexcept
+	{
+		return liveSlot( h ) != nullptr;
+	}
+	// nullptr for a stale handle
+	T* find( SlotHandle h ) noexcept
+	{
+		const Slot* slot = liveSlot( h );
+		return slot ?
+			&m_values[slot->index] :
+			nullptr;
+	}
+	const T* find( SlotHandle h ) const noexcept
+	{
+		const Slot* slot = liveSlot( h );
+		return slot ?
+			&m_values[slot->index] :
+			nullptr;
+	}
+	// unchecked
+	T& operator[]( SlotHandle h ) noexcept
+	{
+		assert( contains( h ) );
+		return m_values[m_slots[h.index].index];
+	}
+	const T& operator[]( SlotHandle h ) const noexcept
+	{
+		assert( contains( h ) );
+		return m_values[m_slots[h.index].index];
+	}
+	T& at( SlotHandle h )
+	{
+		if ( T* p = find( h ) )
+		{
+			return *p;
+		}
+		throwException( "SlotMap handle is stale." );
+	}
+
+	// handle of the value at dense position i (0 <= i < getSize())
+	SlotHandle handleAt( std::size_t i ) const noexcept
+	{
+		const std::uint32_t slotIndex = m_denseToSlot[i];
+		return SlotHandle{slotIndex, m_slots[slotIndex].generation};
+	}
+
+	// dense iteration
+	iterator begin() noexcept
+	{
+		return m_values.begin();
+	}
+	iterator end() noexcept
+	{
+		return m_values.end();
+	}
+	const_iterator begin() const noexcept
+	{
+		return m_values.cbegin();
+	}
+	const_iterator end() const noexcept
+	{
+		return m_values.cend();
+	}
+	std::span<T> values() noexcept
+	{
+		return m_values.asSpan();
+	}
+	std::span<const T> values() const noexcept
+	{
+		return m_values.asSpan();
+	}
+
+	bool isEmpty() const noexcept
+	{
+		return m_values.getSize() == 0;
+	}
+	std::size_t getSize() const noexcept
+	{
+		return m_values.getSize();
+	}
+	std::size_t getSlotCount() const noexcept
+	{
+		return m_slots.getSize();
+	}
+};
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <limits>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include "vector.h"
+#if defined __AVX2__
+#	include <immintrin.h>
+#endif
+
+
+//============================================================
+//	sorted index intersection kernels behind SparseVector
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 04:00
+//
+//	\brief	intersect( a, b, fn ) calls fn( i, j ) for every a[i] == b[j] of two strictly
+//				ascending index arrays, in order
+//			32 bit indices on AVX2 compare a block of 8 of `a` against all 8 rotations of
+//				a block of `b` at once and advance the block(s) with the smaller last
+//				index, like a merge; only the (rare) matching lanes are resolved one by one
+//			everything else (and the tails) is a scalar merge
+//=============================================================
+namespace sparse
+{
+
+template<typename Index, typename F>
+void intersectScalar( const Index* a,
+	std::size_t na,
+	const Index* b,
+	std::size_t nb,
+	F&& fn,
+	std::size_t i = 0,
+	std::size_t j = 0 )
+{
+	while ( i < na && j < nb )
+	{
+		if ( a[i] < b[j] )
+		{
+			++i;
+		}
+		else if ( b[j] < a[i] )
+		{
+			++j;
+		}
+		else
+		{
+			fn( i++, j++ );
+		}
+	}
+}
+
+template<typename Index, typename F>
+void intersect( const Index* a,
+	std::size_t na,
+	const Index* b,
+	std::size_t nb,
+	F&& fn )
+{
+	std::size_t i = 0;
+	std::size_t j = 0;
+#if defined __AVX2__
+	if constexpr ( sizeof( Index ) == 4 && std::is_integral_v<Index> )
+	{
+		const __m256i rotate = _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 0 );
+		while ( i + 8 <= na && j + 8 <= nb )
+		{
+			const __m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) );
+			const __m256i vb = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + j ) );
+			__m256i rotated = vb;
+			__m256i eq = _mm256_cmpeq_epi32( va, rotated );
+			for ( int r = 1; r < 8; ++r )
+			{
+				rotated = _mm256_permutevar8x32_epi32( rotated, rotate );
+				eq = _mm256_or_si256( eq, _mm256_cmpeq_epi32( va, rotated ) );
+			}
+			for ( unsigned mask = static_cast<unsigned>( _mm256_movemask_ps( _mm256_castsi256_ps( eq ) ) ); mask != 0; mask &= mask - 1 )
+			{
+				const unsigned lane = static_cast<unsigned>( std::countr_zero( mask ) );
+				const __m256i hit = _mm256_cmpeq_epi32( _mm256_set1_epi32( static_cast<int>( a[i + lane] ) ), vb );
+				fn( i + lane, j + static_cast<std::size_t>( std::countr_zero( static_cast<unsigned>( _mm256_movemask_ps( _mm256_castsi256_ps( hit ) ) ) ) ) );
+			}
+			const Index aLast = a[i + 7];
+			const Index bLast = b[j + 7];
+			i += aLast <= bLast ? 8 : 0;
+			j += bLast <= aLast ? 8 : 0;
+		}
+	}
+#endif
+	intersectScalar( a, na, b, nb, fn, i, j );
+}
+
+}//sparse
+
+
+//============================================================
+//	\class	SparseVector<T, Index>
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 04:00
+//
+//	\brief	a vector of getSize() elements that are T{} except at the stored positions
+//			kept as two parallel Vectors - strictly ascending indices & their values -
+//				so memory, iteration and the kernels are all O(nnz)
+//			fromDense() skips all zero blocks of 16 with one vectorizable test
+//			the sparse-sparse operations merge (add) or intersect (multiply, dot) the
+//				index arrays, see sparse::intersect
+//			Index bounds the length; 32 bit indices take the SIMD intersection
+//=============================================================
+template<typename T, typename Index = std::uint32_t>
+class SparseVector
+{
+	static_assert( std::is_unsigned_v<Index>, "Index has to be an unsigned integer type." );
+
+	Vector<Index> m_indices;
+	Vector<T> m_values;
+	std::size_t m_length;
+
+	static bool isZero( const T& x ) noexcept
+	{
+		return x == T{};
+	}
+public:
+	explicit SparseVector( std::size_t length = 0,
+		std::size_t nnzCapacity = 64 )
+		:
+		m_indices{nnzCapacity},
+		m_values{nnzCapacity},
+		m_length{length}
+	{
+		assert( length == 0 || length - 1 <= std::numeric_limits<Index>::max() );
+	}
+
+	static SparseVector fromDense( std::span<const T> dense )
+	{
+		constexpr std::size_t block = 16;
+		SparseVector s{dense.size()};
+		const T* p = dense.data();
+		std::size_t i = 0;
+		for ( ; i + block <= dense.size(); i += block )
+		{
+			unsigned any = 0;
+			for ( std::size_t k = 0; k < block; ++k )
+			{
+				any |= static_cast<unsigned>( !isZero( p[i + k] ) );
+			}
+			if ( any )
+			{
+				for ( std::size_t k = i; k < i + block; ++k )
+				{
+					if ( !isZero( p[k] ) )
+					{
+						s.pushBack( k, p[k] );
+					}
+				}
+			}
+		}
+		for ( ; i < dense.size(); ++i )
+		{
+			if ( !isZero( p[i] ) )
+			{
+				s.pushBack( i, p[i] );
+			}
+		}
+		return s;
+	}
+	static SparseVector fromDense( const Vector<T>& dense )
+	{
+		return fromDense( dense.asSpan() );
+	}
+
+	Vector<T> toDense() const
+	{
+		Vector<T> dense{m_length, T{}};
+		for ( std::size_t k = 0; k < m_indices.getSize(); ++k )
+		{
+			dense[m_indices[k]] = m_values[k];
+		}
+		return dense;
+	}
+
+	// appends a non default element past every stored one
+	void pushBack( std::size_t index,
+		const T& value )
+	{
+		assert( index < m_length && ( m_indices.isEmpty() || m_indices.back() < index ) );
+		m_indices.pushBack( static_cast<Index>( index ) );
+		m_values.pushBack( value );
+	}
+
+	// O(log nnz) lookup, O(nnz) insertion unless it lands at the end; storing T{} erases
+	void set( std::size_t index,
+		const T& value )
+	{
+		assert( index < m_length );
+		const Index* pos = std::lower_bound( m_indices.cbegin(), m_indices.cend(), static_cast<Index>( index ) );
+		const std::size_t k = static_cast<std::size_t>( pos - m_indices.cbegin() );
+		if ( k < m_indices.getSize() && m_indices[k] == index )
+		{
+			if ( isZero( value ) )
+			{
+				m_indices.erase( m_indices.cbegin() + k );
+				m_values.erase( m_values.cbegin() + k );
+			}
+			else
+			{
+				m_values[k] = value;
+			}
+			return;
+		}
+		if ( isZero( value ) )
+		{
+			return;
+		}
+		m_indices.pushBack( static_cast<Index>( index ) );
+		m_values.pushBack( value );
+		std::rotate( m_indices.begin() + k, m_indices.end() - 1, m_indices.end() );
+		std::rotate( m_values.begin() + k, m_values.end() - 1, m_values.end() );
+	}
+
+	T get( std::size_t index ) const noexcept
+	{
+		const Index* pos = std::lower_bound( m_indices.cbegin(), m_indices.cend(), static_cast<Index>( index ) );
+		return pos != m_indices.cend() && *pos == index ?
+			m_values[static_cast<std::size_t>( pos - m_indices.cbegin() )] :
+			T{};
+	}
+
+	// fn( index, value ) for every stored element, ascending
+	template<typename F>
+	void forEachNonZero( F&& fn ) const
+	{
+		for ( std::size_t k = 0; k < m_indices.getSize(); ++k )
+		{
+			fn( static_cast<std::size_t>( m_indices[k] ), m_values[k] );
+		}
+	}
+
+	// sparse . dense
+	T dot( std::span<const T> dense ) const noexcept
+	{
+		assert( dense.size() >= m_length );
+		const Index* idx = m_indices.data();
+		const T* val = m_values.data();
+		const std::size_t n = m_indices.getSize();
+		T acc[4]{};
+		std::size_t k = 0;
+		for ( ; k + 4 <= n; k += 4 )
+		{
+			acc[0] += val[k] * dense[idx[k]];
+			acc[1] += val[k + 1] * dense[idx[k + 1]];
+			acc[2] += val[k + 2] * dense[idx[k + 2]];
+			acc[3] += val[k + 3] * dense[idx[k + 3]];
+		}
+		for ( ; k < n; ++k )
+		{
+			acc[0] += val[k] * dense[idx[k]];
+		}
+		return ( acc[0] + acc[1] ) + ( acc[2] + acc[3] );
+	}
+	T dot( const Vector<T>& dense ) const noexcept
+	{
+		return dot( dense.asSpan() );
+	}
+
+	// sparse . sparse, over the common indices
+	T dot( const SparseVector& rhs ) const noexcept
+	{
+		T acc{};
+		sparse::intersect( m_indices.data(), m_indices.getSize(), rhs.m_indices.data(), rhs.m_indices.getSize(),
+			[&]( std::size_t i, std::size_t j )
+			{
+				acc += m_values[i] * rhs.m_values[j];
+			} );
+		return acc;
+	}
+
+	// elementwise sum (union of the index sets); exact zeros that result are dropped
+	static SparseVector add( const SparseVector& a,
+		const SparseVector& b )
+	{
+		assert( a.m_length == b.m_length );
+		SparseVector out{a.m_length, a.getNonZeroCount() + b.getNonZeroCount()};
+		std::size_t i = 0;
+		std::size_t j = 0;
+		const std::size_t na = a.getNonZeroCount();
+		const std::size_t nb = b.getNonZeroCount();
+		while ( i < na || j < nb )
+		{
+			if ( j == nb || ( i < na && a.m_indices[i] < b.m_indices[j] ) )
+			{
+				out.pushBack( a.m_indices[i], a.m_values[i] );
+				++i;
+			}
+			else if ( i == na || b.m_indices[j] < a.m_indices[i] )
+			{
+				out.pushBack( b.m_indices[j], b.m_values[j] );
+				++j;
+			}
+			else
+			{
+				const T sum = a.m_values[i] + b.m_values[j];
+				if ( !isZero( sum ) )
+				{
+					out.pushBack( a.m_indices[i], sum );
+				}
+				++i;
+				++j;
+			}
+		}
+		return out;
+	}
+
+	// elementwise product (intersection of the index sets)
+	static SparseVector multiply( const SparseVector& a,
+		const SparseVector& b )
+	{
+		assert( a.m_length == b.m_length );
+		SparseVector out{a.m_length, std::min( a.getNonZeroCount(), b.getNonZeroCount() ) + 1};
+		sparse::intersect( a.m_indices.data(), a.getNonZeroCount(), b.m_indices.data(), b.getNonZeroCount(),
+			[&]( std::size_t i, std::size_t j )
+			{
+				const T product = a.m_values[i] * b.m_values[j];
+				if ( !isZero( product ) )
+				{
+					out.pushBack( a.m_indices[i], product );
+				}
+			} );
+		return out;
+	}
+
+	std::span<const Index> indices() const noexcept
+	{
+		return m_indices.asSpan();
+	}
+	std::span<const T> values() const noexcept
+	{
+		return m_values.asSpan();
+	}
+	std::span<T> values() noexcept
+	{
+		return m_values.asSpan();
+	}
+
+	void clear() noexcept
+	{
+		m_indices.clear();
+		m_values.clear();
+	}
+
+	// logical length, zeros included
+	std::size_t getSize() const noexcept
+	{
+		return m_length;
+	}
+	std::size_t getNonZeroCount() const noexcept
+	{
+		return m_indices.getSize();
+	}
+	std::size_t getSizeInBytes() const noexcept
+	{
+		return m_indices.getCapacity() * sizeof( Index ) + m_values.getCapacity() * sizeof( T );
+	}
+};
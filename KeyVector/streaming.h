@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+#if defined _M_X64 || defined __x86_64__ || defined __SSE2__
+#	include <immintrin.h>
+#	define KEYVECTOR_HAS_SSE2
+#endif
+
+
+// copies/fills larger than this many bytes bypass the cache hierarchy
+//	default ~ a fair share of a typical L3; override before including vector.h
+#ifndef KEYVECTOR_STREAMING_THRESHOLD
+#	define KEYVECTOR_STREAMING_THRESHOLD ( 8ull << 20 )
+#endif
+
+// how far ahead (in bytes) the copy loops prefetch their source
+#ifndef KEYVECTOR_PREFETCH_DISTANCE
+#	define KEYVECTOR_PREFETCH_DISTANCE 512
+#endif
+
+
+//============================================================
+//	streaming (non-temporal) memory primitives
+//	huge copies & fills are written with _mm_stream_* so that the destination
+//		doesn't evict the rest of the working set; the source is prefetched NTA
+//	below the threshold (or off x86) they degrade to memcpy / std::fill_n
+//=============================================================
+namespace streaming
+{
+
+inline constexpr std::size_t threshold = KEYVECTOR_STREAMING_THRESHOLD;
+inline constexpr std::size_t prefetchDistance = KEYVECTOR_PREFETCH_DISTANCE;
+
+// read hint for the element loops of non trivially copyable types
+inline void prefetch( const void* p ) noexcept
+{
+#ifdef KEYVECTOR_HAS_SSE2
+	_mm_prefetch( static_cast<const char*>( p ), _MM_HINT_T0 );
+#else
+	(void) p;
+#endif
+}
+
+// unconditionally non-temporal copy of `bytes` bytes, regions must not overlap
+inline void copyNonTemporal( void* dst,
+	const void* src,
+	std::size_t bytes ) noexcept
+{
+#ifdef KEYVECTOR_HAS_SSE2
+	auto* d = static_cast<char*>( dst );
+	auto* s = static_cast<const char*>( src );
+
+	// scalar head up to the first 16 byte aligned destination address
+	const std::size_t head = std::min( bytes, ( 16 - ( reinterpret_cast<std::uintptr_t>( d ) & 15 ) ) & 15 );
+	std::memcpy( d, s, head );
+	d += head;
+	s += head;
+	bytes -= head;
+
+	for ( ; bytes >= 64; bytes -= 64, d += 64, s += 64 )
+	{
+		_mm_prefetch( s + prefetchDistance, _MM_HINT_NTA );
+		const __m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s ) );
+		const __m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 16 ) );
+		const __m128i c = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 32 ) );
+		const __m128i e = _mm_loadu_si128( reinterpret_cast<const __m128i*>( s + 48 ) );
+		_mm_stream_si128( reinterpret_cast<__m128i*>( d ), a );
+		_mm_stream_si128( reinterpret_cast<__m128i*>( d + 16 ), b );
+		_mm_stream_si128( reinterpret_cast<__m128i*>( d + 32 ), c );
+		_mm_stream_si128( reinterpret_cast<__m128i*>( d + 48 ), e );
+	}
+	std::memcpy( d, s, bytes );
+	// make the weakly ordered stores visible before anyone else reads the buffer
+	_mm_sfence();
+#else
+	std::memcpy( dst, src, bytes );
+#endif
+}
+
+inline void copy( void* dst,
+	const void* src,
+	std::size_t bytes ) noexcept
+{
+	if ( bytes >= threshold )
+	{
+		copyNonTemporal( dst, src, bytes );
+	}
+	else if ( bytes > 0 )
+	{
+		std::memcpy( dst, src, bytes );
+	}
+}
+
+// fills `count` trivially copyable objects with `value`
+//	the non-temporal path needs a power of 2 element size <= 16 so that a 16 byte pattern tiles
+template<typename T>
+void fill( T* dst,
+	const T& value,
+	std::size_t count ) noexcept
+{
+	static_assert( std::is_trivially_copyable_v<T>,
+		"streaming::fill requires trivially copyable elements." );
+#ifdef KEYVECTOR_HAS_SSE2
+	if constexpr ( sizeof( T ) <= 16 && ( sizeof( T ) & ( sizeof( T ) - 1 ) ) == 0 )
+	{
+		if ( count * sizeof( T ) >= threshold )
+		{
+			std::size_t i = 0;
+			for ( ; i < count && ( reinterpret_cast<std::uintptr_t>( dst + i ) & 15 ) != 0; ++i )
+			{
+				dst[i] = value;
+			}
+			alignas( 16 ) unsigned char pattern[16];
+			for ( std::size_t b = 0; b < 16; b += sizeof( T ) )
+			{
+				std::memcpy( pattern + b, &value, sizeof( T ) );
+			}
+			const __m128i v = _mm_load_si128( reinterpret_cast<const __m128i*>( pattern ) );
+			constexpr std::size_t perStore = 16 / sizeof( T );
+			for ( ; i + perStore <= count; i += perStore )
+			{
+				_mm_stream_si128( reinterpret_cast<__m128i*>( dst + i ), v );
+			}
+			for ( ; i < count; ++i )
+			{
+				dst[i] = value;
+			}
+			_mm_sfence();
+			return;
+		}
+	}
+#endif
+	std::fill_n( dst, count, value );
+}
+
+}//streaming
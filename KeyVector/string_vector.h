@@ -0,0 +1,418 @@
+#pragma once
+
+#include <limits>
+#include <cstdint>
+#include <ranges>
+#include <iterator>
+#include <algorithm>
+#include <string_view>
+#include <functional>
+#include <type_traits>
+#include "vector.h"
+
+
+enum class Interning
+{
+	Off,
+	On		// equal strings share their characters in the arena
+};
+
+//============================================================
+//	\class	BasicStringVector<CharT, Offset>
+//
+//	\author	KeyC0de
+//	\date	20/10/2026 01:10
+//
+//	\brief	a sequence of strings kept as one character arena plus a
+//				{begin, length} entry per string (2 Offsets, 8 bytes by default)
+//			no per string heap object; growth moves two flat buffers
+//			elements are read as basic_string_view, valid until the next growth
+//			with Interning::On an open addressing table (power of 2 slots, linear
+//				probing, <= 50% load) of the distinct {begin, length} runs finds an
+//				existing copy of the characters and the new entry points at it
+//			Offset bounds the arena size (and the string count); exceeding it throws
+//=============================================================
+template<typename CharT, typename Offset = std::uint32_t>
+class BasicStringVector
+{
+	static_assert( std::is_unsigned_v<Offset>, "Offset has to be an unsigned integer type." );
+public:
+	using view_type = std::basic_string_view<CharT>;
+private:
+	struct Entry
+	{
+		Offset begin;
+		Offset length;
+	};
+
+	static constexpr Entry emptySlot{std::numeric_limits<Offset>::max(), 0};	// no run starts there
+
+	Vector<CharT> m_chars;
+	Vector<Entry> m_entries;
+	Vector<Entry> m_table;
+	std::size_t m_unique;
+	Interning m_interning;
+
+	view_type view( const Entry& e ) const noexcept
+	{
+		return view_type{m_chars.data() + e.begin, e.length};
+	}
+
+	static std::size_t hashOf( view_type s ) noexcept
+	{
+		return std::hash<view_type>{}( s );
+	}
+
+	void checkFits( std::size_t chars ) const
+	{
+		if ( m_chars.getSize() + chars >= std::numeric_limits<Offset>::max() )
+		{
+			throwException( "StringVector arena exceeds its offset type." );
+		}
+	}
+
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	// whether s views characters of the arena (one of our own strings)
+	bool isInArena( view_type s ) const noexcept
+	{
+		return !std::less<const CharT*>{}( s.data(), m_chars.data() ) && std::less<const CharT*>{}( s.data(), m_chars.data() + m_chars.getSize() );
+	}
+
+	// grows the arena (geometrically) so that `chars` more characters fit without reallocating
+	void reserveChars( std::size_t chars )
+	{
+		if ( m_chars.getSize() + chars > m_chars.getCapacity() )
+		{
+			m_chars.reserve( std::max( m_chars.getCapacity() << 1ull, m_chars.getSize() + chars ) );
+		}
+	}
+
+	static bool isEmptySlot( const Entry& e ) noexcept
+	{
+		return e.begin == emptySlot.begin;
+	}
+
+	// slot holding a run equal to s, or the empty slot where it would go
+	std::size_t probe( view_type s ) const noexcept
+	{
+		const std::size_t mask = m_table.getSize() - 1;
+		std::size_t slot = hashOf( s ) & mask;
+		while ( !isEmptySlot( m_table[slot] ) && view( m_table[slot] ) != s )
+		{
+			slot = ( slot + 1 ) & mask;
+		}
+		return slot;
+	}
+
+	void rehash( std::size_t slots )
+	{
+		Vector<Entry> table{slots, emptySlot};
+		table.swap( m_table );
+		for ( const Entry& e : table )
+		{
+			if ( !isEmptySlot( e ) )
+			{
+				m_table[probe( view( e ) )] = e;
+			}
+		}
+	}
+
+	Entry store( view_type s )
+	{
+		checkFits( s.size() );
+		const Entry e{static_cast<Offset>( m_chars.getSize() ), static_cast<Offset>( s.size() )};
+		// s may be a view of the arena itself (sv.pushBack( sv[0] )): growing rebases it by its offset
+		const std::size_t at = isInArena( s ) ?
+			static_cast<std::size_t>( s.data() - m_chars.data() ) :
+			npos;
+		reserveChars( s.size() );
+		const CharT* const first = at != npos ?
+			m_chars.data() + at :
+			s.data();
+		m_chars.append( first, first + s.size() );
+		++m_unique;
+		return e;
+	}
+
+	Entry intern( view_type s )
+	{
+		if ( ( m_unique + 1 ) * 2 > m_table.getSize() )
+		{
+			rehash( m_table.getSize() * 2 );
+		}
+		const std::size_t slot = probe( s );
+		if ( isEmptySlot( m_table[slot] ) )
+		{
+			m_table[slot] = store( s );
+		}
+		return m_table[slot];
+	}
+public:
+	class ConstIterator
+	{
+		const BasicStringVector* m_owner;
+		std::size_t m_i;
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = view_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = view_type;
+
+		ConstIterator() noexcept
+			:
+			m_owner{nullptr},
+			m_i{0}
+		{
+
+		}
+		ConstIterator( const BasicStringVector* owner,
+			std::size_t i ) noexcept
+			:
+			m_owner{owner},
+			m_i{i}
+		{
+
+		}
+		view_type operator*() const noexcept
+		{
+			return ( *m_owner )[m_i];
+		}
+		view_type operator[]( difference_type n ) const noexcept
+		{
+			return ( *m_owner )[m_i + n];
+		}
+		ConstIterator& operator++() noexcept
+		{
+			++m_i;
+			return *this;
+		}
+		ConstIterator operator++( int ) noexcept
+		{
+			ConstIterator old{*this};
+			++m_i;
+			return old;
+		}
+		ConstIterator& operator--() noexcept
+		{
+			--m_i;
+			return *this;
+		}
+		ConstIterator operator--( int ) noexcept
+		{
+			ConstIterator old{*this};
+			--m_i;
+			return old;
+		}
+		ConstIterator& operator+=( difference_type n ) noexcept
+		{
+			m_i += n;
+			return *this;
+		}
+		ConstIterator& operator-=( difference_type n ) noexcept
+		{
+			m_i -= n;
+			return *this;
+		}
+		friend ConstIterator operator+( ConstIterator it,
+			difference_type n ) noexcept
+		{
+			return it += n;
+		}
+		friend ConstIterator operator+( difference_type n,
+			ConstIterator it ) noexcept
+		{
+			return it += n;
+		}
+		friend ConstIterator operator-( ConstIterator it,
+			difference_type n ) noexcept
+		{
+			return it -= n;
+		}
+		friend difference_type operator-( const ConstIterator& lhs,
+			const ConstIterator& rhs ) noexcept
+		{
+			return static_cast<difference_type>( lhs.m_i ) - static_cast<difference_type>( rhs.m_i );
+		}
+		friend bool operator==( const ConstIterator& lhs,
+			const ConstIterator& rhs ) noexcept
+		{
+			return lhs.m_i == rhs.m_i;
+		}
+		friend auto operator<=>( const ConstIterator& lhs,
+			const ConstIterator& rhs ) noexcept
+		{
+			return lhs.m_i <=> rhs.m_i;
+		}
+	};
+	using const_iterator = ConstIterator;
+	using iterator = ConstIterator;
+	using value_type = view_type;
+
+	explicit BasicStringVector( Interning interning = Interning::Off,
+		std::size_t capacity = 64,
+		std::size_t charCapacity = 1024 )
+		:
+		m_chars{charCapacity},
+		m_entries{capacity},
+		m_table{interning == Interning::On ? std::size_t{64} : std::size_t{1}, emptySlot},
+		m_unique{0},
+		m_interning{interning}
+	{
+
+	}
+
+	// returns the new string's index
+	std::size_t pushBack( view_type s )
+	{
+		const Entry e = m_interning == Interning::On ?
+			intern( s ) :
+			store( s );
+		m_entries.pushBack( e );
+		return m_entries.getSize() - 1;
+	}
+
+	// any range of things convertible to view_type; sizes the arena once up front
+	template<typename Range>
+	void append( const Range& strings )
+	{
+		if constexpr ( std::ranges::sized_range<const Range> )
+		{
+			std::size_t chars = 0;
+			for ( const auto& s : strings )
+			{
+				chars += view_type{s}.size();
+			}
+			reserve( m_entries.getSize() + std::ranges::size( strings ), m_chars.getSize() + chars );
+		}
+		for ( const auto& s : strings )
+		{
+			pushBack( view_type{s} );
+		}
+	}
+
+	// splits `text` at every delimiter; without interning the characters go in with a single copy
+	void appendSplit( view_type text,
+		CharT delimiter )
+	{
+		if ( m_interning == Interning::On )
+		{
+			for ( std::size_t pos = 0; pos <= text.size(); )
+			{
+				std::size_t end = text.find( delimiter, pos );
+				if ( end == view_type::npos )
+				{
+					end = text.size();
+				}
+				pushBack( text.substr( pos, end - pos ) );
+				pos = end + 1;
+			}
+			return;
+		}
+		checkFits( text.size() );
+		const std::size_t base = m_chars.getSize();
+		const std::size_t at = isInArena( text ) ?
+			static_cast<std::size_t>( text.data() - m_chars.data() ) :
+			npos;
+		reserveChars( text.size() );
+		const CharT* const first = at != npos ?
+			m_chars.data() + at :
+			text.data();
+		m_chars.append( first, first + text.size() );
+		// split the stored copy, text may have pointed into the arena's old buffer
+		text = view_type{m_chars.data() + base, text.size()};
+		for ( std::size_t pos = 0; pos <= text.size(); )
+		{
+			std::size_t end = text.find( delimiter, pos );
+			if ( end == view_type::npos )
+			{
+				end = text.size();
+			}
+			m_entries.pushBack( Entry{static_cast<Offset>( base + pos ), static_cast<Offset>( end - pos )} );
+			++m_unique;
+			pos = end + 1;
+		}
+	}
+
+	// the characters stay in the arena (they may be shared)
+	void popBack() noexcept
+	{
+		m_entries.popBack();
+	}
+
+	void reserve( std::size_t strings,
+		std::size_t chars )
+	{
+		m_entries.reserve( strings );
+		m_chars.reserve( chars );
+	}
+
+	void clear() noexcept
+	{
+		m_chars.clear();
+		m_entries.clear();
+		std::fill( m_table.begin(), m_table.end(), emptySlot );
+		m_unique = 0;
+	}
+
+	view_type operator[]( std::size_t i ) const noexcept
+	{
+		return view( m_entries[i] );
+	}
+	view_type at( std::size_t i ) const
+	{
+		if ( i < m_entries.getSize() )
+		{
+			return view( m_entries[i] );
+		}
+		throwException( "StringVector index out of bounds." );
+	}
+	view_type front() const noexcept
+	{
+		return ( *this )[0];
+	}
+	view_type back() const noexcept
+	{
+		return ( *this )[m_entries.getSize() - 1];
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator{this, 0};
+	}
+	const_iterator end() const noexcept
+	{
+		return const_iterator{this, m_entries.getSize()};
+	}
+
+	bool isEmpty() const noexcept
+	{
+		return m_entries.getSize() == 0;
+	}
+	std::size_t getSize() const noexcept
+	{
+		return m_entries.getSize();
+	}
+	// distinct character runs stored (== getSize() without interning, unless popBack was used)
+	std::size_t getUniqueCount() const noexcept
+	{
+		return m_unique;
+	}
+	std::size_t getCharCount() const noexcept
+	{
+		return m_chars.getSize();
+	}
+	std::size_t getSizeInBytes() const noexcept
+	{
+		return m_chars.getCapacity() * sizeof( CharT ) + m_entries.getCapacity() * sizeof( Entry )
+			+ m_table.getCapacity() * sizeof( Entry );
+	}
+	Interning getInterning() const noexcept
+	{
+		return m_interning;
+	}
+};
+
+using StringVector = BasicStringVector<char>;
+using WStringVector = BasicStringVector<wchar_t>;
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <map>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include "vector.h"
+
+
+//============================================================
+//	\class	IntervalSet
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 23:30
+//
+//	\brief	disjoint half open [begin, end) index ranges; inserting merges
+//				overlapping & adjacent ranges, so the set stays minimal
+//			the range touched last is remembered: repeated & sequential
+//				marks (the common case) don't search the map
+//=============================================================
+class IntervalSet final
+{
+	std::map<std::size_t, std::size_t> m_ranges;	// begin -> end
+	std::map<std::size_t, std::size_t>::iterator m_last;
+	std::size_t m_elements;
+public:
+	IntervalSet()
+		:
+		m_ranges{},
+		m_last{m_ranges.end()},
+		m_elements{0}
+	{
+
+	}
+	IntervalSet( const IntervalSet& rhs )
+		:
+		m_ranges{rhs.m_ranges},
+		m_last{m_ranges.end()},
+		m_elements{rhs.m_elements}
+	{
+
+	}
+	IntervalSet& operator=( const IntervalSet& rhs )
+	{
+		m_ranges = rhs.m_ranges;
+		m_last = m_ranges.end();
+		m_elements = rhs.m_elements;
+		return *this;
+	}
+
+	void insert( std::size_t begin,
+		std::size_t end )
+	{
+		if ( begin >= end )
+		{
+			return;
+		}
+		if ( m_last != m_ranges.end() && begin >= m_last->first && begin <= m_last->second )
+		{
+			if ( end <= m_last->second )
+			{
+				return;
+			}
+			auto next = std::next( m_last );
+			if ( next == m_ranges.end() || end < next->first )
+			{
+				m_elements += end - m_last->second;
+				m_last->second = end;
+				return;
+			}
+		}
+		// first range that could touch [begin, end)
+		auto it = m_ranges.upper_bound( begin );
+		if ( it != m_ranges.begin() && std::prev( it )->second >= begin )
+		{
+			--it;
+		}
+		while ( it != m_ranges.end() && it->first <= end )
+		{
+			begin = std::min( begin, it->first );
+			end = std::max( end, it->second );
+			m_elements -= it->second - it->first;
+			it = m_ranges.erase( it );
+		}
+		m_last = m_ranges.emplace_hint( it, begin, end );
+		m_elements += end - begin;
+	}
+
+	// drops everything at or past `limit`
+	void truncate( std::size_t limit )
+	{
+		auto it = m_ranges.lower_bound( limit );
+		if ( it != m_ranges.begin() && std::prev( it )->second > limit )
+		{
+			m_elements -= std::prev( it )->second - limit;
+			std::prev( it )->second = limit;
+		}
+		for ( auto drop = it; drop != m_ranges.end(); ++drop )
+		{
+			m_elements -= drop->second - drop->first;
+		}
+		m_ranges.erase( it, m_ranges.end() );
+		m_last = m_ranges.end();
+	}
+
+	void clear() noexcept
+	{
+		m_ranges.clear();
+		m_last = m_ranges.end();
+		m_elements = 0;
+	}
+
+	bool isEmpty() const noexcept
+	{
+		return m_ranges.empty();
+	}
+	std::size_t getRangeCount() const noexcept
+	{
+		return m_ranges.size();
+	}
+	// total indices covered
+	std::size_t getElementCount() const noexcept
+	{
+		return m_elements;
+	}
+
+	auto begin() const noexcept
+	{
+		return m_ranges.cbegin();
+	}
+	auto end() const noexcept
+	{
+		return m_ranges.cend();
+	}
+};
+
+
+//============================================================
+//	\class	TrackedVector<T, Alloc>
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 23:30
+//
+//	\brief	opt-in change tracking over a Vector for incremental replication
+//			every mutation goes through it - operator[] hands out a proxy that
+//				records on assignment, pushBack/popBack/write/fill record their
+//				ranges - and the touched indices coalesce in an IntervalSet
+//			collectDelta() serializes the current size plus only the dirty ranges
+//				and starts a new epoch; applyDelta() replays that onto a follower
+//			delta layout (native endianness):
+//				u64 magic, u64 sizeof( T ), u64 size, u64 rangeCount
+//				per range: u64 begin, u64 count, count * T
+//=============================================================
+template<class T, class Alloc = std::allocator<T>>
+class TrackedVector
+{
+	static_assert( std::is_trivially_copyable_v<T>, "TrackedVector serializes its elements bytewise." );
+	static constexpr std::uint64_t deltaMagic = 0x31544c4544564bull;	// "KVDELT1"
+
+	Vector<T, Alloc> m_v;
+	IntervalSet m_dirty;
+
+	static void put( Vector<std::byte>& out,
+		std::uint64_t x )
+	{
+		const std::byte* p = reinterpret_cast<const std::byte*>( &x );
+		out.append( p, p + sizeof( x ) );
+	}
+public:
+	// records on write, reads pass through
+	class Ref
+	{
+		TrackedVector* m_owner;
+		std::size_t m_i;
+	public:
+		Ref( TrackedVector& owner,
+			std::size_t i ) noexcept
+			:
+			m_owner{&owner},
+			m_i{i}
+		{
+
+		}
+		operator const T&() const noexcept
+		{
+			return m_owner->m_v[m_i];
+		}
+		const T& get() const noexcept
+		{
+			return m_owner->m_v[m_i];
+		}
+		Ref& operator=( const T& val )
+		{
+			m_owner->m_v[m_i] = val;
+			m_owner->m_dirty.insert( m_i, m_i + 1 );
+			return *this;
+		}
+		Ref& operator=( const Ref& rhs )
+		{
+			return *this = rhs.get();
+		}
+		template<typename U>
+		Ref& operator+=( const U& rhs )
+		{
+			return *this = static_cast<T>( get() + rhs );
+		}
+		template<typename U>
+		Ref& operator-=( const U& rhs )
+		{
+			return *this = static_cast<T>( get() - rhs );
+		}
+		template<typename U>
+		Ref& operator*=( const U& rhs )
+		{
+			return *this = static_cast<T>( get() * rhs );
+		}
+		template<typename U>
+		Ref& operator/=( const U& rhs )
+		{
+			return *this = static_cast<T>( get() / rhs );
+		}
+	};
+
+	TrackedVector() = default;
+	explicit TrackedVector( std::size_t capacity )
+		:
+		m_v{capacity},
+		m_dirty{}
+	{
+
+	}
+	// starts clean: the follower is assumed to have been seeded with a full copy of v
+	explicit TrackedVector( Vector<T, Alloc> v )
+		:
+		m_v{std::move( v )},
+		m_dirty{}
+	{
+
+	}
+
+	Ref operator[]( std::size_t i ) noexcept
+	{
+		return Ref{*this, i};
+	}
+	const T& operator[]( std::size_t i ) const noexcept
+	{
+		return m_v[i];
+	}
+
+	void pushBack( const T& val )
+	{
+		m_v.pushBack( val );
+		m_dirty.insert( m_v.getSize() - 1, m_v.getSize() );
+	}
+	// the shrink travels as the new size
+	void popBack() noexcept
+	{
+		m_v.popBack();
+		m_dirty.truncate( m_v.getSize() );
+	}
+
+	// bulk write of [first, first + count) at `index`, which may run past the end (appends)
+	void write( std::size_t index,
+		const T* first,
+		std::size_t count )
+	{
+		assert( index <= m_v.getSize() );
+		const std::size_t overlap = std::min( count, m_v.getSize() - index );
+		std::copy( first, first + overlap, m_v.begin() + index );
+		m_v.append( first + overlap, first + count );
+		m_dirty.insert( index, index + count );
+	}
+	void fill( std::size_t begin,
+		std::size_t end,
+		const T& val )
+	{
+		std::fill( m_v.begin() + begin, m_v.begin() + end, val );
+		m_dirty.insert( begin, end );
+	}
+	// for writes that bypass the tracker (e.g. through data())
+	void markDirty( std::size_t begin,
+		std::size_t end )
+	{
+		m_dirty.insert( begin, end );
+	}
+
+	// dirty ranges + current size, then forgets them
+	Vector<std::byte> collectDelta()
+	{
+		std::size_t bytes = 4 * sizeof( std::uint64_t ) + m_dirty.getRangeCount() * 2 * sizeof( std::uint64_t )
+			+ m_dirty.getElementCount() * sizeof( T );
+		Vector<std::byte> out{bytes};
+		put( out, deltaMagic );
+		put( out, sizeof( T ) );
+		put( out, m_v.getSize() );
+		put( out, m_dirty.getRangeCount() );
+		for ( const auto& [begin, end] : m_dirty )
+		{
+			put( out, begin );
+			put( out, end - begin );
+			const std::byte* p = reinterpret_cast<const std::byte*>( m_v.data() + begin );
+			out.append( p, p + ( end - begin ) * sizeof( T ) );
+		}
+		m_dirty.clear();
+		return out;
+	}
+
+	// replays a delta onto a follower; nothing is modified if the delta is malformed
+	template<typename TargetAlloc, typename ErrorPolicy>
+	static Expected<void> applyDelta( Vector<T, TargetAlloc, ErrorPolicy>& target,
+		std::span<const std::byte> delta )
+	{
+		std::size_t at = 0;
+		auto get = [&delta, &at]( std::uint64_t& x )
+		{
+			if ( delta.size() - at < sizeof( x ) )
+			{
+				return false;
+			}
+			std::memcpy( &x, delta.data() + at, sizeof( x ) );
+			at += sizeof( x );
+			return true;
+		};
+		std::uint64_t magic, elementSize, size, rangeCount;
+		if ( !get( magic ) || !get( elementSize ) || !get( size ) || !get( rangeCount )
+			|| magic != deltaMagic || elementSize != sizeof( T ) )
+		{
+			return Expected<void>::failure( VectorError::ParseError );
+		}
+		// validate before touching the target
+		const std::size_t body = at;
+		std::uint64_t carried = 0;
+		for ( std::uint64_t r = 0; r < rangeCount; ++r )
+		{
+			std::uint64_t begin, count;
+			// count * sizeof( T ) could wrap, so compare element counts
+			if ( !get( begin ) || !get( count ) || begin > size || count > size - begin
+				|| count > ( delta.size() - at ) / sizeof( T ) )
+			{
+				return Expected<void>::failure( VectorError::ParseError );
+			}
+			at += count * sizeof( T );
+			carried += count;
+		}
+		// every element the target gains is carried by the delta (appends are dirty), so a size
+		//	the payload can't back is malformed - not a reason to allocate it
+		if ( size > target.getSize() && size - target.getSize() > carried )
+		{
+			return Expected<void>::failure( VectorError::ParseError );
+		}
+
+		if ( target.getSize() > size )
+		{
+			target.erase( target.cbegin() + size, target.cend() );
+		}
+		else if ( target.getSize() < size )
+		{
+			target.reserve( size );
+			while ( target.getSize() < size )
+			{
+				target.pushBack( T{} );
+			}
+		}
+		at = body;
+		for ( std::uint64_t r = 0; r < rangeCount; ++r )
+		{
+			std::uint64_t begin, count;
+			get( begin );
+			get( count );
+			std::memcpy( static_cast<void*>( target.data() + begin ), delta.data() + at, count * sizeof( T ) );
+			at += count * sizeof( T );
+		}
+		return Expected<void>{};
+	}
+
+	const IntervalSet& getDirtyRanges() const noexcept
+	{
+		return m_dirty;
+	}
+	// untracked access for reads
+	const Vector<T, Alloc>& getVector() const noexcept
+	{
+		return m_v;
+	}
+	const T* data() const noexcept
+	{
+		return m_v.data();
+	}
+	T* data() noexcept
+	{
+		return m_v.data();
+	}
+	std::size_t getSize() const noexcept
+	{
+		return m_v.getSize();
+	}
+	std::size_t getCapacity() const noexcept
+	{
+		return m_v.getCapacity();
+	}
+	bool isEmpty() const noexcept
+	{
+		return m_v.isEmpty();
+	}
+};
@@ -1,12 +1,25 @@
 #pragma once
 
 #include <iostream>
+#include <new>
+#include <memory>
+#include <limits>
 #include <type_traits>
 #include <string>
 #include <iterator>
+#include <span>
+#include <ranges>
 #include <algorithm>
+#include <functional>
 #include <execution>
+#include <charconv>
+#include <string_view>
 #include "custom_exception.h"
+#include "error_policy.h"
+#include "streaming.h"
+#include "compaction.h"
+#include "vector_format.h"
+#include "vector_trace.h"
 
 
 //============================================================
@@ -24,11 +37,9 @@
 //			A choice of unsigned int for size parameters is questionable.
 //				An ideal type for "size" is size_t
 //=============================================================
-template <class T, class Alloc = std::allocator<T>>
+template <class T, class Alloc = std::allocator<T>, class ErrorPolicy = DefaultErrorPolicy>
 class Vector
 {
-	template<class T>
-	friend class Iterator;
 	template<typename J>
 	friend std::wostream& operator<<( std::wostream& stream, const Vector<J>& v ) noexcept;
 	template<typename J>
@@ -58,288 +69,104 @@ public:
 	using const_reference = const T&;
 	using allocator_type = Alloc;
 
-	class Iterator final
-	{
-		Vector* m_v;
-		std::size_t m_index;
-	public:
-		using iterator_category = typename std::random_access_iterator_tag;
-		//using value_type		= typename std::iterator_traits<Iterator>::value_type;
-		//using pointer			= typename std::iterator_traits<Iterator>::pointer;
-		//using difference_type	= typename std::iterator_traits<Iterator>::difference_type;
-		//using reference		= typename std::iterator_traits<Iterator>::reference;
-		using value_type = typename Vector::value_type;
-		using pointer = typename Vector::pointer;
-		using difference_type = typename Vector::difference_type;
-		using reference = value_type&;
-
-		Iterator()
-			:
-			m_v{nullptr},
-			m_index{0}
-		{
-			
-		}
-		Iterator( Vector* m_v,
-			std::size_t index )
-			:
-			m_v{m_v},
-			m_index(index)
-		{
-		
-		}
-		Iterator( Vector& m_v,
-			std::size_t index )
-			:
-			m_v{&m_v},
-			m_index(index)
-		{
-		
-		}
+	// plain pointers are the canonical contiguous iterators: every standard library
+	//	recognizes them for its memmove/vectorized algorithm paths, which wrapper classes
+	//	don't get on all of them (libstdc++ only unwraps its own)
+	using iterator		= T*;
+	using miterator		= std::move_iterator<iterator>;
+	using riterator		= std::reverse_iterator<iterator>;
+	using citerator		= const T*;
+	using mciterator	= std::move_iterator<citerator>;
+	using rciterator	= std::reverse_iterator<citerator>;
+	// standard spelling
+	using const_iterator			= citerator;
+	using reverse_iterator			= riterator;
+	using const_reverse_iterator	= rciterator;
 
-		operator std::size_t() noexcept
-		{
-			return m_index;
-		}
+private:
+	template<class Iter>
+	static std::size_t iteratorDistance( Iter* first, Iter* last ) noexcept
+	{
+		return static_cast<std::size_t>( std::abs( last - first ) );
+	}
 
-		T& operator*()
-		{
-			return (*m_v)[m_index];
-		}
-		const T& operator*() const
-		{
-			return (*m_v)[m_index];
-		}
-		T* operator->()
-		{
-			return &( (*m_v)[m_index] );
-		}
-		const T* operator->() const
-		{
-			return &( (*m_v)[m_index] );
-		}
-		T& operator[]( difference_type m )
-		{
-			return (*m_v)[m_index + m];
-		}
-		const T& operator[]( difference_type m ) const
-		{
-			return (*m_v)[m_index + m];
-		}
-		
-		// pre-inc/dec
-		Iterator& operator++() noexcept
-		{
-			++m_index;
-			return *this;
-		}
-		Iterator& operator--() noexcept
-		{
-			--m_index;
-			return *this;
-		}
-		// post-inc/dec
-		Iterator operator++( int )
-		{
-			Iterator r{*this};
-			++m_index;
-			return r;
-		}
-		Iterator operator--( int )
-		{
-			Iterator r{*this};
-			--m_index;
-			return r;
-		}
-		
-		Iterator& operator+=( difference_type n ) noexcept
-		{
-			m_index += n;
-			return *this;
-		}
-		Iterator& operator-=( difference_type n ) noexcept
-		{
-			m_index -= n;
-			return *this;
-		}
-		
-		Iterator operator+( difference_type n ) const
-		{
-			Iterator r{*this};
-			return r += n;
-		}
-		Iterator operator-( difference_type n ) const
-		{
-			Iterator r{*this};
-			return r -= n;
-		}
-		
-		difference_type operator-( Iterator const& r ) const noexcept
-		{
-			return m_index - r.m_index;
-		}
-		
-		// comparisons
-		inline constexpr bool operator<( const Iterator& it )  const noexcept
-		{
-			return m_index < it.m_index;
-		}
-		inline constexpr bool operator<=( const Iterator& it ) const noexcept
-		{
-			return m_index <= it.m_index;
-		}
-		inline constexpr bool operator>( const Iterator& it )  const noexcept
-		{
-			return m_index > it.m_index;
-		}
-		inline constexpr bool operator>=( const Iterator& it ) const noexcept
-		{
-			return m_index >= it.m_index;
-		}
-		inline constexpr bool operator!=( const Iterator& it ) const noexcept
-		{
-			return m_index != it.m_index;
-		}
-		inline constexpr bool operator==( const Iterator& it ) const noexcept
-		{
-			return m_index == it.m_index;
-		}
-	};
+	using AllocTraits = std::allocator_traits<Alloc>;
 
-	class ConstIterator final
+	// buffers come from (stateless) Alloc
+	//	Alloc::pointer may be a fancy pointer (e.g. shm::OffsetPtr); the buffer is kept as a plain T*
+	//	in this process and converted back when it is handed to deallocate
+	static T* allocate( std::size_t capacity )
 	{
-		const Vector* m_v;
-		std::size_t m_index;
-	public:
-		using iterator_category	= typename std::random_access_iterator_tag;
-		using value_type		= const typename Vector::value_type;
-		using pointer			= typename Vector::const_pointer;
-		using difference_type	= typename Vector::difference_type;
-		using reference			= typename Vector::const_reference;
+		Alloc alloc{};
+		return std::to_address( AllocTraits::allocate( alloc, capacity ) );
+	}
 
-		ConstIterator()
-			:
-			m_v{nullptr},
-			m_index{0}
-		{
-		
-		}
-		ConstIterator( Vector* m_v,
-			std::size_t index )
-			:
-			m_v{m_v},
-			m_index(index)
+	// nullptr instead of throwing; std::allocator goes straight to the nothrow operator new
+	static T* tryAllocate( std::size_t capacity ) noexcept
+	{
+		if constexpr ( std::is_same_v<Alloc, std::allocator<T>> )
 		{
-		
+			if constexpr ( alignof( T ) > __STDCPP_DEFAULT_NEW_ALIGNMENT__ )
+			{
+				return static_cast<T*>( ::operator new( capacity * sizeof( T ), std::align_val_t{alignof( T )}, std::nothrow ) );
+			}
+			else
+			{
+				return static_cast<T*>( ::operator new( capacity * sizeof( T ), std::nothrow ) );
+			}
 		}
-		ConstIterator( Vector& m_v,
-			std::size_t index )
-			:
-			m_v{&m_v},
-			m_index(index)
+		else
 		{
-		
+#ifdef KEYVECTOR_EXCEPTIONS
+			try
+			{
+				return allocate( capacity );
+			}
+			catch ( ... )
+			{
+				return nullptr;
+			}
+#else
+			// without exceptions the allocator has to report failure by returning nullptr
+			return allocate( capacity );
+#endif
 		}
+	}
 
-		const T& operator*()
-		{
-			return (*m_v)[m_index];
-		}
-		const T* operator->()
-		{
-			return &( (*m_v)[m_index] );
-		}
-		const T& operator[]( difference_type m )
-		{
-			return (*m_v)[m_index + m];
-		}
-		
-		// pre-inc/dec
-		ConstIterator& operator++() noexcept
-		{
-			++m_index;
-			return *this;
-		}
-		ConstIterator& operator--() noexcept
-		{
-			--m_index;
-			return *this;
-		}
-		// post-inc/dec
-		ConstIterator operator++( int )
-		{
-			ConstIterator r{*this};
-			++m_index;
-			return r;
-		}
-		ConstIterator operator--( int )
-		{
-			ConstIterator r{*this};
-			--m_index;
-			return r;
-		}
-		
-		ConstIterator operator+( difference_type n )
-		{
-			ConstIterator r{*this};
-			return r += n;
-		}
-		ConstIterator operator-( difference_type n )
-		{
-			ConstIterator r{*this};
-			return r -= n;
-		}
-		
-		difference_type operator-( ConstIterator const& r ) noexcept
-		{
-			return m_index - r.m_index;
-		}
-		
-		// comparisons
-		inline constexpr bool operator<( const ConstIterator& it )  const noexcept
-		{
-			return m_index < it.m_index;
-		}
-		inline constexpr bool operator<=( const ConstIterator& it ) const noexcept
-		{
-			return m_index <= it.m_index;
-		}
-		inline constexpr bool operator>( const ConstIterator& it )  const noexcept
-		{
-			return m_index > it.m_index;
-		}
-		inline constexpr bool operator>=( const ConstIterator& it ) const noexcept
-		{
-			return m_index >= it.m_index;
-		}
-		inline constexpr bool operator!=( const ConstIterator& it ) const noexcept
-		{
-			return m_index != it.m_index;
-		}
-		inline constexpr bool operator==( const ConstIterator& it ) const noexcept
-		{
-			return m_index == it.m_index;
-		}
-	};
+	static constexpr std::size_t maxCapacity() noexcept
+	{
+		return std::numeric_limits<std::size_t>::max() / sizeof( T );
+	}
 
-	using iterator		= T*;	// Iterator
-	using miterator		= std::move_iterator<iterator>;
-	using riterator		= std::reverse_iterator<iterator>;
-	using citerator		= ConstIterator;
-	using mciterator	= std::move_iterator<citerator>;
-	using rciterator	= std::reverse_iterator<citerator>;
+	// capacity after the next growth step
+	std::size_t grownCapacity() const noexcept
+	{
+		return m_capacity > 0 ?
+			m_capacity << 1ull :
+			1;
+	}
 
-private:
-	std::size_t iteratorDistance( iterator first, iterator last ) const noexcept
+	// adopts an already allocated (empty) buffer
+	struct AdoptBuffer {};
+	Vector( AdoptBuffer,
+		T* buffer,
+		std::size_t capacity ) noexcept
+		:
+		m_size{0},
+		m_capacity{capacity},
+		m_pData{buffer}
 	{
-		return std::abs( last - first );
+
 	}
 
 	struct Deleter
 	{// objects should be already destructed prior.
+		std::size_t m_capacity;
+
 		void operator()( T* buff ) const
 		{
-			::operator delete( buff );
+			Alloc alloc{};
+			AllocTraits::deallocate( alloc, std::pointer_traits<pointer>::pointer_to( *buff ), m_capacity );
 		}
 	};
 
@@ -352,13 +179,17 @@ private:
 		return false;
 	}
 
-	constexpr bool isValidIndex( std::size_t i ) const noexcept
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	// p's index if it points into our elements, npos otherwise - lets a source that aliases
+	//	the buffer be found again after a reallocation
+	std::size_t indexOf( const T* p ) const noexcept
 	{
-		if ( i < m_capacity )
+		if ( std::less<const T*>{}( p, m_pData ) || !std::less<const T*>{}( p, m_pData + m_size ) )
 		{
-			return true;
+			return npos;
 		}
-		return false;
+		return static_cast<std::size_t>( p - m_pData );
 	}
 
 	bool needsRestructuring() const noexcept
@@ -366,41 +197,33 @@ private:
 		return m_size == m_capacity;
 	}
 
-	template<typename U>
-	typename std::enable_if_t<!( std::is_nothrow_copy_constructible_v<U>
-		&& std::is_nothrow_destructible_v<U> )>
-		copyAssign( const Vector<U>& copy )
-	{
-		// copy and swap
-		Vector<U> temp{copy};
-		temp.swap( *this );
-	}
+	// element lifecycle tiers, picked at compile time by every construct/copy/relocate/destroy path:
+	//	trivial:		trivially copyable & destructible - bytes are copied (memcpy/streaming), nothing is destroyed
+	//	nothrow move:	relocation (growth) move constructs, copies copy construct, destructors run
+	//	general:		relocation copies, so a throwing element leaves the source intact (strong guarantee)
+	static constexpr bool isTrivialTier = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+	static constexpr bool isNothrowMoveTier = !isTrivialTier && std::is_nothrow_move_constructible_v<T>;
 
-	template<typename U>
-	typename std::enable_if_t<( std::is_nothrow_copy_constructible_v<U>
-		&& std::is_nothrow_destructible_v<U> )>
-		copyAssign( const Vector<U>& copy )
+	void copyAssign( const Vector& copy )
 	{
-		// self assignment check
 		if ( this == &copy )
 		{
 			return;
 		}
-		// if we have enough space available, reuse it
-		if ( m_capacity <= copy.getSize() )
+		if constexpr ( isTrivialTier || ( std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_destructible_v<T> ) )
 		{
-			clear<T>();
-			for ( std::size_t i = 0; i < copy.getSize(); ++i )
+			// reuse the buffer if it is big enough; copying can't fail halfway
+			if ( m_capacity >= copy.m_size )
 			{
-				moveBackImpl( std::move( copy[i] ) );
+				KEYVECTOR_TRACE_SCOPE( tracing::Kind::BulkCopy, m_capacity, m_capacity, copy.m_size * sizeof( T ) );
+				destroyTail( 0 );
+				copyConstructRange( copy.m_pData, copy.m_size );
+				return;
 			}
 		}
-		// fallback to straight copying
-		else
-		{
-			Vector<T> temp{copy};
-			temp.swap( *this );
-		}
+		// copy and swap (traced by the copy constructor)
+		Vector temp{copy};
+		temp.swap( *this );
 	}
 
 	void pushBackImpl( const T& val )
@@ -414,29 +237,155 @@ private:
 		++m_size;
 	}
 
-	template<typename U>
-	typename std::enable_if_t<!std::is_nothrow_copy_constructible_v<U>>
-		selfCopyTo( Vector<U>& other )
+	// copy-constructs [first, first + count) at the end - capacity must already suffice
+	//	the trivial tier is copied bytewise (non-temporally above the streaming threshold)
+	void copyConstructRange( const T* first,
+		std::size_t count )
+	{
+		if constexpr ( isTrivialTier )
+		{
+			streaming::copy( m_pData + m_size, first, count * sizeof( T ) );
+			m_size += count;
+		}
+		else
+		{
+			constexpr std::size_t ahead = std::max<std::size_t>( streaming::prefetchDistance / sizeof( T ), 1 );
+			for ( std::size_t i = 0; i < count; ++i )
+			{
+				if ( i + ahead < count )
+				{
+					streaming::prefetch( first + i + ahead );
+				}
+				pushBackImpl( first[i] );
+			}
+		}
+	}
+
+	// moves all of from's elements to the end of this (capacity must suffice) & leaves from empty
+	void relocateFrom( Vector& from )
+	{
+		if constexpr ( isTrivialTier )
+		{
+			streaming::copy( m_pData + m_size, from.m_pData, from.m_size * sizeof( T ) );
+			m_size += from.m_size;
+			from.m_size = 0;
+		}
+		else
+		{
+			if constexpr ( isNothrowMoveTier )
+			{
+				for ( std::size_t i = 0; i < from.m_size; ++i )
+				{
+					moveBackImpl( std::move( from.m_pData[i] ) );
+				}
+			}
+			else
+			{
+				copyConstructRange( from.m_pData, from.m_size );
+			}
+			from.destroyTail( 0 );
+		}
+	}
+
+	// constructs count copies of value at the end - capacity must already suffice
+	void fillConstructRange( const T& value,
+		std::size_t count )
+	{
+		if constexpr ( isTrivialTier )
+		{
+			streaming::fill( m_pData + m_size, value, count );
+			m_size += count;
+		}
+		else
+		{
+			for ( std::size_t i = 0; i < count; ++i )
+			{
+				pushBackImpl( value );
+			}
+		}
+	}
+
+	// runs a constructor body that fills the (already allocated) buffer; if it throws,
+	//	the constructed elements are destroyed & the buffer released, as the destructor won't run
+	template<typename F>
+	void constructOrRelease( F&& construct )
+	{
+#ifdef KEYVECTOR_EXCEPTIONS
+		if constexpr ( isTrivialTier )
+		{
+			construct();
+		}
+		else
+		{
+			try
+			{
+				construct();
+			}
+			catch ( ... )
+			{
+				destroyTail( 0 );
+				std::unique_ptr<T, Deleter> deletesAtEndOfScope{m_pData, Deleter{m_capacity}};
+				throw;	// continue propagating the caught exception outside
+			}
+		}
+#else
+		construct();
+#endif
+	}
+	// destroys [newSize, m_size) & shrinks to newSize
+	void destroyTail( std::size_t newSize ) noexcept
 	{
-		std::for_each( m_pData,
-			m_pData + m_size,
-			[&other]( const T& srcVal )
+		if constexpr ( !std::is_trivially_destructible_v<T> )
+		{
+			for ( std::size_t i = m_size; i > newSize; --i )
 			{
-				other.pushBackImpl( srcVal );
+				m_pData[i - 1].~T();
 			}
-		);
+		}
+		m_size = newSize;
 	}
-	template<typename U>
-	typename std::enable_if_t<std::is_nothrow_move_constructible_v<U>>
-		selfMoveTo( Vector<U>& other )
+
+	// resize()'s & reserve()'s reallocation: relocates into a new buffer of newCapacity elements
+	void restructure( std::size_t newCapacity )
+	{
+		Vector tmp{newCapacity};
+		destroyTail( std::min( newCapacity, m_size ) );
+		tmp.relocateFrom( *this );
+		tmp.swap( *this );
+	}
+
+	// growth by pushBack/emplaceBack: the new element is constructed in the new buffer before the
+	//	old ones are relocated (moved from & destroyed), so args may refer to them
+	//	(v.emplaceBack( v[0] ), v.pushBack( std::move( v.back() ) ))
+	template<typename... TArgs>
+	void growAndEmplaceBack( TArgs&&... args )
 	{
-		std::for_each( m_pData,
-			m_pData + m_size,
-			[&other]( T&& srcVal )
+		const std::size_t newCapacity = grownCapacity();
+		KEYVECTOR_TRACE_SCOPE( tracing::Kind::Realloc, m_capacity, newCapacity, m_size * sizeof( T ) );
+		Vector tmp{newCapacity};
+		[[maybe_unused]] T* const p = ::new ( tmp.m_pData + m_size ) T(std::forward<TArgs>( args )...);
+#ifdef KEYVECTOR_EXCEPTIONS
+		if constexpr ( isTrivialTier || isNothrowMoveTier )
+		{
+			tmp.relocateFrom( *this );
+		}
+		else
+		{
+			try
+			{
+				tmp.relocateFrom( *this );
+			}
+			catch ( ... )
 			{
-				other.moveBackImpl( std::move( srcVal ) );
+				p->~T();	// past tmp's size, its destructor won't see it
+				throw;
 			}
-		);
+		}
+#else
+		tmp.relocateFrom( *this );
+#endif
+		++tmp.m_size;
+		tmp.swap( *this );
 	}
 public:
 	// def ctor
@@ -444,7 +393,7 @@ public:
 		:
 		m_size{0},
 		m_capacity{64},
-		m_pData{static_cast<T*>( ::operator new( sizeof( T ) * m_capacity ) )}
+		m_pData{allocate( m_capacity )}
 	{
 	
 	}
@@ -452,7 +401,7 @@ public:
 		:
 		m_size{0},
 		m_capacity(capacity),
-		m_pData{static_cast<T*>( ::operator new( sizeof( T ) * m_capacity ) )}
+		m_pData{allocate( m_capacity )}
 	{
 	
 	}
@@ -464,20 +413,12 @@ public:
 		:
 		m_size{0},
 		m_capacity(capacity),
-		m_pData{static_cast<T*>( ::operator new( sizeof( T ) * m_capacity ) )}
-	{
-		//std::for_each( std::execution::par_unseq,
-		//	&m_pData[0],
-		//	&m_pData[capacity],
-		//	[this, &value] ( const T& val )
-		//	{
-		//		this->selfPushBack( value );
-		//	} );
-	
-		for ( std::size_t i = 0; i < m_capacity; ++i )
-		{
-			pushBackImpl( value );
-		}
+		m_pData{allocate( m_capacity )}
+	{
+		constructOrRelease( [this, &value]
+			{
+				fillConstructRange( value, m_capacity );
+			} );
 	}
 
 	// construct from given range of elements
@@ -487,12 +428,23 @@ public:
 		:
 		m_size{0},
 		m_capacity{iteratorDistance( begin, end )},
-		m_pData{static_cast<T*>( ::operator new( sizeof( T ) * m_capacity ) )}
+		m_pData{allocate( m_capacity )}
 	{
-		for ( auto it = begin; it < end; ++it )
-		{
-			pushBackImpl( *it );
-		}
+		KEYVECTOR_TRACE_SCOPE( tracing::Kind::BulkCopy, 0, m_capacity, m_capacity * sizeof( T ) );
+		constructOrRelease( [this, begin, end]
+			{
+				if constexpr ( std::is_same_v<std::remove_const_t<Iter>, T> )
+				{
+					copyConstructRange( begin, m_capacity );
+				}
+				else
+				{
+					for ( auto it = begin; it < end; ++it )
+					{
+						pushBackImpl( *it );
+					}
+				}
+			} );
 	}
 
 	// delegating ctor
@@ -506,8 +458,8 @@ public:
 
 	~Vector()
 	{
-		clear<T>();
-		Deleter deleter{};
+		destroyTail( 0 );
+		Deleter deleter{m_capacity};
 		std::unique_ptr<T, Deleter> deletesAtEndOfScope{m_pData, std::move( deleter )};
 		//m_pdata = nullptr;
 	}
@@ -516,21 +468,13 @@ public:
 		:
 		m_size{0},
 		m_capacity{rhs.m_capacity},
-		m_pData{static_cast<T*>( ::operator new( sizeof( T ) * m_capacity ) )}
+		m_pData{allocate( m_capacity )}
 	{
-		try
-		{
-			for ( std::size_t i = 0; i < rhs.getCapacity(); ++i )
+		KEYVECTOR_TRACE_SCOPE( tracing::Kind::BulkCopy, 0, m_capacity, rhs.m_size * sizeof( T ) );
+		constructOrRelease( [this, &rhs]
 			{
-				pushBackImpl( rhs.m_pData[i] );
-			}
-		}
-		catch ( ... )
-		{
-			clear<T>();
-			std::unique_ptr<T, Deleter> deletesAtEndOfScope{m_pData, Deleter{}};
-			throw;	// continue propagating the caught exception outside
-		}
+				copyConstructRange( rhs.m_pData, rhs.m_size );
+			} );
 	}
 
 	Vector& operator=( const Vector& rhs )
@@ -548,9 +492,11 @@ public:
 		rhs.swap( *this );
 	}
 
+	// our old elements are destroyed now, not whenever rhs happens to die
 	Vector& operator=( Vector&& rhs ) noexcept
 	{
-		rhs.swap( *this );
+		Vector temp{std::move( rhs )};
+		temp.swap( *this );
 		return *this;
 	}
 
@@ -558,12 +504,35 @@ public:
 	{
 		if ( newCapacity > m_capacity )
 		{
-			Vector<T> tmp{newCapacity};
-			tmp.swap( *this );
+			KEYVECTOR_TRACE_SCOPE( tracing::Kind::Reserve, m_capacity, newCapacity, m_size * sizeof( T ) );
+			restructure( newCapacity );
 		}
 		// don't shrink otherwise
 	}
 
+	// reserve() that reports allocation failure instead of throwing
+	Expected<void> tryReserve( const std::size_t newCapacity )
+	{
+		if ( newCapacity <= m_capacity )
+		{
+			return {};
+		}
+		if ( newCapacity > maxCapacity() )
+		{
+			return Expected<void>::failure( VectorError::LengthError );
+		}
+		KEYVECTOR_TRACE_SCOPE( tracing::Kind::Reserve, m_capacity, newCapacity, m_size * sizeof( T ) );
+		T* buffer = tryAllocate( newCapacity );
+		if ( !buffer )
+		{
+			return Expected<void>::failure( VectorError::BadAlloc );
+		}
+		Vector tmp{AdoptBuffer{}, buffer, newCapacity};
+		tmp.relocateFrom( *this );
+		tmp.swap( *this );
+		return {};
+	}
+
 	void swap( Vector& rhs ) noexcept
 	{
 		std::swap( m_size, rhs.m_size );
@@ -571,11 +540,13 @@ public:
 		std::swap( m_pData, rhs.m_pData );
 	}
 
+	// val may be one of our own elements (v.pushBack( v[0] )), see growAndEmplaceBack()
 	void pushBack( T&& val )
 	{
 		if ( needsRestructuring() )
 		{
-			resize( m_capacity << 1ull );
+			growAndEmplaceBack( std::move( val ) );
+			return;
 		}
 		moveBackImpl( std::move( val ) );
 	}
@@ -583,9 +554,95 @@ public:
 	{
 		if ( needsRestructuring() )
 		{
-			resize( m_capacity << 1ull );
+			growAndEmplaceBack( val );
+			return;
+		}
+		pushBackImpl( val );
+	}
+
+	// bulk append; [first, last) may lie inside this Vector (v.append( v ) or a view of it)
+	//	such a range is rebased onto the new buffer when appending reallocates
+	void append( const T* first,
+		const T* last )
+	{
+		const std::size_t count = static_cast<std::size_t>( last - first );
+		const bool grows = m_size + count > m_capacity;
+		const std::size_t newCapacity = grows ?
+			std::max( m_capacity << 1ull, m_size + count ) :
+			m_capacity;
+		// one event per call: the reallocation if it grows, the (bulk) copy otherwise
+		KEYVECTOR_TRACE_SCOPE( grows ? tracing::Kind::Realloc : tracing::Kind::BulkCopy,
+			m_capacity,
+			newCapacity,
+			( grows ? m_size + count : count ) * sizeof( T ) );
+		if ( grows )
+		{
+			const std::size_t at = indexOf( first );
+			restructure( newCapacity );
+			if ( at != npos )
+			{
+				first = m_pData + at;
+			}
+		}
+		copyConstructRange( first, count );
+	}
+	void append( const Vector& other )
+	{
+		append( other.m_pData, other.m_pData + other.m_size );
+	}
+
+	// trivial tier only: makes room for maxCount more elements & lets fill( T* dst ) write them
+	//	straight into the buffer, without initializing it first; fill returns how many it wrote
+	template<typename F>
+	std::size_t appendInPlace( std::size_t maxCount,
+		F fill )
+	{
+		static_assert( isTrivialTier, "appendInPlace() hands out raw memory, T has to be trivially copyable & destructible." );
+		if ( m_size + maxCount > m_capacity )
+		{
+			resize( std::max( m_capacity << 1ull, m_size + maxCount ) );
+		}
+		const std::size_t written = fill( m_pData + m_size );
+		m_size += std::min( written, maxCount );
+		return written;
+	}
+
+	// pushBack() that reports allocation failure instead of throwing
+	Expected<void> tryPushBack( const T& val )
+	{
+		if ( needsRestructuring() )
+		{
+			const std::size_t at = indexOf( &val );
+			if ( Expected<void> grown = tryReserve( grownCapacity() ); !grown )
+			{
+				return grown;
+			}
+			if ( at != npos )
+			{
+				pushBackImpl( m_pData[at] );
+				return {};
+			}
 		}
 		pushBackImpl( val );
+		return {};
+	}
+	Expected<void> tryPushBack( T&& val )
+	{
+		if ( needsRestructuring() )
+		{
+			const std::size_t at = indexOf( &val );
+			if ( Expected<void> grown = tryReserve( grownCapacity() ); !grown )
+			{
+				return grown;
+			}
+			if ( at != npos )
+			{
+				moveBackImpl( std::move( m_pData[at] ) );
+				return {};
+			}
+		}
+		moveBackImpl( std::move( val ) );
+		return {};
 	}
 
 	template<typename... TArgs>
@@ -593,7 +650,8 @@ public:
 	{
 		if ( needsRestructuring() )
 		{
-			resize( m_capacity << 1ull );
+			growAndEmplaceBack( std::forward<TArgs>( args )... );
+			return;
 		}
 		::new ( m_pData + m_size ) T(std::forward<TArgs>( args )...);
 		++m_size;
@@ -601,82 +659,107 @@ public:
 
 	void popBack() noexcept
 	{
-		--m_size;
-		m_pData[m_size].~T();
+		destroyTail( m_size - 1 );
 	}
 
-	// restructuring / replacing vector in memory with a new one of different capacity
-	//	old values are retained - invalidates pointers/iterators
-	//	Complexity: O(n^2): worst case, O(n): average case
-	void resize( std::size_t newCapacity )
+	//===================================================
+	//	\function	erase
+	//	\brief  removes [first, last), the elements after it move down (memmove for trivially copyable T)
+	//			returns an iterator to the element that followed the erased range
+	//	\date	19/10/2026 22:00
+	iterator erase( const_iterator first,
+		const_iterator last )
 	{
-		Vector<T> tmp{newCapacity};
-		if ( newCapacity > m_size )
+		T* const f = m_pData + ( first - m_pData );
+		T* const l = m_pData + ( last - m_pData );
+		if ( f != l )
 		{
-			std::for_each( m_pData,
-				m_pData + m_size,
-				[&tmp]( const T& arg )
-				{
-					tmp.pushBackImpl( arg );
-				}
-			);
+			compaction::shiftDown( f, l, m_pData + m_size );
+			destroyTail( m_size - static_cast<std::size_t>( l - f ) );
 		}
-		else if ( newCapacity < m_size )
+		return f;
+	}
+	iterator erase( const_iterator pos )
+	{
+		return erase( pos, pos + 1 );
+	}
+
+	// stable single pass removal of the elements pred accepts, returns how many went
+	//	4/8 byte arithmetic types compact with SIMD permutes (see compaction.h)
+	template<typename Pred>
+	std::size_t eraseIf( Pred pred )
+	{
+		const std::size_t oldSize = m_size;
+		destroyTail( compaction::removeIf( m_pData, m_size, pred ) );
+		return oldSize - m_size;
+	}
+
+	// O(1), the last element takes the removed one's place
+	void swapRemove( std::size_t index ) noexcept( std::is_nothrow_move_assignable_v<T> )
+	{
+		if ( index != m_size - 1 )
 		{
-			std::for_each( m_pData,
-				m_pData + newCapacity,
-				[&tmp]( const T& arg )
-				{
-					tmp.pushBackImpl( arg );
-				}
-			);
+			m_pData[index] = std::move( m_pData[m_size - 1] );
 		}
-		else
+		popBack();
+	}
+
+	// removes the elements at the strictly ascending positions sortedIndices, survivors keep their order
+	void removeIndices( std::span<const std::size_t> sortedIndices )
+	{
+		destroyTail( compaction::removeIndices( m_pData, m_size, sortedIndices.data(), sortedIndices.size() ) );
+	}
+
+	// restructuring / replacing vector in memory with a new one of different capacity
+	//	old values are retained (the ones past a smaller newCapacity are destroyed) and relocated
+	//	by tier: memcpy, move or copy - invalidates pointers/iterators
+	void resize( std::size_t newCapacity )
+	{
+		if ( newCapacity == m_size )
 		{
 			return;
 		}
-		tmp.swap( *this );
+		KEYVECTOR_TRACE_SCOPE( newCapacity < m_capacity ? tracing::Kind::Shrink : tracing::Kind::Realloc,
+			m_capacity,
+			newCapacity,
+			std::min( newCapacity, m_size ) * sizeof( T ) );
+		restructure( newCapacity );
 	}
 
 	//===================================================
 	//	\function	clear
-	//	\brief  clear() must delete[] buffer.
+	//	\brief  destroys the elements (in reverse order; a no-op for trivially destructible types)
+	//			and empties the Vector, the buffer stays
 	//	\date	20/10/2018 18:17
-	template<typename U>
-	typename std::enable_if_t<!std::is_trivially_constructible_v<U>>
-		clear() noexcept
+	void clear() noexcept
 	{
-		// destroy the elements in reverse order
-		for ( std::size_t i = m_size; i > 0; --i )
-		{
-			m_pData[i - 1].~T();
-		}
-	}
-	// SFINAE optimization - no need to reallocate for builtins/pods - just copy over them
-	// trivially destructible objects can used without calling destructors
-	template<typename U>
-	typename std::enable_if_t<std::is_trivially_constructible_v<U>>
-		clear() noexcept
-	{
-
+		destroyTail( 0 );
 	}
 
 	// forward
 	iterator begin() noexcept
 	{
-		return &m_pData[0];
+		return m_pData;
 	}
 	iterator end() noexcept
 	{
-		return &m_pData[m_size];	// or m_pdata + m_size
+		return m_pData + m_size;
+	}
+	citerator begin() const noexcept
+	{
+		return m_pData;
+	}
+	citerator end() const noexcept
+	{
+		return m_pData + m_size;
 	}
 	citerator cbegin() const noexcept
 	{
-		return &m_pData[0];
+		return m_pData;
 	}
 	citerator cend() const noexcept
 	{
-		return &m_pData[m_size];
+		return m_pData + m_size;
 	}
 	// reverse
 	riterator rbegin() noexcept
@@ -696,6 +779,29 @@ public:
 		return rciterator{cbegin()};
 	}
 
+	// contiguous storage
+	T* data() noexcept
+	{
+		return m_pData;
+	}
+	const T* data() const noexcept
+	{
+		return m_pData;
+	}
+	// std::ranges::size() & friends
+	std::size_t size() const noexcept
+	{
+		return m_size;
+	}
+	std::span<T> asSpan() noexcept
+	{
+		return std::span<T>{m_pData, m_size};
+	}
+	std::span<const T> asSpan() const noexcept
+	{
+		return std::span<const T>{m_pData, m_size};
+	}
+
 	T& front() noexcept
 	{
 		return m_pData[0];
@@ -743,21 +849,39 @@ public:
 	{
 		return m_pData[index];
 	}
-	T& at( std::size_t index ) const
+	// bounds checked against the size; failure is reported through ErrorPolicy
+	typename ErrorPolicy::template Result<const T&> at( std::size_t index ) const
 	{
-		if ( isValidIndex( index ) )
+		if ( isInitializedIndex( index ) )
 		{
-			return m_pData[index];
+			return ErrorPolicy::template success<const T&>( m_pData[index] );
 		}
-		throwException( "Array out of bounds exception." );
+		return ErrorPolicy::template failure<const T&>( VectorError::OutOfRange );
 	}
-	T& at( std::size_t index )
+	typename ErrorPolicy::template Result<T&> at( std::size_t index )
 	{
-		if ( isValidIndex( index ) )
+		if ( isInitializedIndex( index ) )
 		{
-			return m_pData[index];
+			return ErrorPolicy::template success<T&>( m_pData[index] );
 		}
-		throwException( "Array out of bounds exception." );
+		return ErrorPolicy::template failure<T&>( VectorError::OutOfRange );
+	}
+	// never throws, whatever the policy
+	Expected<const T&> tryAt( std::size_t index ) const noexcept
+	{
+		if ( isInitializedIndex( index ) )
+		{
+			return Expected<const T&>{m_pData[index]};
+		}
+		return Expected<const T&>::failure( VectorError::OutOfRange );
+	}
+	Expected<T&> tryAt( std::size_t index ) noexcept
+	{
+		if ( isInitializedIndex( index ) )
+		{
+			return Expected<T&>{m_pData[index]};
+		}
+		return Expected<T&>::failure( VectorError::OutOfRange );
 	}
 	bool isEmpty() const noexcept
 	{
@@ -778,8 +902,21 @@ public:
 		return m_capacity;
 	}
 
+	// arithmetic elements go through textio::BulkFormatter (to_chars into a reusable buffer,
+	//	flushed in large writes, honoring the stream's precision & floatfield) unless the stream
+	//	asks for formatting it can't reproduce (see textio::FormatOptions::canBulkFormat);
+	//	the rest are streamed one by one
 	void printW( std::wostream& stream = std::wcout ) const noexcept
 	{
+		if constexpr ( textio::isBulkFormattable<T> )
+		{
+			if ( textio::FormatOptions::canBulkFormat( stream ) )
+			{
+				textio::BulkFormatter formatter{textio::FormatOptions::fromStream( stream ), std::min<std::size_t>( 1ull << 16, m_size * 32 + 64 )};
+				formatter.write( stream, m_pData, m_pData + m_size );
+				return;
+			}
+		}
 		for ( std::size_t i = 0; i < m_size; ++i )
 		{
 			stream << m_pData[i]
@@ -788,12 +925,76 @@ public:
 	}
 	void print( std::ostream& stream = std::cout ) const noexcept
 	{
+		if constexpr ( textio::isBulkFormattable<T> )
+		{
+			if ( textio::FormatOptions::canBulkFormat( stream ) )
+			{
+				textio::BulkFormatter formatter{textio::FormatOptions::fromStream( stream ), std::min<std::size_t>( 1ull << 16, m_size * 32 + 64 )};
+				formatter.write( stream, m_pData, m_pData + m_size );
+				return;
+			}
+		}
 		for ( std::size_t i = 0; i < m_size; ++i )
 		{
 			stream << m_pData[i]
 				<< ' ';
 		}
 	}
+
+	//===================================================
+	//	\function	fromChars
+	//	\brief  parses delimiter separated arithmetic values with std::from_chars
+	//			runs of delimiters (options.delimiters) are skipped, every other token has to be a whole value
+	//			fails with VectorError::ParseError on a malformed or out of range token
+	//	\date	19/10/2026 19:45
+	static Expected<Vector> fromChars( std::string_view text,
+		const textio::ParseOptions& options = {} )
+	{
+		static_assert( textio::isBulkFormattable<T>, "Vector::fromChars parses arithmetic (non character) types." );
+		bool isDelimiter[256]{};
+		for ( const char c : options.delimiters )
+		{
+			isDelimiter[static_cast<unsigned char>( c )] = true;
+		}
+
+		Vector v{std::max<std::size_t>( 64, text.size() / 8 )};
+		const char* it = text.data();
+		const char* const end = it + text.size();
+		while ( true )
+		{
+			while ( it != end && isDelimiter[static_cast<unsigned char>( *it )] )
+			{
+				++it;
+			}
+			if ( it == end )
+			{
+				break;
+			}
+			const char* tokenEnd = it;
+			while ( tokenEnd != end && !isDelimiter[static_cast<unsigned char>( *tokenEnd )] )
+			{
+				++tokenEnd;
+			}
+
+			T value;
+			std::from_chars_result r;
+			if constexpr ( std::is_floating_point_v<T> )
+			{
+				r = std::from_chars( it, tokenEnd, value, options.floatFormat );
+			}
+			else
+			{
+				r = std::from_chars( it, tokenEnd, value );
+			}
+			if ( r.ec != std::errc{} || r.ptr != tokenEnd )
+			{
+				return Expected<Vector>::failure( VectorError::ParseError );
+			}
+			v.pushBack( value );
+			it = tokenEnd;
+		}
+		return Expected<Vector>{std::move( v )};
+	}
 };
 
 
@@ -801,22 +1002,16 @@ template<typename J>
 std::wostream& operator<<( std::wostream& stream,
 	const Vector<J>& v ) noexcept
 {
-	for ( std::size_t i = 0; i < v.m_size; ++i )
-	{
-		stream << v.m_pData[i]
-			<< L' ';
-	}
+	v.printW( stream );
+	return stream;
 }
 
 template<typename J>
 std::ostream& operator<<( std::ostream& stream,
 	const Vector<J>& v ) noexcept
 {
-	for ( std::size_t i = 0; i < v.m_size; ++i )
-	{
-		stream << v.m_pData[i]
-			<< ' ';
-	}
+	v.print( stream );
+	return stream;
 }
 
 // specialization of std::swap for the Vector class
@@ -825,4 +1020,14 @@ void swap( Vector<T>& lhs,
 	Vector<T>& rhs ) noexcept
 {
 	lhs.swap( rhs );
-}
\ No newline at end of file
+}
+
+// Vector is a contiguous, sized range: std::span<T> converts from it implicitly
+//	(through span's range constructor) and the std::ranges algorithms take it as is
+static_assert( std::contiguous_iterator<Vector<int>::iterator> );
+static_assert( std::contiguous_iterator<Vector<int>::const_iterator> );
+static_assert( std::ranges::contiguous_range<Vector<int>> );
+static_assert( std::ranges::contiguous_range<const Vector<int>> );
+static_assert( std::ranges::sized_range<Vector<int>> );
+static_assert( std::is_convertible_v<Vector<int>&, std::span<int>> );
+static_assert( std::is_convertible_v<const Vector<int>&, std::span<const int>> );
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <ostream>
+#include <locale>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <system_error>
+
+
+//============================================================
+//	bulk text formatting of arithmetic element ranges
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 19:45
+//
+//	\brief	elements are rendered with std::to_chars straight into a reusable
+//				buffer which is handed to the stream buffer in large writes
+//				(one sputn per buffer instead of 2 formatted inserts per element)
+//			wide streams get the (ascii) output widened chunk by chunk
+//			types the stream prints specially (bool, character types) are not bulk formattable
+//=============================================================
+namespace textio
+{
+
+template<typename T>
+inline constexpr bool isBulkFormattable = ( std::is_integral_v<T>
+		&& !std::is_same_v<T, bool>
+		&& !std::is_same_v<T, char>
+		&& !std::is_same_v<T, signed char>
+		&& !std::is_same_v<T, unsigned char>
+		&& !std::is_same_v<T, wchar_t>
+		&& !std::is_same_v<T, char8_t>
+		&& !std::is_same_v<T, char16_t>
+		&& !std::is_same_v<T, char32_t> )
+	|| std::is_floating_point_v<T>;
+
+struct FormatOptions
+{
+	std::string_view delimiter = " ";
+	bool trailingDelimiter = true;	// the stream path always wrote one
+	int precision = -1;				// floating point: -1 = shortest round-trip representation
+	std::chars_format floatFormat = std::chars_format::general;
+
+	// whether fromStream() captures everything `stream << value` depends on: the formatting flags
+	//	& width it doesn't translate (base, showbase, showpos, showpoint, uppercase) are at their
+	//	defaults & the locale is the classic one (no digit grouping), otherwise print per element
+	template<typename CharT>
+	static bool canBulkFormat( const std::basic_ostream<CharT>& stream ) noexcept
+	{
+		const std::ios_base::fmtflags flags = stream.flags();
+		const std::ios_base::fmtflags base = flags & std::ios_base::basefield;
+		return ( base == std::ios_base::dec || base == std::ios_base::fmtflags{} )
+			&& ( flags & ( std::ios_base::showbase | std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::uppercase ) ) == std::ios_base::fmtflags{}
+			&& stream.width() == 0
+			&& stream.getloc() == std::locale::classic();
+	}
+
+	// what `stream << value` would produce with the stream's current precision & floatfield
+	template<typename CharT>
+	static FormatOptions fromStream( const std::basic_ostream<CharT>& stream ) noexcept
+	{
+		FormatOptions options;
+		options.precision = static_cast<int>( stream.precision() );
+		const auto field = stream.flags() & std::ios_base::floatfield;
+		if ( field == std::ios_base::fixed )
+		{
+			options.floatFormat = std::chars_format::fixed;
+		}
+		else if ( field == std::ios_base::scientific )
+		{
+			options.floatFormat = std::chars_format::scientific;
+		}
+		else if ( field == ( std::ios_base::fixed | std::ios_base::scientific ) )
+		{
+			options.floatFormat = std::chars_format::hex;
+			options.precision = -1;
+		}
+		return options;
+	}
+};
+
+class BulkFormatter final
+{
+	static constexpr std::size_t elementSlack = 64;	// room that fits any integer & most floats
+
+	std::size_t m_capacity;
+	std::unique_ptr<char[]> m_buffer;
+	std::unique_ptr<wchar_t[]> m_wideBuffer;
+	FormatOptions m_options;
+
+	template<typename CharT>
+	void flush( std::basic_ostream<CharT>& stream,
+		const char* data,
+		std::size_t n )
+	{
+		if ( n == 0 )
+		{
+			return;
+		}
+		std::streamsize written;
+		if constexpr ( std::is_same_v<CharT, char> )
+		{
+			written = stream.rdbuf()->sputn( data, static_cast<std::streamsize>( n ) );
+		}
+		else
+		{
+			if ( !m_wideBuffer )
+			{
+				m_wideBuffer = std::make_unique<wchar_t[]>( m_capacity );
+			}
+			for ( std::size_t i = 0; i < n; ++i )
+			{
+				m_wideBuffer[i] = static_cast<wchar_t>( static_cast<unsigned char>( data[i] ) );
+			}
+			written = stream.rdbuf()->sputn( m_wideBuffer.get(), static_cast<std::streamsize>( n ) );
+		}
+		if ( written != static_cast<std::streamsize>( n ) )
+		{
+			stream.setstate( std::ios_base::badbit );
+		}
+	}
+
+	template<typename T>
+	std::to_chars_result render( char* first,
+		char* last,
+		T value ) const noexcept
+	{
+		if constexpr ( std::is_floating_point_v<T> )
+		{
+			return m_options.precision < 0 ?
+				std::to_chars( first, last, value, m_options.floatFormat ) :
+				std::to_chars( first, last, value, m_options.floatFormat, m_options.precision );
+		}
+		else
+		{
+			return std::to_chars( first, last, value );
+		}
+	}
+public:
+	explicit BulkFormatter( FormatOptions options = {},
+		std::size_t bufferSize = 1ull << 16 )
+		:
+		m_capacity{std::max<std::size_t>( bufferSize, elementSlack * 8 + options.delimiter.size() )},
+		m_buffer{std::make_unique<char[]>( m_capacity )},
+		m_wideBuffer{},
+		m_options{options}
+	{
+
+	}
+
+	const FormatOptions& getOptions() const noexcept
+	{
+		return m_options;
+	}
+	void setOptions( const FormatOptions& options ) noexcept
+	{
+		m_options = options;
+	}
+
+	// renders [first, last) chunk by chunk, sink( const char* data, std::size_t n ) consumes the chunks
+	template<typename T, typename Sink>
+	void format( const T* first,
+		const T* last,
+		Sink&& sink )
+	{
+		static_assert( isBulkFormattable<T>, "BulkFormatter handles arithmetic (non character) types." );
+		const std::string_view delim = m_options.delimiter;
+		char* const begin = m_buffer.get();
+		char* const end = begin + m_capacity;
+		char* cur = begin;
+		for ( const T* it = first; it != last; ++it )
+		{
+			if ( static_cast<std::size_t>( end - cur ) < elementSlack + delim.size() )
+			{
+				sink( begin, static_cast<std::size_t>( cur - begin ) );
+				cur = begin;
+			}
+			std::to_chars_result r = render( cur, end, *it );
+			if ( r.ec != std::errc{} )
+			{
+				// a (long fixed notation) value larger than the slack
+				sink( begin, static_cast<std::size_t>( cur - begin ) );
+				cur = begin;
+				r = render( cur, end, *it );
+			}
+			cur = r.ptr;
+			if ( it + 1 != last || m_options.trailingDelimiter )
+			{
+				if ( static_cast<std::size_t>( end - cur ) < delim.size() )
+				{
+					sink( begin, static_cast<std::size_t>( cur - begin ) );
+					cur = begin;
+				}
+				std::memcpy( cur, delim.data(), delim.size() );
+				cur += delim.size();
+			}
+		}
+		sink( begin, static_cast<std::size_t>( cur - begin ) );
+	}
+
+	template<typename CharT, typename T>
+	std::basic_ostream<CharT>& write( std::basic_ostream<CharT>& stream,
+		const T* first,
+		const T* last )
+	{
+		format( first, last, [this, &stream]( const char* data, std::size_t n )
+			{
+				flush( stream, data, n );
+			}
+		);
+		return stream;
+	}
+
+	// any contiguous range (Vector, std::vector, std::span...)
+	template<typename CharT, typename Range>
+	std::basic_ostream<CharT>& writeRange( std::basic_ostream<CharT>& stream,
+		const Range& range )
+	{
+		const auto* first = std::data( range );
+		return write( stream, first, first + std::size( range ) );
+	}
+
+	template<typename Range>
+	std::string toString( const Range& range )
+	{
+		std::string out;
+		const auto* first = std::data( range );
+		format( first, first + std::size( range ), [&out]( const char* data, std::size_t n )
+			{
+				out.append( data, n );
+			}
+		);
+		return out;
+	}
+};
+
+struct ParseOptions
+{
+	std::string_view delimiters = " ,;\t\r\n";	// any run of these separates two values
+	std::chars_format floatFormat = std::chars_format::general;
+};
+
+}//textio
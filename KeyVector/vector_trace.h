@@ -0,0 +1,506 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstddef>
+#include <ostream>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+#if defined __linux__ && defined __has_include
+#	if __has_include( <sys/sdt.h> )
+#		include <sys/sdt.h>
+#		define KEYVECTOR_HAS_USDT
+#	endif
+#endif
+
+
+// Vector's tracing hooks are compiled in only with KEYVECTOR_TRACING defined (before including vector.h)
+//	otherwise every hook expands to nothing
+
+// how many of the most recent events the in-process ring keeps (a power of 2)
+#ifndef KEYVECTOR_TRACE_RING_SIZE
+#	define KEYVECTOR_TRACE_RING_SIZE 4096
+#endif
+
+// copies of fewer bytes than this aren't "bulk" & aren't recorded
+#ifndef KEYVECTOR_TRACE_BULK_THRESHOLD
+#	define KEYVECTOR_TRACE_BULK_THRESHOLD ( 1ull << 20 )
+#endif
+
+
+//============================================================
+//	tracing
+//	reallocation, reserve, shrink & bulk copy events of Vector
+//	every event is
+//		1. fired as a static probe when it ends: a USDT probe keyvector:<kind> if <sys/sdt.h>
+//			(systemtap-sdt-dev) is available, the uprobe-able keyvector_probe() otherwise
+//				perf probe -x ./app sdt_keyvector:realloc && perf record -k mono -e sdt_keyvector:realloc ...
+//				perf probe -x ./app 'keyvector_probe kind=%di:u8 bytes=%r8 durationNs=%r9'
+//			arguments: type name, old capacity, new capacity, bytes moved, duration (ns)
+//		2. recorded into a fixed size lock free ring of the last KEYVECTOR_TRACE_RING_SIZE events
+//			timestamps are steady_clock (CLOCK_MONOTONIC on Linux, the clock of perf record -k mono)
+//			so they line up with perf samples & a service's own latency logs
+//	snapshot() / dump() / findStorms() read the ring back; KEYVECTOR_TRACE_DUMP=<path|->
+//		in the environment dumps it (with its storms) when the process exits
+//=============================================================
+namespace tracing
+{
+
+enum class Kind : std::uint8_t
+{
+	Realloc,	// growth: pushBack/append/emplaceBack ran out of capacity, or resize() to a larger capacity
+	Reserve,	// explicit reserve()/tryReserve()
+	Shrink,		// resize() to a smaller capacity
+	BulkCopy	// copy construction/assignment, range construction or append of at least the bulk threshold
+};
+
+inline const char* kindName( Kind kind ) noexcept
+{
+	switch ( kind )
+	{
+	case Kind::Realloc:
+		return "realloc";
+	case Kind::Reserve:
+		return "reserve";
+	case Kind::Shrink:
+		return "shrink";
+	case Kind::BulkCopy:
+		return "bulk_copy";
+	}
+	return "?";
+}
+
+struct Event
+{
+	std::uint64_t sequence;		// global order of the event, gaps mean overwritten/torn slots
+	Kind kind;
+	const char* typeName;		// static storage
+	std::size_t oldCapacity;
+	std::size_t newCapacity;
+	std::size_t bytes;
+	std::uint64_t startNs;		// steady_clock
+	std::uint64_t durationNs;
+	std::uint64_t thread;		// hash of the thread id
+};
+
+inline constexpr std::size_t ringSize = KEYVECTOR_TRACE_RING_SIZE;
+inline constexpr std::size_t bulkThreshold = KEYVECTOR_TRACE_BULK_THRESHOLD;
+static_assert( ringSize > 0 && ( ringSize & ( ringSize - 1 ) ) == 0, "KEYVECTOR_TRACE_RING_SIZE has to be a power of 2." );
+
+inline std::uint64_t nowNs() noexcept
+{
+	return static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
+namespace detail
+{
+
+template<typename T>
+constexpr std::string_view functionSignature() noexcept
+{
+#if defined _MSC_VER
+	return __FUNCSIG__;
+#else
+	return __PRETTY_FUNCTION__;
+#endif
+}
+
+// T's name, cut out of the signature of functionSignature<T>() - no RTTI needed
+template<typename T>
+constexpr std::string_view extractTypeName() noexcept
+{
+	constexpr std::string_view signature = functionSignature<T>();
+#if defined _MSC_VER
+	constexpr std::string_view prefix = "functionSignature<";
+	constexpr std::string_view suffix = ">(void)";
+	const std::size_t first = signature.find( prefix ) + prefix.size();
+	const std::size_t last = signature.rfind( suffix );
+#else
+	constexpr std::string_view prefix = "T = ";
+	const std::size_t first = signature.find( prefix ) + prefix.size();
+	const std::size_t last = std::min( signature.find( ';', first ), signature.rfind( ']' ) );
+#endif
+	return signature.substr( first, last - first );
+}
+
+template<typename T>
+struct TypeName
+{
+	static constexpr std::string_view view = extractTypeName<T>();
+	static constexpr std::array<char, view.size() + 1> storage = []
+		{
+			std::array<char, view.size() + 1> chars{};
+			std::copy( view.begin(), view.end(), chars.begin() );
+			return chars;
+		}();
+};
+
+//============================================================
+//	\class	Ring
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 23:55
+//
+//	\brief	multi producer ring of the last ringSize events, never blocks a writer
+//			every slot is a seqlock: its stamp is odd while being written & 2 * (sequence + 1) after
+//			readers copy a slot & keep it only if the stamp was even & unchanged across the copy
+//			fields are relaxed atomics, so concurrent reads are torn-but-detected, not data races
+//=============================================================
+class Ring final
+{
+	struct Slot
+	{
+		std::atomic<std::uint64_t> stamp{0};
+		std::atomic<std::uint64_t> fields[8]{};
+	};
+
+	alignas( 64 ) std::atomic<std::uint64_t> m_head{0};
+	std::array<Slot, ringSize> m_slots;
+public:
+	void record( const Event& e ) noexcept
+	{
+		const std::uint64_t sequence = m_head.fetch_add( 1, std::memory_order_relaxed );
+		Slot& slot = m_slots[sequence & ( ringSize - 1 )];
+		slot.stamp.store( 2 * sequence + 1, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_release );
+		const std::uint64_t values[8] = {static_cast<std::uint64_t>( e.kind ),
+			reinterpret_cast<std::uintptr_t>( e.typeName ),
+			e.oldCapacity,
+			e.newCapacity,
+			e.bytes,
+			e.startNs,
+			e.durationNs,
+			e.thread};
+		for ( std::size_t i = 0; i < 8; ++i )
+		{
+			slot.fields[i].store( values[i], std::memory_order_relaxed );
+		}
+		slot.stamp.store( 2 * sequence + 2, std::memory_order_release );
+	}
+
+	// copies out the intact events, oldest first; returns how many were written to out (at most ringSize)
+	std::size_t read( Event* out ) const noexcept
+	{
+		const std::uint64_t head = m_head.load( std::memory_order_acquire );
+		const std::uint64_t first = head > ringSize ?
+			head - ringSize :
+			0;
+		std::size_t count = 0;
+		for ( std::uint64_t sequence = first; sequence < head; ++sequence )
+		{
+			const Slot& slot = m_slots[sequence & ( ringSize - 1 )];
+			const std::uint64_t before = slot.stamp.load( std::memory_order_acquire );
+			if ( before != 2 * sequence + 2 )
+			{
+				continue;	// being written, or already overwritten by a newer event
+			}
+			std::uint64_t values[8];
+			for ( std::size_t i = 0; i < 8; ++i )
+			{
+				values[i] = slot.fields[i].load( std::memory_order_relaxed );
+			}
+			std::atomic_thread_fence( std::memory_order_acquire );
+			if ( slot.stamp.load( std::memory_order_relaxed ) != before )
+			{
+				continue;
+			}
+			out[count++] = Event{sequence,
+				static_cast<Kind>( values[0] ),
+				reinterpret_cast<const char*>( static_cast<std::uintptr_t>( values[1] ) ),
+				static_cast<std::size_t>( values[2] ),
+				static_cast<std::size_t>( values[3] ),
+				static_cast<std::size_t>( values[4] ),
+				values[5],
+				values[6],
+				values[7]};
+		}
+		return count;
+	}
+
+	// events recorded since the start, including the overwritten ones
+	std::uint64_t getRecordedCount() const noexcept
+	{
+		return m_head.load( std::memory_order_relaxed );
+	}
+
+	void reset() noexcept
+	{
+		m_head.store( 0, std::memory_order_relaxed );
+		for ( Slot& slot : m_slots )
+		{
+			slot.stamp.store( 0, std::memory_order_relaxed );
+		}
+	}
+};
+
+inline Ring g_ring;
+
+inline std::uint64_t currentThread() noexcept
+{
+	thread_local const std::uint64_t id = std::hash<std::thread::id>{}( std::this_thread::get_id() );
+	return id;
+}
+
+}// namespace detail
+
+#if !defined KEYVECTOR_HAS_USDT
+// the probe point without <sys/sdt.h>: an out of line C function that can't be optimized away
+//	attach with perf probe/bpftrace uprobes by its symbol name
+#	if defined _MSC_VER
+extern "C" __declspec( noinline ) inline void keyvector_probe( std::uint8_t kind,
+	const char* typeName,
+	std::size_t oldCapacity,
+	std::size_t newCapacity,
+	std::size_t bytes,
+	std::uint64_t durationNs ) noexcept
+{
+	static volatile std::uint64_t sink;
+	sink = kind ^ reinterpret_cast<std::uintptr_t>( typeName ) ^ oldCapacity ^ newCapacity ^ bytes ^ durationNs;
+}
+#	else
+extern "C" [[gnu::noinline, gnu::used]] inline void keyvector_probe( std::uint8_t kind,
+	const char* typeName,
+	std::size_t oldCapacity,
+	std::size_t newCapacity,
+	std::size_t bytes,
+	std::uint64_t durationNs ) noexcept
+{
+	asm volatile( "" : : "r"( kind ), "r"( typeName ), "r"( oldCapacity ), "r"( newCapacity ), "r"( bytes ), "r"( durationNs ) : "memory" );
+}
+#	endif
+#endif
+
+inline void fireProbe( const Event& e ) noexcept
+{
+#ifdef KEYVECTOR_HAS_USDT
+	// probe names have to be literals
+	switch ( e.kind )
+	{
+	case Kind::Realloc:
+		DTRACE_PROBE5( keyvector, realloc, e.typeName, e.oldCapacity, e.newCapacity, e.bytes, e.durationNs );
+		break;
+	case Kind::Reserve:
+		DTRACE_PROBE5( keyvector, reserve, e.typeName, e.oldCapacity, e.newCapacity, e.bytes, e.durationNs );
+		break;
+	case Kind::Shrink:
+		DTRACE_PROBE5( keyvector, shrink, e.typeName, e.oldCapacity, e.newCapacity, e.bytes, e.durationNs );
+		break;
+	case Kind::BulkCopy:
+		DTRACE_PROBE5( keyvector, bulk_copy, e.typeName, e.oldCapacity, e.newCapacity, e.bytes, e.durationNs );
+		break;
+	}
+#else
+	keyvector_probe( static_cast<std::uint8_t>( e.kind ), e.typeName, e.oldCapacity, e.newCapacity, e.bytes, e.durationNs );
+#endif
+}
+
+// a Scope's end: probe & ring; out of line, to keep the traced Vector paths as small as the untraced ones
+#if defined _MSC_VER
+__declspec( noinline )
+#else
+[[gnu::noinline, gnu::cold]]
+#endif
+inline void finish( Kind kind,
+	const char* typeName,
+	std::size_t oldCapacity,
+	std::size_t newCapacity,
+	std::size_t bytes,
+	std::uint64_t startNs ) noexcept
+{
+	const Event e{0, kind, typeName, oldCapacity, newCapacity, bytes, startNs, nowNs() - startNs, detail::currentThread()};
+	fireProbe( e );
+	detail::g_ring.record( e );
+}
+
+//============================================================
+//	\class	Scope<T>
+//
+//	\author	KeyC0de
+//	\date	19/10/2026 23:55
+//
+//	\brief	times the Vector<T> operation it is declared in & records it when the scope ends
+//			(an event whose operation threw is still recorded)
+//			bulk copies under bulkThreshold bytes aren't recorded at all
+//			use it through KEYVECTOR_TRACE_SCOPE, which is a no-op without KEYVECTOR_TRACING
+//=============================================================
+template<typename T>
+class Scope final
+{
+	Kind m_kind;
+	bool m_active;
+	std::size_t m_oldCapacity;
+	std::size_t m_newCapacity;
+	std::size_t m_bytes;
+	std::uint64_t m_startNs;
+public:
+	Scope( Kind kind,
+		std::size_t oldCapacity,
+		std::size_t newCapacity,
+		std::size_t bytes ) noexcept
+		:
+		m_kind{kind},
+		m_active{kind != Kind::BulkCopy || bytes >= bulkThreshold},
+		m_oldCapacity{oldCapacity},
+		m_newCapacity{newCapacity},
+		m_bytes{bytes},
+		m_startNs{m_active ? nowNs() : 0}
+	{
+
+	}
+	Scope( const Scope& rhs ) = delete;
+	Scope& operator=( const Scope& rhs ) = delete;
+
+	~Scope() noexcept
+	{
+		if ( m_active )
+		{
+			finish( m_kind, detail::TypeName<T>::storage.data(), m_oldCapacity, m_newCapacity, m_bytes, m_startNs );
+		}
+	}
+};
+
+// appends the recent events to out (a Vector<Event>), oldest first; returns how many
+template<typename V>
+std::size_t snapshot( V& out )
+{
+	return out.appendInPlace( ringSize, []( Event* dst )
+		{
+			return detail::g_ring.read( dst );
+		} );
+}
+
+inline std::uint64_t getRecordedCount() noexcept
+{
+	return detail::g_ring.getRecordedCount();
+}
+
+// forgets the recorded events; not safe against concurrent recording
+inline void reset() noexcept
+{
+	detail::g_ring.reset();
+}
+
+// a burst of at least minEvents events starting within windowNs of each other
+struct Storm
+{
+	std::uint64_t startNs;
+	std::uint64_t endNs;
+	std::size_t events;
+	std::size_t bytes;
+	std::uint64_t busyNs;		// the summed durations of its events
+};
+
+//===================================================
+//	\function	findStorms
+//	\brief  groups time ordered events into storms: runs where every event starts within windowNs
+//			of the first one of its run, keeping the runs of at least minEvents
+//			calls emit( const Storm& ) for each
+//	\date	19/10/2026 23:55
+template<typename F>
+void findStorms( const Event* events,
+	std::size_t count,
+	std::uint64_t windowNs,
+	std::size_t minEvents,
+	F emit )
+{
+	std::size_t i = 0;
+	while ( i < count )
+	{
+		Storm storm{events[i].startNs, events[i].startNs + events[i].durationNs, 0, 0, 0};
+		std::size_t j = i;
+		for ( ; j < count && events[j].startNs - storm.startNs <= windowNs; ++j )
+		{
+			storm.endNs = std::max( storm.endNs, events[j].startNs + events[j].durationNs );
+			++storm.events;
+			storm.bytes += events[j].bytes;
+			storm.busyNs += events[j].durationNs;
+		}
+		if ( storm.events >= minEvents )
+		{
+			emit( storm );
+		}
+		i = j;
+	}
+}
+
+//===================================================
+//	\function	dump
+//	\brief  the events as a table (times in ms of steady_clock & us) followed by their storms
+//	\date	19/10/2026 23:55
+inline void dump( std::ostream& os,
+	const Event* events,
+	std::size_t count,
+	std::uint64_t stormWindowNs = 1'000'000,
+	std::size_t stormMinEvents = 8 )
+{
+	const std::ios_base::fmtflags flags = os.flags();
+	os << "# keyvector trace: " << count << " events (" << getRecordedCount() << " recorded in total)\n"
+		<< "# seq\tt_ms\tthread\tkind\ttype\told_capacity\tnew_capacity\tbytes\tduration_us\n"
+		<< std::fixed;
+	for ( std::size_t i = 0; i < count; ++i )
+	{
+		const Event& e = events[i];
+		os << e.sequence << '\t'
+			<< std::setprecision( 3 ) << e.startNs / 1e6 << '\t'
+			<< std::hex << ( e.thread & 0xFFFF ) << std::dec << '\t'
+			<< kindName( e.kind ) << '\t'
+			<< e.typeName << '\t'
+			<< e.oldCapacity << '\t'
+			<< e.newCapacity << '\t'
+			<< e.bytes << '\t'
+			<< std::setprecision( 1 ) << e.durationNs / 1e3 << '\n';
+	}
+	os << "# storms (>= " << stormMinEvents << " events within " << stormWindowNs / 1e3 << " us)\n";
+	findStorms( events, count, stormWindowNs, stormMinEvents, [&os]( const Storm& storm )
+		{
+			os << "storm\t" << std::setprecision( 3 ) << storm.startNs / 1e6 << " - " << storm.endNs / 1e6 << " ms\t"
+				<< storm.events << " events\t" << storm.bytes << " bytes\t"
+				<< std::setprecision( 1 ) << storm.busyNs / 1e3 << " us busy\n";
+		} );
+	os.flags( flags );
+}
+
+namespace detail
+{
+
+// KEYVECTOR_TRACE_DUMP=<path> (or - for stderr) dumps the ring at exit
+inline void dumpAtExit() noexcept
+{
+	const char* target = std::getenv( "KEYVECTOR_TRACE_DUMP" );
+	if ( !target )
+	{
+		return;
+	}
+	static std::array<Event, ringSize> events;
+	const std::size_t count = g_ring.read( events.data() );
+	if ( std::string_view{target} == "-" )
+	{
+		dump( std::cerr, events.data(), count );
+		return;
+	}
+	std::ofstream file{target};
+	dump( file, events.data(), count );
+}
+
+#ifdef KEYVECTOR_TRACING
+inline const bool g_dumpAtExitRegistered = std::getenv( "KEYVECTOR_TRACE_DUMP" ) && std::atexit( dumpAtExit ) == 0;
+#endif
+
+}// namespace detail
+
+}// namespace tracing
+
+
+#ifdef KEYVECTOR_TRACING
+#	define KEYVECTOR_TRACE_SCOPE( kind, oldCapacity, newCapacity, bytes ) const tracing::Scope<T> keyvectorTraceScope_{kind, oldCapacity, newCapacity, bytes}
+#else
+#	define KEYVECTOR_TRACE_SCOPE( kind, oldCapacity, newCapacity, bytes ) ( (void)0 )
+#endif